@@ -0,0 +1,545 @@
+/*
+13_Snail_Trail_Multi_Snail
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+In this version many snails share one garden. Every snail is driven by its own input, either a stream of recorded keys
+(the recording from version 11, started at a different offset for every snail) or a simple bot heading for the closest
+lettuce. All snails are moved within one iteration of the game loop, followed by dissolving the slime and moving the
+frogs, in the same order as in the single snail versions.
+Rules for the interactions that do not exist with a single snail:
+-	Snails are moved in order of their index. A snail trying to move onto another snail is blocked, so when two snails
+	head for the same field, the one with the lower index gets it. Slime blocks every snail, no matter who produced it.
+-	Every frog homes in on the closest living snail (measured in frog leaps, ties go to the snail with the lower index)
+	and eats whatever snail it lands on.
+-	A snail that has eaten its quota of lettuces leaves the garden, a dead snail leaves its shell behind.
+The data of the snails is stored as a structure of arrays, so that the loops over all snails run through contiguous
+memory. Positions are stored as offsets into the garden, which has rows of a power of two length, so that the row and
+column of a snail or frog can be obtained with a shift and a mask.
+The slime trails of all snails share a single counter, as every snail lays at most one ball of slime per frame. One slot
+of the slime trail holds an entry for each snail, i.e. dissolving the slime of all snails runs through a single row.
+Like version 11, the game is played without any output and the times of all frames are accumulated and written to
+"Framerates.txt" together with the number of frames.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <iostream>          //for output and input
+#include <fstream>           //for files
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+// global constants
+
+// garden dimensions
+const int SIZEY(64);						// vertical dimension
+const int SIZEX(126);						// horizontal dimension
+const int ROW_LENGTH(128);					// SIZEX + 2, length of a row in the garden array (power of two)
+const int ROW_SHIFT(7);					// log2(ROW_LENGTH), used to get the row from an offset
+
+//constants used for the garden & its inhabitants
+const char BLANK(' ');						// open space
+const char PELLET ('-'); //(BLANK);			// should be blank) but test using a visible character.
+const char LETTUCE ('@');					// a lettuce
+const char SLIME ('.');						// snail produce
+const char WALL('+');                       // garden wall
+const char FROG ('M');
+const char DEAD_FROG_BONES ('X');			// Dead frogs are marked as such in their 'y' coordinate
+const char SNAIL('&');						// snail (player's icon)
+const char DEADSNAIL ('o');					// just the shell left...
+
+const int  NUM_SNAILS (64);				// number of snails sharing the garden
+const int  SLIMELIFE (25);					// how long slime lasts (in keypresses)
+const int  NUM_PELLETS (240);				// number of slug pellets scattered about
+const int  PELLET_THRESHOLD (5);			// deadly threshold! Slither over this number and you die!
+const int  NUM_LETTUCES (256);				// number of lettuces planted in the garden
+const int  LETTUCE_QUOTA (4);				// how many lettuces a snail needs to eat before it is full.
+const int  NUM_FROGS (16);
+const int  FROGLEAP (4);					// How many spaces do frogs jump when they move
+const int  EagleStrike (32);				// There's a 1 in 'nn' chance of an eagle strike on a frog
+
+const int  MAX_FRAMES (1000);				// a game ends after this many frames, even if snails are left
+
+// the state a snail can be in
+const unsigned char SNAIL_ALIVE (0);
+const unsigned char SNAIL_DEAD (1);
+const unsigned char SNAIL_FULL (2);					// has eaten its quota and left the garden
+
+// run through this many games
+const int numberOfCycles(1000);
+
+// the keys recorded for version 11, every snail driven by keys starts reading them at a different position
+const int NUM_KEYS(360);
+const int KEY_OFFSET(37);					// distance between the start positions of two snails
+const int keys[NUM_KEYS] = {3,3,3,3,0,0,0,0,0,0,0,0,3,3,3,0,0,0,0,2,2,2,2,2,2,1,2,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,0,2,2,2,2,2,1,1,1,1,3,3,3,3,0,3,3,0,2,2,2,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,2,1,1,1,1,0,0,3,0,2,2,2,0,0,2,2,2,3,3,0,0,0,0,0,0,0,2,3,3,0,3,3,0,3,0,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,2,1,1,3,3,3,1,2,1,1,1,1,1,2,0,2,2,0,2,2,2,0,0,0,0,0,3,3,0,0,0,0,0,0,0,3,3,1,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,2,2,0,2,2,2,2,2,2,0,0,3,0,0,3,0,0,0,0,2,0,0,0,3,0,2,0,0,0,3,0,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,0,0,0,0,0,0,0,0,3,0,0,2,2,2,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,5,5};
+
+// all possible moves of a snail as offsets into the garden (left, right, up, down)
+const int moveOffsets[4] = {-1, 1, -ROW_LENGTH, ROW_LENGTH};
+
+// holds the data of all snails, one array per value to allow iterating over all snails through contiguous memory
+struct Snails
+{
+	int position[NUM_SNAILS];				// offset of the snail in the garden
+	int pellets[NUM_SNAILS];				// number of pellets slithered over
+	int lettuces[NUM_SNAILS];				// number of lettuces eaten
+	int botTarget[NUM_SNAILS];				// offset of the lettuce a bot is heading for (-1 if none chosen yet)
+	int keyCount[NUM_SNAILS];				// position in the recorded keys
+	unsigned char state[NUM_SNAILS];		// alive, dead or full
+	bool isBot[NUM_SNAILS];					// driven by the bot instead of the recorded keys
+};
+
+double accumulatedFramerates(0.0);
+long long frameCount(0LL);
+long long snailMoves(0LL);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	int randomField();
+	int getSnailKey(Snails&, int);
+	int getBotKey(Snails&, int, const char [], const int []);
+	int findSnail(const Snails&, int);
+
+	// the game 'world', stored row by row
+	char garden[SIZEY * ROW_LENGTH];
+
+	Snails snails;
+
+	// holds frog positions as offsets into the garden (-1 if eaten by the eagle)
+	int frogs[NUM_FROGS];
+
+	// keeps track of whether frogs are currently sitting on lettuces or not
+	bool lettucesBlocked[NUM_FROGS];
+
+	// where the lettuces have been planted, used by the bots to look for the closest one
+	int lettuces[NUM_LETTUCES];
+
+	// holds the position of each slime ball, one entry per snail in every slot
+	int slimeTrail[SLIMELIFE][NUM_SNAILS];
+	int slimeCounter(0);
+
+	int snailsAlive(0);
+
+	CStopWatch s;							// create a stopwatch for timing
+
+	for(int i = 0; i < numberOfCycles; ++i)
+	{
+		// Now start the game...
+
+		srand(256);  //seed the random number generator
+
+		/**********************************************************************************************
+		Initialisation
+		***********************************************************************************************/
+
+		//------------------------------------------------------------------------------
+		// initialise slime trail
+
+		memset(&slimeTrail[0][0], 0xFF, sizeof(slimeTrail));		// all entries -1
+		slimeCounter = 0;
+
+		//-----------------------------------------------------------------------------------
+		// set garden (the unused fields at the end of each row are treated as wall)
+
+		memset(&garden[0], WALL, ROW_LENGTH);
+		for (int row(1); row < SIZEY - 1; ++row)
+		{
+			garden[row * ROW_LENGTH] = WALL;
+			memset(&garden[row * ROW_LENGTH + 1], BLANK, SIZEX - 2);
+			memset(&garden[row * ROW_LENGTH + SIZEX - 1], WALL, ROW_LENGTH - SIZEX + 1);
+		}
+		memset(&garden[(SIZEY - 1) * ROW_LENGTH], WALL, ROW_LENGTH);
+
+		//-------------------------------------------------------------------------------------
+		// place snails
+
+		int field(0);
+
+		for (int snail(0); snail < NUM_SNAILS; ++snail)
+		{
+			do
+			{
+				field = randomField();
+			}while(garden[field] != BLANK);	// avoid other snails
+
+			garden[field] = SNAIL;
+
+			snails.position[snail] = field;
+			snails.pellets[snail] = 0;
+			snails.lettuces[snail] = 0;
+			snails.botTarget[snail] = -1;
+			snails.keyCount[snail] = (snail * KEY_OFFSET) % NUM_KEYS;
+			snails.state[snail] = SNAIL_ALIVE;
+			snails.isBot[snail] = (snail & 1) != 0;	// every second snail is driven by a bot
+		}
+		snailsAlive = NUM_SNAILS;
+
+		//--------------------------------------------------------------------------------------
+		// scatter pellets
+
+		for (int slugP(0); slugP < NUM_PELLETS; ++slugP)
+		{
+			do
+			{
+				field = randomField();
+			}while(garden[field] != BLANK);	// avoid snails and other pellets
+
+			garden[field] = PELLET;
+		}
+
+		//---------------------------------------------------------------------------------
+		// scatter lettuces
+
+		for (int lettuce(0); lettuce < NUM_LETTUCES; ++lettuce)
+		{
+			do
+			{
+				field = randomField();
+			}while(garden[field] != BLANK);	// avoid snails, pellets and other lettucii
+
+			garden[field] = LETTUCE;
+			lettuces[lettuce] = field;
+		}
+
+		//-------------------------------------------------------------------------------
+		//scatter frogs
+
+		for (int frog(0); frog < NUM_FROGS; ++frog)
+		{
+			do
+			{
+				field = randomField();
+			}while(garden[field] == SNAIL || garden[field] == FROG);	// avoid snails and other frogs
+
+			lettucesBlocked[frog] = garden[field] == LETTUCE;	// frog is currently blocking a lettuce
+			garden[field] = FROG;								// put frog on garden (this may overwrite a slug pellet)
+			frogs[frog] = field;
+		}
+
+		/************************************************************************************************
+		Game loop
+		*************************************************************************************************/
+
+		for (int frame(0); (frame < MAX_FRAMES) && (snailsAlive > 0); ++frame)
+		{
+			s.startTimer(); // not part of game
+
+			// ************** code to be timed ***********************************************
+
+			/*********************************************************************************
+			Move the snails
+			**********************************************************************************/
+
+			for (int snail(0); snail < NUM_SNAILS; ++snail)
+			{
+				if (snails.state[snail] != SNAIL_ALIVE)
+				{
+					continue;
+				}
+
+				int key = snails.isBot[snail] ? getBotKey(snails, snail, garden, lettuces) : getSnailKey(snails, snail);
+
+				if (key >= 4)	// only move the snail if an arrow key was pressed
+				{
+					continue;
+				}
+
+				++snailMoves;
+
+				const int position = snails.position[snail];
+				const int target = position + moveOffsets[key];
+
+				switch (garden[target])	//depending on what is at target position
+				{
+					case BLANK:
+					case DEAD_FROG_BONES:		//its safe to move over dead/missing frogs too
+						garden[position] = SLIME;							//lay a trail of slime
+						slimeTrail[slimeCounter][snail] = position;
+						snails.position[snail] = target;
+						garden[target] = SNAIL;
+						break;
+					case PELLET:		// increment pellet count and kill snail if > threshold
+						garden[position] = SLIME;
+						slimeTrail[slimeCounter][snail] = position;
+						snails.position[snail] = target;
+						if (++snails.pellets[snail] >= PELLET_THRESHOLD)	// aaaargh! poisoned!
+						{
+							garden[target] = DEADSNAIL;
+							snails.state[snail] = SNAIL_DEAD;
+							--snailsAlive;
+						}
+						else
+						{
+							garden[target] = SNAIL;
+						}
+						break;
+					case LETTUCE:		// increment lettuce count, a full snail leaves the garden
+						garden[position] = SLIME;
+						slimeTrail[slimeCounter][snail] = position;
+						snails.position[snail] = target;
+						if (++snails.lettuces[snail] != LETTUCE_QUOTA)
+						{
+							garden[target] = SNAIL;
+						}
+						else
+						{
+							garden[target] = BLANK;
+							snails.state[snail] = SNAIL_FULL;
+							--snailsAlive;
+						}
+						break;
+					case FROG:			//	kill snail if it throws itself at a frog!
+						garden[position] = SLIME;							// lay a final trail of slime
+						slimeTrail[slimeCounter][snail] = position;
+						snails.position[snail] = target;					// the frog stays where it is
+						snails.state[snail] = SNAIL_DEAD;
+						--snailsAlive;
+						break;
+					default:			// wall, slime or another (dead) snail, stay put
+						break;
+				}
+			}
+
+			/*********************************************************************************
+			Dissolve the slime
+			**********************************************************************************/
+
+			if (++slimeCounter >= SLIMELIFE)
+			{
+				slimeCounter = 0;
+			}
+
+			int* slime = slimeTrail[slimeCounter];
+			for (int snail(0); snail < NUM_SNAILS; ++snail)
+			{
+				if (slime[snail] >= 0)
+				{
+					// a frog may have taken the slime away already and another snail may have moved there since
+					if (garden[slime[snail]] == SLIME)
+					{
+						garden[slime[snail]] = BLANK;
+					}
+					slime[snail] = -1;
+				}
+			}
+
+			/*********************************************************************************
+			Move the frogs
+			**********************************************************************************/
+
+			for (int frog(0); (frog < NUM_FROGS) && (snailsAlive > 0); ++frog)
+			{
+				if (frogs[frog] < 0)	// frog has been gotten by an eagle
+				{
+					continue;
+				}
+
+				// if frog was blocking a lettuce, restore the lettuce (lettuce is 0x40, blank is 0x20)
+				garden[frogs[frog]] = BLANK << static_cast<int>(lettucesBlocked[frog]);
+
+				int frogY = frogs[frog] >> ROW_SHIFT;
+				int frogX = frogs[frog] & (ROW_LENGTH - 1);
+
+				// look for the closest living snail, distance is measured in the number of moves of a frog
+				int snailY(0);
+				int snailX(0);
+				int closest(SIZEX + SIZEY);
+				for (int snail(0); snail < NUM_SNAILS; ++snail)
+				{
+					if (snails.state[snail] != SNAIL_ALIVE)
+					{
+						continue;
+					}
+
+					const int y = snails.position[snail] >> ROW_SHIFT;
+					const int x = snails.position[snail] & (ROW_LENGTH - 1);
+					const int distanceY = abs(y - frogY);
+					const int distanceX = abs(x - frogX);
+					const int distance = (distanceY > distanceX) ? distanceY : distanceX;
+
+					if (distance < closest)
+					{
+						closest = distance;
+						snailY = y;
+						snailX = x;
+					}
+				}
+
+				// work out where to jump to depending on where the snail is...
+				if (snailY > frogY)
+				{
+					frogY += FROGLEAP;  if (frogY >= SIZEY - 1) frogY = SIZEY - 2;	// don't go over the garden walls!
+				}else if (snailY < frogY)
+				{
+					frogY -= FROGLEAP;  if (frogY < 1) frogY = 1;
+				}
+
+				if (snailX > frogX)
+				{
+					frogX += FROGLEAP;  if (frogX >= SIZEX - 1) frogX = SIZEX - 2;
+				}else if (snailX < frogX)
+				{
+					frogX -= FROGLEAP;  if (frogX < 1) frogX = 1;
+				}
+
+				const int field = (frogY << ROW_SHIFT) + frogX;
+				frogs[frog] = field;
+
+				lettucesBlocked[frog] = (garden[field] == LETTUCE);
+
+				if (((rand() % EagleStrike) + 1) != EagleStrike)  // not gotten by eagle?
+				{
+					if (garden[field] == SNAIL)		// landed on a snail? - grub up!
+					{
+						const int snail = findSnail(snails, field);
+						snails.state[snail] = SNAIL_DEAD;
+						--snailsAlive;
+					}
+					garden[field] = FROG;			// display frog on garden (thus destroying any pellet that might be there).
+				}
+				else
+				{
+					if (garden[field] != SNAIL)		// a snail the frog landed on survives and stays visible
+					{
+						// if the frog was sitting on a lettuce as he was killed, restore the lettuce
+						garden[field] = lettucesBlocked[frog] ? LETTUCE : DEAD_FROG_BONES;
+					}
+					frogs[frog] = -1;				// and mark frog as deceased
+				}
+			}
+
+			//*************** end of timed section ******************************************
+
+			s.stopTimer(); // not part of game
+			if(s.getElapsedTime() > 0.0)
+			{
+				accumulatedFramerates += s.getElapsedTime();
+				++frameCount;
+			}
+		}
+	}
+
+	ofstream outFramerates;
+	outFramerates.open("Framerates.txt");
+	outFramerates << accumulatedFramerates <<"\n" << frameCount;
+	outFramerates.close();
+
+	printf("%lld frames, %.0f frames/s, %lld snail moves\n", frameCount, frameCount / accumulatedFramerates, snailMoves);
+
+	return 0;
+} //end main
+
+/***************************************************************************************
+Helpers
+****************************************************************************************/
+
+int randomField()
+{
+	// offset of a random field within the garden walls
+	int y = (rand() % (SIZEY - 2)) + 1;
+	int x = (rand() % (SIZEX - 2)) + 1;
+	return (y << ROW_SHIFT) + x;
+}
+
+int findSnail(const Snails& snails, int field)
+{
+	// the living snail at the given field, the caller makes sure there is one
+	int snail(0);
+	while (snails.state[snail] != SNAIL_ALIVE || snails.position[snail] != field)
+	{
+		++snail;
+	}
+	return snail;
+}
+
+/***************************************************************************************
+Get snail input
+****************************************************************************************/
+
+int getSnailKey(Snails& snails, int snail)
+{
+	// next recorded key of the snail, quitting is not possible for a single snail
+	int& keyCount = snails.keyCount[snail];
+	int key = keys[keyCount];
+	if (++keyCount >= NUM_KEYS)
+	{
+		keyCount = 0;
+	}
+	return (key == 5) ? 4 : key;
+}
+
+int getBotKey(Snails& snails, int snail, const char garden[], const int lettuces[])
+{
+	// the bot heads for the closest lettuce, avoiding everything that would kill or block the snail
+
+	const int position = snails.position[snail];
+	const int snailY = position >> ROW_SHIFT;
+	const int snailX = position & (ROW_LENGTH - 1);
+
+	// look for a new lettuce when the old one has been eaten (or a frog is sitting on it)
+	if (snails.botTarget[snail] < 0 || garden[snails.botTarget[snail]] != LETTUCE)
+	{
+		int closest(SIZEX + SIZEY);
+		snails.botTarget[snail] = -1;
+		for (int lettuce(0); lettuce < NUM_LETTUCES; ++lettuce)
+		{
+			if (garden[lettuces[lettuce]] != LETTUCE)
+			{
+				continue;
+			}
+			const int distance = abs((lettuces[lettuce] >> ROW_SHIFT) - snailY) + abs((lettuces[lettuce] & (ROW_LENGTH - 1)) - snailX);
+			if (distance < closest)
+			{
+				closest = distance;
+				snails.botTarget[snail] = lettuces[lettuce];
+			}
+		}
+		if (snails.botTarget[snail] < 0)
+		{
+			return 4;	// nothing left to eat
+		}
+	}
+
+	const int targetY = snails.botTarget[snail] >> ROW_SHIFT;
+	const int targetX = snails.botTarget[snail] & (ROW_LENGTH - 1);
+
+	// try the moves towards the lettuce first, then the others
+	int order[4];
+	order[0] = (targetX < snailX) ? 0 : 1;
+	order[1] = (targetY < snailY) ? 2 : 3;
+	if (targetX == snailX)
+	{
+		order[0] = order[1];
+		order[1] = 0;
+	}
+	order[2] = order[0] ^ 1;
+	order[3] = order[1] ^ 1;
+
+	int pelletKey(4);
+	for (int i(0); i < 4; ++i)
+	{
+		switch (garden[position + moveOffsets[order[i]]])
+		{
+			case BLANK:
+			case LETTUCE:
+			case DEAD_FROG_BONES:
+				return order[i];
+			case PELLET:
+				if (pelletKey == 4 && snails.pellets[snail] < PELLET_THRESHOLD - 1)
+				{
+					pelletKey = order[i];
+				}
+				break;
+			default:
+				break;
+		}
+	}
+	return pelletKey;
+}
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,430 @@
+/*
+14_Snail_Trail_Monte_Carlo_Autoplayer
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version plays the game on its own. Before every move, the autoplayer tries out each key by playing a number of
+short random games (rollouts) that start with that key from a copy of the current game, and picks the key whose
+rollouts ended best. A rollout ends when the snail dies (too many pellets, frog landed on it, ran into a frog), when it
+has eaten all lettuces or after ROLLOUT_DEPTH moves. The game code is taken from "SnailEngine.h", where the whole game
+is held in one structure, so a rollout only has to copy that structure.
+Every rollout gets its own stream of random numbers, used for the eagle as well as for choosing the moves, so the
+rollouts of one key differ from each other and the autoplayer cannot see in advance what the eagle is going to do in
+the real game. The rollouts are spread over all cores, every thread plays every n-th rollout of each key.
+The keys chosen are written to "MonteCarloKeys.txt" in the format of "Keys.txt", so that they can be replayed by the
+other versions (seeded with 256 like all recorded games). As in version 12, a key is read after every frame, also after
+the last one of a game, and one more to play another game or not, so two keys are written after every game. The file
+is read back and replayed that way to check that it holds the games played. The number of rollouts and engine steps
+per second are shown at the end.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <fstream>           //for files
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "KeyFile.h"         //for loadKeyFile
+
+// number of games to play
+const int NUM_GAMES(20);
+// a game is stopped after this many moves (the autoplayer might avoid all danger without ever getting to a lettuce)
+const int MAX_MOVES(400);
+
+// number of rollouts per key and their length
+const int NUM_ROLLOUTS(256);
+const int ROLLOUT_DEPTH(40);
+
+// the keys the autoplayer chooses from (including 4 to wait for a frog to move away)
+const int NUM_CANDIDATES(5);
+
+// used to rate the outcome of a rollout
+const int SCORE_DEATH(-1000);
+const int SCORE_LETTUCE(100);
+const int SCORE_WIN(1000);
+
+// random number generator for the moves in a rollout, seeded separately for every rollout
+struct RolloutRandom
+{
+	unsigned int state;
+
+	unsigned int next()
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+// mixes the numbers identifying a rollout into a seed, so that all rollouts get unrelated random numbers
+unsigned int rolloutSeed(unsigned int move, int candidate, int rollout)
+{
+	unsigned int seed = move * 0x9E3779B9u ^ static_cast<unsigned int>(candidate) * 0x85EBCA6Bu ^ static_cast<unsigned int>(rollout) * 0xC2B2AE35u;
+	seed ^= seed >> 16;
+	seed *= 0x7FEB352Du;
+	seed ^= seed >> 15;
+	seed *= 0x846CA68Bu;
+	seed ^= seed >> 16;
+	return seed | 1;		// xorshift must not start at zero
+}
+
+// the results of one thread, on a cache line of its own (aligned and padded to it, also as a member of RolloutJob) so
+// that the threads do not slow each other down
+struct SNAIL_ALIGN(64) RolloutResult
+{
+	long long scores[NUM_CANDIDATES];	// accumulated scores per key
+	long long steps;					// engine steps
+	char padding[CACHE_LINE - (NUM_CANDIDATES + 1) * sizeof(long long)];
+};
+
+static_assert(sizeof(RolloutResult) == CACHE_LINE, "RolloutResult has to fill one cache line");
+
+// the work to be done by all threads for one move
+struct RolloutJob
+{
+	const GameState* game;			// the game the rollouts branch off from
+	unsigned int move;				// number of the move in the real game, used for the seeds
+	RolloutResult results[16];		// one per thread
+};
+
+int numberOfThreads(1);
+RolloutJob job;
+
+// used to start the worker threads for a move and to wait for them to finish
+mutex jobMutex;
+condition_variable jobStart;
+condition_variable jobDone;
+unsigned int jobGeneration(0);
+int workersBusy(0);
+bool stopWorkers(false);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	int chooseKey(const GameState&, unsigned int);
+	void rolloutWorker(int);
+	bool replayKeys(const char*, int&, long long&);
+
+	numberOfThreads = thread::hardware_concurrency();
+	if (numberOfThreads < 1) numberOfThreads = 1;
+	if (numberOfThreads > 16) numberOfThreads = 16;
+
+	vector<thread> workers;
+	for (int t = 1; t < numberOfThreads; ++t)		// the main thread is worker 0
+	{
+		workers.push_back(thread(rolloutWorker, t));
+	}
+
+	ofstream outKeys("MonteCarloKeys.txt");
+
+	GameState game;
+	seedGame(game, 256);
+
+	int wins(0);
+	int games(0);
+	long long totalMoves(0);
+	long long rollouts(0);
+	long long steps(0);
+
+	CStopWatch s;
+	s.startTimer();
+
+	for (int g = 0; g < NUM_GAMES; ++g)
+	{
+		initialiseGame(game);
+		++games;
+
+		int moves(0);
+		while (!isGameOver(game) && moves < MAX_MOVES)
+		{
+			const int key = chooseKey(game, static_cast<unsigned int>(totalMoves));
+			outKeys << keyCodes[key] << ",";
+
+			stepGame(game, key);
+			++moves;
+			++totalMoves;
+
+			rollouts += NUM_CANDIDATES * NUM_ROLLOUTS;
+			for (int t = 0; t < numberOfThreads; ++t)
+			{
+				steps += job.results[t].steps;
+			}
+		}
+
+		if (!isGameOver(game))
+		{
+			break;		// the autoplayer got stuck, quitting ends the recording
+		}
+		outKeys << keyCodes[4] << ",";			// the key read after the last frame
+
+		if (game.isSnailAlive)
+		{
+			++wins;
+		}
+		printf("game %d: %s after %d moves, %d lettuces, %d pellets\n", g + 1, game.isSnailAlive ? "won" : "lost", moves, game.counters[3], game.counters[2]);
+
+		if (g + 1 < NUM_GAMES)
+		{
+			outKeys << keyCodes[4] << ",";		// any key but 'q' to play another game
+		}
+	}
+	if (!isGameOver(game))
+	{
+		outKeys << keyCodes[5] << ",";			// quit the game...
+	}
+	outKeys << keyCodes[5] << ",";				// ...and don't play another one
+	outKeys.close();
+
+	s.stopTimer();
+
+	{
+		lock_guard<mutex> lock(jobMutex);
+		stopWorkers = true;
+	}
+	jobStart.notify_all();
+	for (size_t t = 0; t < workers.size(); ++t)
+	{
+		workers[t].join();
+	}
+
+	printf("%d of %d games won, %lld moves, %d threads\n", wins, NUM_GAMES, totalMoves, numberOfThreads);
+	printf("%.0f rollouts/s, %.0f engine steps/s\n", rollouts / s.getElapsedTime(), steps / s.getElapsedTime());
+
+	int replayedGames(0);
+	long long replayedFrames(0);
+	if (!replayKeys("MonteCarloKeys.txt", replayedGames, replayedFrames))
+	{
+		printf("cannot read MonteCarloKeys.txt\n");
+		return 1;
+	}
+	printf("MonteCarloKeys.txt replays %d games, %lld frames\n", replayedGames, replayedFrames);
+	if (replayedGames != games || replayedFrames != totalMoves)
+	{
+		printf("the recording does not replay the %d games, %lld moves played\n", games, totalMoves);
+		return 1;
+	}
+	return 0;
+} //end main
+
+// replays a key file as version 12 reads the keys, counting the games and frames
+bool replayKeys(const char* name, int& games, long long& frames)
+{
+	vector<unsigned char> keys;
+	if (!loadKeyFile(name, keys))
+	{
+		return false;
+	}
+
+	GameState game;
+	seedGame(game, 256);
+	games = 0;
+	frames = 0;
+	size_t keyCount(0);
+	int key(4);
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		++games;
+		key = keyCount < keys.size() ? keys[keyCount++] : 5;
+		while (!isGameOver(game) && key != 5)
+		{
+			stepGame(game, key);
+			++frames;
+			key = keyCount < keys.size() ? keys[keyCount++] : 5;
+		}
+		key = keyCount < keys.size() ? keys[keyCount++] : 5;		// another go (read even after 'q', as version 12 does)
+	}
+	return true;
+}
+
+/***************************************************************************************
+Rollouts
+****************************************************************************************/
+
+int chooseRolloutKey(const GameState& game, RolloutRandom& random)
+{
+	// a random move that does not run into a wall, slime or a frog, most of the time towards the closest lettuce
+	const char (&garden)[SIZEY][SIZEX+2] = game.garden;
+	const int* snail = game.snail;
+
+	int keys[4];
+	int numberOfKeys(0);
+	for (int key = 0; key < 4; ++key)
+	{
+		const char target = garden[snail[0] + moveDirections[key][0]][snail[1] + moveDirections[key][1]];
+		if (target != WALL && target != SLIME && target != FROG && (target != PELLET || game.counters[2] < PELLET_THRESHOLD - 1))
+		{
+			keys[numberOfKeys++] = key;
+		}
+	}
+	if (numberOfKeys == 0)
+	{
+		return 4;
+	}
+
+	const unsigned int r = random.next();
+	if ((r & 3) != 0)
+	{
+		// head for the closest lettuce
+		int closest(SIZEX + SIZEY);
+		int lettuceY(0);
+		int lettuceX(0);
+		for (int y = 1; y < SIZEY - 1; ++y)
+		{
+			for (int x = 1; x < SIZEX - 1; ++x)
+			{
+				if (garden[y][x] == LETTUCE)
+				{
+					const int distance = abs(y - snail[0]) + abs(x - snail[1]);
+					if (distance < closest)
+					{
+						closest = distance;
+						lettuceY = y;
+						lettuceX = x;
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < numberOfKeys; ++i)
+		{
+			const int key = keys[(i + (r >> 2)) % numberOfKeys];
+			const int distance = abs(lettuceY - snail[0] - moveDirections[key][0]) + abs(lettuceX - snail[1] - moveDirections[key][1]);
+			if (distance < closest)
+			{
+				return key;
+			}
+		}
+	}
+	return keys[(r >> 2) % numberOfKeys];
+}
+
+int playRollout(const GameState& game, int candidate, unsigned int seed, long long& steps)
+{
+	// play one rollout starting with the candidate key and rate the outcome
+	GameState rollout = game;
+	RolloutRandom random;
+	random.state = seed;
+	seedGame(rollout, seed);	// the real eagle is not known in advance
+
+	const int lettuces = game.counters[3];
+
+	stepGame(rollout, candidate);
+	int depth(1);
+	while (!isGameOver(rollout) && depth < ROLLOUT_DEPTH)
+	{
+		stepGame(rollout, chooseRolloutKey(rollout, random));
+		++depth;
+	}
+	steps += depth;
+
+	if (!rollout.isSnailAlive)
+	{
+		return SCORE_DEATH + depth;					// surviving longer is still better
+	}
+	if (rollout.counters[3] == LETTUCE_QUOTA)
+	{
+		return SCORE_WIN - depth;					// the sooner the better
+	}
+	return (rollout.counters[3] - lettuces) * SCORE_LETTUCE;
+}
+
+void playRollouts(int thread)
+{
+	// every thread plays every numberOfThreads-th rollout for all keys
+	long long steps(0);
+	for (int candidate = 0; candidate < NUM_CANDIDATES; ++candidate)
+	{
+		long long score(0);
+		for (int rollout = thread; rollout < NUM_ROLLOUTS; rollout += numberOfThreads)
+		{
+			score += playRollout(*job.game, candidate, rolloutSeed(job.move, candidate, rollout), steps);
+		}
+		job.results[thread].scores[candidate] = score;
+	}
+	job.results[thread].steps = steps;
+}
+
+void rolloutWorker(int thread)
+{
+	unsigned int generation(0);
+	for (;;)
+	{
+		{
+			unique_lock<mutex> lock(jobMutex);
+			while (jobGeneration == generation && !stopWorkers)
+			{
+				jobStart.wait(lock);
+			}
+			if (stopWorkers)
+			{
+				return;
+			}
+			generation = jobGeneration;
+		}
+
+		playRollouts(thread);
+
+		{
+			lock_guard<mutex> lock(jobMutex);
+			if (--workersBusy == 0)
+			{
+				jobDone.notify_one();
+			}
+		}
+	}
+}
+
+int chooseKey(const GameState& game, unsigned int move)
+{
+	// run the rollouts of all keys on all threads and pick the key with the best total score
+	job.game = &game;
+	job.move = move;
+	{
+		lock_guard<mutex> lock(jobMutex);
+		workersBusy = numberOfThreads - 1;
+		++jobGeneration;
+	}
+	jobStart.notify_all();
+
+	playRollouts(0);
+
+	{
+		unique_lock<mutex> lock(jobMutex);
+		while (workersBusy > 0)
+		{
+			jobDone.wait(lock);
+		}
+	}
+
+	int bestKey(4);
+	long long bestScore(0);
+	for (int candidate = 0; candidate < NUM_CANDIDATES; ++candidate)
+	{
+		long long score(0);
+		for (int t = 0; t < numberOfThreads; ++t)
+		{
+			score += job.results[t].scores[candidate];
+		}
+		if (candidate == 0 || score > bestScore)
+		{
+			bestScore = score;
+			bestKey = candidate;
+		}
+	}
+	return bestKey;
+}
+
+// End of the 'SNAIL TRAIL' listing
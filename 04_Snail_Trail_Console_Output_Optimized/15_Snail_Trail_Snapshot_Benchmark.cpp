@@ -0,0 +1,184 @@
+/*
+15_Snail_Trail_Snapshot_Benchmark
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version measures how long it takes to save and restore a game, which is what search, rollback and checkpoints
+are built on. The recorded keys of version 11 are replayed with the game code from "SnailEngine.h" and a snapshot of
+every frame is saved to a SnapshotArena (see "SnapshotArena.h"). These snapshots are then restored and saved over and
+over again, and the same is done with deltas against the initial layout of each game.
+Before timing anything, every snapshot and delta is checked: the game restored from it has to be equal to the game at
+that frame, and playing on from it has to lead to the same end of the game.
+The times are taken for a large number of operations at once, as a single one takes less time than the resolution of
+the timer.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "SnapshotArena.h"   //for SnapshotArena, encodeDelta, etc.
+
+// repeat saving and restoring all snapshots this many times
+const unsigned int numberOfCycles(20000);
+
+// read in keys from this array (recorded for version 11)
+const int NUM_KEYS(360);
+const unsigned int keys[NUM_KEYS] = {3,3,3,3,0,0,0,0,0,0,0,0,3,3,3,0,0,0,0,2,2,2,2,2,2,1,2,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,0,2,2,2,2,2,1,1,1,1,3,3,3,3,0,3,3,0,2,2,2,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,2,1,1,1,1,0,0,3,0,2,2,2,0,0,2,2,2,3,3,0,0,0,0,0,0,0,2,3,3,0,3,3,0,3,0,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,2,1,1,3,3,3,1,2,1,1,1,1,1,2,0,2,2,0,2,2,2,0,0,0,0,0,3,3,0,0,0,0,0,0,0,3,3,1,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,2,2,0,2,2,2,2,2,2,0,0,3,0,0,3,0,0,0,0,2,0,0,0,3,0,2,0,0,0,3,0,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,0,0,0,0,0,0,0,0,3,0,0,2,2,2,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,5,5};
+
+// a checkpoint of the recorded games
+struct Checkpoint
+{
+	unsigned int slot;			// snapshot in the arena
+	unsigned int initial;		// snapshot of the initial layout of the game
+	unsigned int keyCount;		// position of the next key
+	unsigned int delta;			// position of the delta in the delta store
+};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	unsigned int playToEnd(GameState&, unsigned int);
+
+	SnapshotArena arena(2 * NUM_KEYS);
+	vector<Checkpoint> checkpoints;
+
+	GameState game;
+	seedGame(game, 256);
+
+	/**********************************************************************************************
+	Replay the recorded games and save every frame
+	***********************************************************************************************/
+
+	unsigned int keyCount(0);
+	unsigned int key(4);
+
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		const unsigned int initial = arena.save(game);
+
+		key = keys[keyCount++];
+
+		while (!isGameOver(game) && key != 5)
+		{
+			Checkpoint checkpoint;
+			checkpoint.slot = arena.save(game);
+			checkpoint.initial = initial;
+			checkpoint.keyCount = keyCount - 1;
+			checkpoints.push_back(checkpoint);
+
+			stepGame(game, key);
+			key = keys[keyCount++];
+		}
+
+		key = keys[keyCount++];		// another go
+	}
+
+	printf("%u frames saved, %u bytes per snapshot\n", static_cast<unsigned int>(checkpoints.size()), static_cast<unsigned int>(sizeof(GameState)));
+
+	/**********************************************************************************************
+	Check snapshots and deltas
+	***********************************************************************************************/
+
+	// all deltas one after the other
+	vector<unsigned char> deltas(checkpoints.size() * MAX_DELTA_SIZE);
+	unsigned int deltaBytes(0);
+	unsigned int errors(0);
+
+	for (size_t i = 0; i < checkpoints.size(); ++i)
+	{
+		GameState restored;
+		arena.restore(checkpoints[i].slot, restored);
+
+		GameState expected = restored;
+		const unsigned int expectedEnd = playToEnd(expected, checkpoints[i].keyCount);
+
+		// restoring from the delta has to give back the very same bytes
+		checkpoints[i].delta = deltaBytes;
+		deltaBytes += encodeDelta(arena[checkpoints[i].initial], restored, &deltas[deltaBytes]);
+		GameState decoded;
+		decodeDelta(arena[checkpoints[i].initial], &deltas[checkpoints[i].delta], decoded);
+		if (memcmp(&decoded, &restored, sizeof(GameState)) != 0)
+		{
+			++errors;
+			continue;
+		}
+
+		// and so does playing on from it
+		if (playToEnd(decoded, checkpoints[i].keyCount) != expectedEnd || memcmp(&decoded, &expected, sizeof(GameState)) != 0)
+		{
+			++errors;
+		}
+	}
+
+	printf("%u errors, %.1f bytes per delta on average\n", errors, static_cast<double>(deltaBytes) / checkpoints.size());
+
+	/**********************************************************************************************
+	Time snapshots and deltas
+	***********************************************************************************************/
+
+	CStopWatch s;
+	unsigned long long checksum(0);
+	const unsigned int numberOfCheckpoints = static_cast<unsigned int>(checkpoints.size());
+	const unsigned int scratch = arena.size();
+
+	// restore every frame, change it a bit, then save it (always to the same spare slot, so the arena doesn't run full)
+	s.startTimer();
+	for (unsigned int cycle = 0; cycle < numberOfCycles; ++cycle)
+	{
+		for (unsigned int i = 0; i < numberOfCheckpoints; ++i)
+		{
+			arena.restore(checkpoints[i].slot, game);
+			game.randomSeed += cycle;
+			arena.rewind(scratch);
+			arena.save(game);
+			checksum += arena[scratch].randomSeed;
+		}
+	}
+	s.stopTimer();
+	const double operations = 2.0 * numberOfCycles * numberOfCheckpoints;
+	printf("snapshot save/restore: %.1f ns\n", s.getElapsedTime() * 1e9 / operations);
+
+	// the same with deltas, written to a spare buffer
+	vector<unsigned char> delta(MAX_DELTA_SIZE);
+	const unsigned int deltaCycles = numberOfCycles / 10;
+	s.startTimer();
+	for (unsigned int cycle = 0; cycle < deltaCycles; ++cycle)
+	{
+		for (unsigned int i = 0; i < numberOfCheckpoints; ++i)
+		{
+			decodeDelta(arena[checkpoints[i].initial], &deltas[checkpoints[i].delta], game);
+			game.randomSeed += cycle;
+			checksum += encodeDelta(arena[checkpoints[i].initial], game, &delta[0]);
+		}
+	}
+	s.stopTimer();
+	printf("delta encode/decode:   %.1f ns\n", s.getElapsedTime() * 1e9 / (2.0 * deltaCycles * numberOfCheckpoints));
+
+	printf("(checksum %llu)\n", checksum);
+
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// play the recorded keys from the given position until the game ends, returns the position of the last key used
+unsigned int playToEnd(GameState& game, unsigned int keyCount)
+{
+	unsigned int key = keys[keyCount];
+	while (!isGameOver(game) && key != 5)
+	{
+		stepGame(game, key);
+		key = keys[++keyCount];
+	}
+	return keyCount;
+}
+
+// End of the 'SNAIL TRAIL' listing
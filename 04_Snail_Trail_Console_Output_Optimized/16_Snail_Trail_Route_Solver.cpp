@@ -0,0 +1,530 @@
+/*
+16_Snail_Trail_Route_Solver
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version finds the shortest possible game: the fewest keys that get the snail to eat all lettuces without eating
+too many pellets or being caught by a frog. As the game is seeded with 256, the eagle strikes are known in advance and
+every key leads to exactly one next game, so the games that can be reached form a graph that can be searched.
+The search is an A* search over the GameStates of "SnailEngine.h". A game is rated by the keys pressed so far plus the
+length of the shortest walk from the snail past all remaining lettuces, which no route can beat (frogs sitting on a
+lettuce are counted as that lettuce). The games are searched in order of this rating, so the first win found is a
+shortest one. Games already reached are entered into a TranspositionTable (see "TranspositionTable.h"), a lock-free
+hash table shared by all threads, and are not searched again unless they are reached with fewer keys. A wall, slime or
+the 'other' key all leave the snail where it is, so they lead to the same game and only one of them is kept.
+The games waiting to be searched are kept as deltas against the initial layout (see "SnapshotArena.h"). The games with
+the current rating are split over all cores, every thread takes the next chunk of them until all are done, then the
+new games are sorted in by their rating and the next round starts.
+The search of a layout gives up after MAX_STATES games, counted as they are entered into the table, so that a round
+stops as soon as it gets there (or if the table is full). If it does, the rating it had got to is still a lower bound
+for the length of any route.
+The layouts solved are those of the games recorded for version 11, so the shortest route can be compared to the keys
+that were pressed in the recording. Every route found is played to check that it wins, and written to "Routes.txt",
+one line per layout, with the same key codes as "Keys.txt" ("-" for a layout that was not solved).
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <fstream>           //for files
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>         //for next_permutation, reverse
+#include <vector>
+#include <atomic>
+#include <thread>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"         //for GameState, stepGame, etc.
+#include "SnapshotArena.h"       //for encodeDelta, decodeDelta
+#include "TranspositionTable.h"  //for TranspositionTable, hashGame
+
+// read in keys from this array (recorded for version 11), every game played gives a layout to solve
+const int NUM_KEYS(360);
+const unsigned int keys[NUM_KEYS] = {3,3,3,3,0,0,0,0,0,0,0,0,3,3,3,0,0,0,0,2,2,2,2,2,2,1,2,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,0,2,2,2,2,2,1,1,1,1,3,3,3,3,0,3,3,0,2,2,2,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,2,1,1,1,1,0,0,3,0,2,2,2,0,0,2,2,2,3,3,0,0,0,0,0,0,0,2,3,3,0,3,3,0,3,0,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,2,1,1,3,3,3,1,2,1,1,1,1,1,2,0,2,2,0,2,2,2,0,0,0,0,0,3,3,0,0,0,0,0,0,0,3,3,1,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,2,2,0,2,2,2,2,2,2,0,0,3,0,0,3,0,0,0,0,2,0,0,0,3,0,2,0,0,0,3,0,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,0,0,0,0,0,0,0,0,3,0,0,2,2,2,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,5,5};
+
+// the search of a layout gives up after this many games
+const unsigned int MAX_STATES(1 << 22);
+// size of the transposition table (2 to the power of TABLE_BITS entries), at least twice MAX_STATES
+const unsigned int TABLE_BITS(23);
+
+// the keys searched (a wall, slime and 'other' are the same key as far as the game is concerned)
+const int NUM_CANDIDATES(5);
+
+// each thread takes this many games at a time
+const unsigned int CHUNK_SIZE(64);
+// rounds with fewer games than this are done by the main thread only
+const unsigned int MIN_PARALLEL(1024);
+
+// marks a game that cannot be won any more
+const int UNREACHABLE(-1);
+
+// marks the initial game, and that no win has been found
+const unsigned int NO_NODE(0xFFFFFFFFu);
+
+// a game that has been reached, used to follow the route back once the search has found a win
+struct Node
+{
+	unsigned int parent;		// the node the key was pressed in
+	unsigned short moves;		// keys pressed so far
+	unsigned char key;			// the key pressed
+};
+
+// games with the same rating, waiting to be searched
+struct Bucket
+{
+	vector<unsigned char> deltas;
+	vector<size_t> offsets;		// start of the delta of each game
+	vector<unsigned int> nodes;	// node of each game
+};
+
+// a new game found by a thread, sorted into the buckets after the round
+struct Child
+{
+	unsigned int parent;
+	unsigned int rating;
+	size_t offset;				// start of the delta in the deltas of the thread
+	unsigned short moves;
+	unsigned char key;
+};
+
+// everything one thread finds in a round, padded so that the counters of the threads are on cache lines of their own
+struct ThreadOutput
+{
+	vector<unsigned char> deltas;
+	vector<Child> children;
+	unsigned int win;			// node of a won game, or NO_NODE
+	long long expanded;
+	char padding[64];
+};
+
+// the round being searched
+struct SearchRound
+{
+	const GameState* initial;
+	const Bucket* bucket;
+	const vector<Node>* nodes;
+	TranspositionTable* table;
+	atomic<size_t> next;
+	atomic<unsigned int> states;	// games entered so far
+	atomic<bool> full;				// MAX_STATES games entered, or the table is full
+	ThreadOutput outputs[16];	// one per thread
+};
+
+int numberOfThreads(1);
+SearchRound job;
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	bool solveLayout(const GameState&, vector<int>&, long long&, long long&, unsigned int&);
+
+	numberOfThreads = thread::hardware_concurrency();
+	if (numberOfThreads < 1) numberOfThreads = 1;
+	if (numberOfThreads > 16) numberOfThreads = 16;
+
+	/**********************************************************************************************
+	Replay the recorded games to get their layouts
+	***********************************************************************************************/
+
+	vector<GameState> layouts;
+	vector<int> recordedKeys;		// keys pressed in the recorded game
+	vector<bool> recordedWins;
+
+	GameState game;
+	seedGame(game, 256);
+
+	unsigned int keyCount(0);
+	unsigned int key(4);
+
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		layouts.push_back(game);
+
+		int frames(0);
+		key = keys[keyCount++];
+		while (!isGameOver(game) && key != 5)
+		{
+			stepGame(game, key);
+			++frames;
+			key = keys[keyCount++];
+		}
+		recordedKeys.push_back(frames);
+		recordedWins.push_back(game.isSnailAlive && game.counters[3] == LETTUCE_QUOTA);
+
+		if (key != 5)
+		{
+			key = keys[keyCount++];		// another go
+		}
+	}
+
+	/**********************************************************************************************
+	Solve every layout
+	***********************************************************************************************/
+
+	ofstream outRoutes("Routes.txt");
+
+	long long totalStates(0);
+	long long totalExpanded(0);
+	int solved(0);
+
+	CStopWatch s;
+	s.startTimer();
+
+	for (size_t layout = 0; layout < layouts.size(); ++layout)
+	{
+		CStopWatch layoutTimer;
+		layoutTimer.startTimer();
+
+		vector<int> route;
+		long long states(0);
+		long long expanded(0);
+		unsigned int bound(0);
+		const bool found = solveLayout(layouts[layout], route, states, expanded, bound);
+
+		layoutTimer.stopTimer();
+		totalStates += states;
+		totalExpanded += expanded;
+
+		printf("layout %2u (recorded: %s after %d keys): ", static_cast<unsigned int>(layout + 1), recordedWins[layout] ? "won" : "lost", recordedKeys[layout]);
+		if (!found)
+		{
+			printf("no route within %u games, at least %u keys", MAX_STATES, bound);
+			outRoutes << "-";
+		}
+		else
+		{
+			// check the route by playing it
+			game = layouts[layout];
+			for (size_t i = 0; i < route.size(); ++i)
+			{
+				outRoutes << keyCodes[route[i]] << ",";
+				stepGame(game, route[i]);
+			}
+
+			if (game.isSnailAlive && game.counters[3] == LETTUCE_QUOTA)
+			{
+				++solved;
+				printf("%u keys", static_cast<unsigned int>(route.size()));
+			}
+			else
+			{
+				printf("the route of %u keys does not win!", static_cast<unsigned int>(route.size()));
+			}
+		}
+		outRoutes << endl;
+
+		printf(", %lld games reached, %lld searched (%.2f s)\n", states, expanded, layoutTimer.getElapsedTime());
+	}
+	outRoutes.close();
+
+	s.stopTimer();
+
+	printf("%d of %u layouts solved, %d threads\n", solved, static_cast<unsigned int>(layouts.size()), numberOfThreads);
+	printf("%.0f games reached/s, %.0f games searched/s\n", totalStates / s.getElapsedTime(), totalExpanded / s.getElapsedTime());
+
+	return 0;
+} //end main
+
+/***************************************************************************************
+Rating
+****************************************************************************************/
+
+// the fewest keys needed to eat the remaining lettuces, as if there were nothing else in the garden
+int remainingMoves(const GameState& game)
+{
+	int lettuces[LETTUCE_QUOTA + NUM_FROGS][2];
+	int numberOfLettuces(0);
+
+	for (int y = 1; y < SIZEY - 1; ++y)
+	{
+		for (int x = 1; x < SIZEX - 1; ++x)
+		{
+			if (game.garden[y][x] == LETTUCE && numberOfLettuces < LETTUCE_QUOTA)
+			{
+				lettuces[numberOfLettuces][0] = y;
+				lettuces[numberOfLettuces][1] = x;
+				++numberOfLettuces;
+			}
+		}
+	}
+	for (int frog = 0; frog < NUM_FROGS; ++frog)
+	{
+		if (game.frogs[frog * 2] >= 0 && game.lettucesBlocked[frog])
+		{
+			lettuces[numberOfLettuces][0] = game.frogs[frog * 2];
+			lettuces[numberOfLettuces][1] = game.frogs[frog * 2 + 1];
+			++numberOfLettuces;
+		}
+	}
+
+	const int needed = LETTUCE_QUOTA - game.counters[3];
+	if (numberOfLettuces < needed)
+	{
+		return UNREACHABLE;		// a frog landing on another frog can lose a lettuce
+	}
+
+	// try all orders, there are only a few lettuces
+	int order[LETTUCE_QUOTA + NUM_FROGS];
+	for (int i = 0; i < numberOfLettuces; ++i)
+	{
+		order[i] = i;
+	}
+
+	int shortest(SIZEX * SIZEY * LETTUCE_QUOTA);
+	do
+	{
+		int length(0);
+		int y = game.snail[0];
+		int x = game.snail[1];
+		for (int i = 0; i < needed; ++i)
+		{
+			length += abs(lettuces[order[i]][0] - y) + abs(lettuces[order[i]][1] - x);
+			y = lettuces[order[i]][0];
+			x = lettuces[order[i]][1];
+		}
+		if (length < shortest)
+		{
+			shortest = length;
+		}
+	}while (next_permutation(order, order + numberOfLettuces));
+
+	return shortest;
+}
+
+/***************************************************************************************
+Search
+****************************************************************************************/
+
+void searchRound(int thread)
+{
+	// every thread takes the next chunk of games of the round until there are none left
+	ThreadOutput& output = job.outputs[thread];
+	const Bucket& bucket = *job.bucket;
+	const size_t numberOfGames = bucket.nodes.size();
+
+	while (!job.full.load(memory_order_relaxed))
+	{
+		const size_t first = job.next.fetch_add(CHUNK_SIZE);
+		if (first >= numberOfGames)
+		{
+			break;
+		}
+		const size_t last = min(first + CHUNK_SIZE, numberOfGames);
+
+		for (size_t i = first; i < last; ++i)
+		{
+			GameState game;
+			decodeDelta(*job.initial, &bucket.deltas[bucket.offsets[i]], game);
+			const unsigned int node = bucket.nodes[i];
+			const unsigned int moves = (*job.nodes)[node].moves;
+
+			if (game.isSnailAlive && game.counters[3] == LETTUCE_QUOTA)
+			{
+				if (node < output.win)
+				{
+					output.win = node;
+				}
+				continue;
+			}
+			++output.expanded;
+
+			bool stayedPut(false);
+			for (int key = 0; key < NUM_CANDIDATES; ++key)
+			{
+				const char target = game.garden[game.snail[0] + moveDirections[key < 4 ? key : 0][0]][game.snail[1] + moveDirections[key < 4 ? key : 0][1]];
+				const bool staysPut = key == 4 || target == WALL || target == SLIME;
+				if (staysPut)
+				{
+					if (stayedPut)
+					{
+						continue;		// same game as the last key that left the snail where it is
+					}
+					stayedPut = true;
+				}
+
+				GameState next = game;
+				stepGame(next, key);
+				if (!next.isSnailAlive)
+				{
+					continue;
+				}
+
+				const int remaining = remainingMoves(next);
+				if (remaining == UNREACHABLE)
+				{
+					continue;
+				}
+
+				const TableInsert inserted = job.table->insert(hashGame(next), moves + 1);
+				if (inserted == TABLE_REACHED)
+				{
+					continue;
+				}
+				if (inserted == TABLE_FULL || job.states++ >= MAX_STATES)
+				{
+					job.full = true;
+					return;
+				}
+
+				Child child;
+				child.parent = node;
+				child.rating = moves + 1 + remaining;
+				child.moves = static_cast<unsigned short>(moves + 1);
+				child.key = static_cast<unsigned char>(key);
+				child.offset = output.deltas.size();
+				output.deltas.resize(child.offset + MAX_DELTA_SIZE);
+				output.deltas.resize(child.offset + encodeDelta(*job.initial, next, &output.deltas[child.offset]));
+				output.children.push_back(child);
+			}
+		}
+	}
+}
+
+bool solveLayout(const GameState& initial, vector<int>& route, long long& states, long long& expanded, unsigned int& bound)
+{
+	// search for the shortest route from the initial layout, returns false if MAX_STATES games were not enough
+	TranspositionTable table(TABLE_BITS);
+	vector<vector<Bucket> > buckets;		// by rating and keys pressed
+	vector<Node> nodes;
+
+	// the initial game
+	Node root;
+	root.parent = NO_NODE;
+	root.moves = 0;
+	root.key = 4;
+	nodes.push_back(root);
+	table.insert(hashGame(initial), 0);
+
+	unsigned int rating = remainingMoves(initial);
+	buckets.resize(rating + 1);
+	buckets[rating].resize(1);
+	buckets[rating][0].offsets.push_back(0);
+	buckets[rating][0].nodes.push_back(0);
+	buckets[rating][0].deltas.resize(MAX_DELTA_SIZE);
+	buckets[rating][0].deltas.resize(encodeDelta(initial, initial, &buckets[rating][0].deltas[0]));
+
+	job.initial = &initial;
+	job.nodes = &nodes;
+	job.table = &table;
+
+	unsigned int win(NO_NODE);
+	Bucket current;
+
+	while (win == NO_NODE)
+	{
+		// find the lowest rating with games left
+		while (rating < buckets.size() && buckets[rating].empty())
+		{
+			++rating;
+		}
+		if (rating >= buckets.size())
+		{
+			break;		// nothing left, the game cannot be won
+		}
+		if (nodes.size() >= MAX_STATES)
+		{
+			break;
+		}
+
+		// search the games with this rating that are furthest on, a win has as many keys pressed as its rating, so
+		// this goes straight for the win instead of trying all the ways of getting there that are just as long
+		vector<Bucket>& ratingBuckets = buckets[rating];
+		current.deltas.clear();
+		current.offsets.clear();
+		current.nodes.clear();
+		swap(current, ratingBuckets.back());
+		while (!ratingBuckets.empty() && ratingBuckets.back().nodes.empty())
+		{
+			ratingBuckets.pop_back();
+		}
+
+		job.bucket = &current;
+		job.next = 0;
+		job.states = static_cast<unsigned int>(nodes.size());
+		job.full = false;
+
+		const int threads = current.nodes.size() >= MIN_PARALLEL ? numberOfThreads : 1;
+		for (int t = 0; t < threads; ++t)
+		{
+			job.outputs[t].deltas.clear();
+			job.outputs[t].children.clear();
+			job.outputs[t].win = NO_NODE;
+			job.outputs[t].expanded = 0;
+		}
+
+		vector<thread> workers;
+		for (int t = 1; t < threads; ++t)		// the main thread is thread 0
+		{
+			workers.push_back(thread(searchRound, t));
+		}
+		searchRound(0);
+		for (size_t t = 0; t < workers.size(); ++t)
+		{
+			workers[t].join();
+		}
+		if (job.full)
+		{
+			break;		// gave up, the children of the round are left out
+		}
+
+		// sort the new games into the buckets
+		for (int t = 0; t < threads; ++t)
+		{
+			const ThreadOutput& output = job.outputs[t];
+			expanded += output.expanded;
+			if (output.win < win)
+			{
+				win = output.win;
+			}
+
+			for (size_t c = 0; c < output.children.size(); ++c)
+			{
+				const Child& child = output.children[c];
+				const size_t end = c + 1 < output.children.size() ? output.children[c + 1].offset : output.deltas.size();
+
+				if (child.rating >= buckets.size())
+				{
+					buckets.resize(child.rating + 1);
+				}
+				if (child.moves >= buckets[child.rating].size())
+				{
+					buckets[child.rating].resize(child.moves + 1);
+				}
+				Bucket& bucket = buckets[child.rating][child.moves];
+				bucket.offsets.push_back(bucket.deltas.size());
+				bucket.nodes.push_back(static_cast<unsigned int>(nodes.size()));
+				bucket.deltas.insert(bucket.deltas.end(), output.deltas.begin() + child.offset, output.deltas.begin() + end);
+
+				Node node;
+				node.parent = child.parent;
+				node.moves = child.moves;
+				node.key = child.key;
+				nodes.push_back(node);
+			}
+		}
+	}
+
+	states = static_cast<long long>(nodes.size());
+	bound = rating;
+
+	if (win == NO_NODE)
+	{
+		return false;
+	}
+
+	// follow the route back from the win
+	route.clear();
+	for (unsigned int node = win; nodes[node].parent != NO_NODE; node = nodes[node].parent)
+	{
+		route.push_back(nodes[node].key);
+	}
+	reverse(route.begin(), route.end());
+	return true;
+}
+
+// End of the 'SNAIL TRAIL' listing
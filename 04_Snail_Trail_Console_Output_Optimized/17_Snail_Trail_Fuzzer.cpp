@@ -0,0 +1,443 @@
+/*
+17_Snail_Trail_Fuzzer
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version is a safety net for changes to the game code. It plays a large number of random key streams with the
+game code of "SnailEngine.h" and checks after every key that nothing impossible has happened to the game:
+- the garden walls are intact
+- there is at most one snail in the garden
+- there are no more frogs in the garden than frogs alive, and no more frog bones than frogs killed by the eagle
+- there are no more than SLIMELIFE fields of slime
+- no lettuce appears out of nowhere or goes missing without being eaten
+The original game loses a lettuce when two frogs meet on it: the frog that leaves last puts back what it found, the
+other frog. "SnailEngine.h" keeps this bug of version 12, so that its games are the same as those of version 12, and a
+lettuce lost where the garden shows that two frogs have met does not break the rule, but every one of them is counted
+and reported at the end with the first stream it happened in; a lettuce lost in any other way breaks the rule.
+- the counters and the snail are within their ranges
+The key streams are made up of the key codes found in "Keys.txt", including 100 and 102 which getKeyPress turns into
+the 'other' key, and are passed through translateKey like a recording. A stream goes on into the next game when a game
+is over. Every stream is seeded with 256 like version 12, and the streams have different keys, so that the games after
+the first end after different numbers of frames and all kinds of layouts and eagle strikes are tried.
+The streams are spread over all cores. When a stream breaks a rule, it is shrunk to as few keys as possible that still
+break the same rule: parts of it are cut out as long as it keeps failing, then the keys left are replaced by 100 where
+possible. The shrunk stream is written to "FuzzKeys.txt" in the format of "Keys.txt", with the two keys version 12
+reads after a game is over (the key after the last frame and the answer to "another go") wherever a game ends, so
+that version 12 replays it.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <fstream>           //for files
+#include <cstdio>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+
+// number of key streams to play and their length, and the seed of every stream (as in version 12)
+const int NUM_STREAMS(20000);
+const int STREAM_KEYS(500);
+const unsigned int SEED(256);
+
+// each thread takes this many streams at a time
+const int CHUNK_SIZE(64);
+
+// the key codes a stream is made up of (no 'q', a stream only ends when it runs out of keys)
+const int NUM_RAW_KEYS(6);
+const int rawKeys[NUM_RAW_KEYS] = {LEFT, RIGHT, UP, DOWN, 100, 102};
+
+// the rules checked after every key
+enum Invariant
+{
+	INVARIANT_NONE,
+	INVARIANT_WALLS,
+	INVARIANT_SNAILS,
+	INVARIANT_FROGS,
+	INVARIANT_BONES,
+	INVARIANT_SLIME,
+	INVARIANT_LETTUCES,
+	INVARIANT_COUNTERS
+};
+
+const char* invariantNames[] = {"none", "walls intact", "at most one snail", "frogs alive shown", "frog bones",
+	"slime lasts SLIMELIFE keys", "lettuces kept", "counters in range"};
+
+// the first stream that broke a rule
+atomic<int> firstFailure(NUM_STREAMS);
+
+// lettuces lost where two frogs met (see above), the streams they were lost in and the first of them
+atomic<long long> lettucesLost(0);
+atomic<int> streamsLosingLettuces(0);
+atomic<int> firstLettuceLoss(NUM_STREAMS);
+atomic<long long> totalSteps(0);
+atomic<int> nextStream(0);
+int numberOfThreads(1);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	void fuzzStreams();
+	void makeStream(int, vector<int>&);
+	Invariant playStream(const vector<int>&, int&, int&);
+	void shrinkStream(vector<int>&, Invariant);
+
+	numberOfThreads = thread::hardware_concurrency();
+	if (numberOfThreads < 1) numberOfThreads = 1;
+
+	CStopWatch s;
+	s.startTimer();
+
+	vector<thread> workers;
+	for (int t = 1; t < numberOfThreads; ++t)		// the main thread is worker 0
+	{
+		workers.push_back(thread(fuzzStreams));
+	}
+	fuzzStreams();
+	for (size_t t = 0; t < workers.size(); ++t)
+	{
+		workers[t].join();
+	}
+
+	s.stopTimer();
+
+	const int failure = firstFailure;
+	const int streams = failure < NUM_STREAMS ? failure + 1 : NUM_STREAMS;
+	printf("%d streams, %lld keys, %d threads\n", streams, totalSteps.load(), numberOfThreads);
+	printf("%.0f keys/s\n", totalSteps / s.getElapsedTime());
+	if (lettucesLost > 0)
+	{
+		printf("%lld lettuces lost where two frogs met (a bug of version 12), in %d streams, the first in stream %d\n",
+			lettucesLost.load(), streamsLosingLettuces.load(), firstLettuceLoss.load());
+	}
+
+	if (failure == NUM_STREAMS)
+	{
+		printf("no rule broken\n");
+		return 0;
+	}
+
+	/**********************************************************************************************
+	Shrink the stream that failed
+	***********************************************************************************************/
+
+	vector<int> keys;
+	makeStream(failure, keys);
+
+	int step(0);
+	int lost(0);
+	const Invariant invariant = playStream(keys, step, lost);
+	printf("stream %d broke \"%s\" at key %d\n", failure, invariantNames[invariant], step + 1);
+
+	shrinkStream(keys, invariant);
+
+	// write the keys as version 12 reads them, showing the garden once the rule has been broken
+	ofstream outKeys("FuzzKeys.txt");
+	printf("shrunk to %u keys:", static_cast<unsigned int>(keys.size()));
+	GameState game;
+	seedGame(game, SEED);
+	initialiseGame(game);
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		if (isGameOver(game))
+		{
+			outKeys << 100 << "," << 100 << ",";		// the key after the last frame, and another go
+			initialiseGame(game);
+		}
+		stepGame(game, translateKey(keys[i]));
+		outKeys << keys[i] << ",";
+		printf(" %d", keys[i]);
+	}
+	outKeys << 113 << ",";						// quit (or the key after the last frame, and no other go)
+	outKeys.close();
+	printf("\nwritten to FuzzKeys.txt, replay with seedGame(game, %u)\n", SEED);
+	for (int row = 0; row < SIZEY; ++row)
+	{
+		printf("%.*s\n", SIZEX, game.garden[row]);
+	}
+
+	return 1;
+} //end main
+
+/***************************************************************************************
+Rules
+****************************************************************************************/
+
+// true if two frogs have met, which the original game does not handle (the garden does not show a frog where one is)
+bool frogsHaveMet(const GameState& game)
+{
+	for (int frog = 0; frog < NUM_FROGS; ++frog)
+	{
+		const int* position = &game.frogs[frog * 2];
+		if (position[0] >= 0 && game.garden[position[0]][position[1]] != FROG)
+		{
+			return true;
+		}
+	}
+	return game.frogs[0] >= 0 && game.frogs[0] == game.frogs[2] && game.frogs[1] == game.frogs[3];
+}
+
+// lettuces under frogs and eaten
+int hiddenLettuces(const GameState& game)
+{
+	int lettuces = game.counters[3];
+	for (int frog = 0; frog < NUM_FROGS; ++frog)
+	{
+		lettuces += game.frogs[frog * 2] >= 0 && game.lettucesBlocked[frog];
+	}
+	return lettuces;
+}
+
+// lettuces in the garden, under frogs and eaten
+int countLettuces(const GameState& game)
+{
+	int lettuces = hiddenLettuces(game);
+	for (int y = 1; y < SIZEY - 1; ++y)
+	{
+		for (int x = 1; x < SIZEX - 1; ++x)
+		{
+			lettuces += game.garden[y][x] == LETTUCE;
+		}
+	}
+	return lettuces;
+}
+
+// checks the game after a key, the number of lettuces and whether frogs have met are passed on from key to key, the
+// lettuces lost where two frogs met are added to lost
+Invariant checkGame(const GameState& game, int& lettucesBefore, bool& frogsMetBefore, int& lost)
+{
+	const char (&garden)[SIZEY][SIZEX+2] = game.garden;
+
+	for (int x = 0; x < SIZEX; ++x)
+	{
+		if (garden[0][x] != WALL || garden[SIZEY - 1][x] != WALL)
+		{
+			return INVARIANT_WALLS;
+		}
+	}
+	for (int y = 1; y < SIZEY - 1; ++y)
+	{
+		if (garden[y][0] != WALL || garden[y][SIZEX - 1] != WALL)
+		{
+			return INVARIANT_WALLS;
+		}
+	}
+
+	int snails(0);
+	int frogs(0);
+	int bones(0);
+	int slime(0);
+	int lettuces = hiddenLettuces(game);
+	for (int y = 1; y < SIZEY - 1; ++y)
+	{
+		for (int x = 1; x < SIZEX - 1; ++x)
+		{
+			snails += garden[y][x] == SNAIL;
+			frogs += garden[y][x] == FROG;
+			bones += garden[y][x] == DEAD_FROG_BONES;
+			slime += garden[y][x] == SLIME;
+			lettuces += garden[y][x] == LETTUCE;
+		}
+	}
+
+	int frogsAlive(0);
+	for (int frog = 0; frog < NUM_FROGS; ++frog)
+	{
+		frogsAlive += game.frogs[frog * 2] >= 0;
+	}
+
+	if (snails > 1)
+	{
+		return INVARIANT_SNAILS;
+	}
+	if (frogs > frogsAlive)
+	{
+		return INVARIANT_FROGS;
+	}
+	if (bones > NUM_FROGS - frogsAlive)
+	{
+		return INVARIANT_BONES;
+	}
+	if (slime > SLIMELIFE)
+	{
+		return INVARIANT_SLIME;
+	}
+
+	const bool frogsMet = frogsHaveMet(game);
+	if (lettuces > lettucesBefore || (lettuces < lettucesBefore && !frogsMetBefore && !frogsMet))
+	{
+		return INVARIANT_LETTUCES;
+	}
+	lost += lettucesBefore - lettuces;
+	lettucesBefore = lettuces;
+	frogsMetBefore = frogsMet;
+
+	if (game.counters[1] < 0 || game.counters[1] >= SLIMELIFE || game.counters[2] > PELLET_THRESHOLD ||
+		game.counters[3] > LETTUCE_QUOTA || (game.isSnailAlive && game.counters[2] >= PELLET_THRESHOLD) ||
+		game.snail[0] < 1 || game.snail[0] > SIZEY - 2 || game.snail[1] < 1 || game.snail[1] > SIZEX - 2)
+	{
+		return INVARIANT_COUNTERS;
+	}
+
+	return INVARIANT_NONE;
+}
+
+/***************************************************************************************
+Streams
+****************************************************************************************/
+
+// the keys of a stream, the same for a stream number on any thread
+void makeStream(int stream, vector<int>& keys)
+{
+	unsigned int random = static_cast<unsigned int>(stream) * 0x9E3779B9u + 0x7F4A7C15u;
+	random ^= random >> 16;
+	random *= 0x85EBCA6Bu;
+	random ^= random >> 13;
+	random |= 1;					// xorshift must not start at zero
+
+	keys.resize(STREAM_KEYS);
+	for (int i = 0; i < STREAM_KEYS; ++i)
+	{
+		// xorshift32
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+		keys[i] = rawKeys[random % NUM_RAW_KEYS];
+	}
+}
+
+// plays a stream from a new game, returns the first rule broken and the key that broke it, and the lettuces lost where
+// two frogs met until then
+Invariant playStream(const vector<int>& keys, int& step, int& lost)
+{
+	GameState game;
+	seedGame(game, SEED);
+	initialiseGame(game);
+	int lettuces = countLettuces(game);
+	bool frogsMet = frogsHaveMet(game);
+	lost = 0;
+
+	for (step = 0; step < static_cast<int>(keys.size()); ++step)
+	{
+		if (isGameOver(game))
+		{
+			initialiseGame(game);		// another go
+			lettuces = countLettuces(game);
+			frogsMet = frogsHaveMet(game);
+		}
+
+		stepGame(game, translateKey(keys[step]));
+
+		const Invariant invariant = checkGame(game, lettuces, frogsMet, lost);
+		if (invariant != INVARIANT_NONE)
+		{
+			return invariant;
+		}
+	}
+	return INVARIANT_NONE;
+}
+
+void fuzzStreams()
+{
+	// every thread takes the next chunk of streams until all have been played or a stream has failed
+	vector<int> keys;
+	long long steps(0);
+
+	for (;;)
+	{
+		const int first = nextStream.fetch_add(CHUNK_SIZE);
+		if (first >= firstFailure)
+		{
+			break;
+		}
+
+		for (int stream = first; stream < first + CHUNK_SIZE && stream < firstFailure; ++stream)
+		{
+			makeStream(stream, keys);
+			int step(0);
+			int lost(0);
+			const Invariant invariant = playStream(keys, step, lost);
+			steps += step;
+			if (lost > 0)
+			{
+				lettucesLost += lost;
+				++streamsLosingLettuces;
+				int first = firstLettuceLoss;
+				while (stream < first && !firstLettuceLoss.compare_exchange_weak(first, stream))
+				{
+				}
+			}
+
+			if (invariant != INVARIANT_NONE)
+			{
+				// keep the lowest stream number, so that the same stream is shrunk on any number of threads
+				int failure = firstFailure;
+				while (stream < failure && !firstFailure.compare_exchange_weak(failure, stream))
+				{
+				}
+				break;
+			}
+		}
+	}
+
+	totalSteps += steps;
+}
+
+// cuts keys out of a stream for as long as it still breaks the same rule
+void shrinkStream(vector<int>& keys, Invariant invariant)
+{
+	int step(0);
+	int lost(0);
+	playStream(keys, step, lost);
+	keys.resize(step + 1);		// the keys after the failure do not matter
+
+	vector<int> candidate;
+	for (size_t chunk = keys.size() / 2; chunk >= 1; chunk /= 2)
+	{
+		size_t start(0);
+		while (start < keys.size())
+		{
+			candidate.assign(keys.begin(), keys.begin() + start);
+			if (start + chunk < keys.size())
+			{
+				candidate.insert(candidate.end(), keys.begin() + start + chunk, keys.end());
+			}
+
+			if (!candidate.empty() && playStream(candidate, step, lost) == invariant)
+			{
+				candidate.resize(step + 1);
+				keys.swap(candidate);		// try the same place again
+			}
+			else
+			{
+				start += chunk;
+			}
+		}
+	}
+
+	// the simplest key is one that does nothing
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		if (keys[i] == 100)
+		{
+			continue;
+		}
+		const int key = keys[i];
+		keys[i] = 100;
+		if (playStream(keys, step, lost) != invariant)
+		{
+			keys[i] = key;
+		}
+	}
+
+	playStream(keys, step, lost);
+	keys.resize(step + 1);
+}
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,501 @@
+/*
+18_Snail_Trail_Workload_Generator
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version records new keys for the benchmarks without anyone having to play. When version 09 changed the layouts,
+the keys had to be recorded again by hand, making sure that every possible event occurred. Here this is done by a
+search: the events are those of the PlayerAction and GameAction enums of version 01, which stepGame in "SnailEngine.h"
+reports for every iteration of the game loop.
+The generator is given the seed, the rules (by the name of a set of rules of "RulePresets.h"), the number of frames
+to record and how often every event should occur in them. By default the seed is 256, the rules are those of version
+12, the frames TARGET_FRAMES and the mix of events that of the games recorded for version 11, rounded to whole events,
+with every event occurring at least MIN_EVENTS times; any of them can be set in SETTINGS_FILE, one per line:
+	seed 256
+	rules standard
+	frames 2000
+	mix 3 40          (event 3 of GameEvent, as numbered in the table shown, 40 times per 1000 frames)
+Lines starting with '#' are skipped. Before every few keys, a number of short random key sequences are tried out
+on a copy of the game, and the one whose events are most needed is kept. The events are spread evenly over the frames,
+so an event is needed if it is due by the end of the sequence and has not occurred often enough yet. Events needed
+count the more the rarer they are, events that already occurred often enough count against a sequence. As long as lettuces are needed, a
+sequence also counts for getting the snail closer to one. When a game is over another one is started, until the
+number of frames has been recorded. If an event has not reached its target by then, frames are recorded on until
+every event has, for up to MAX_OVERRUN times the frames asked for; if even that is not enough, the generator says which
+events fell short and fails.
+The keys are written to "WorkloadKeys.txt" in the format of "Keys.txt", so that they can be replayed by the other
+versions (recorded with seed 256 and the standard rules, as all recorded games are, unless the settings say otherwise;
+a recording for other rules or another seed can only be replayed with the same ones). As in version 12, a key is read
+after every frame, also after the last one of a game, and one more to play another game or not (even if 'q' ended the
+game), so two keys are written after every game. The file is read back and replayed that way to check that it holds
+the frames, games and events recorded.
+The events asked for and recorded are shown at the end. Lettuces and the eagle are the hardest to get: a lettuce is
+often further away than a sequence reaches, and whether the eagle strikes is up to the random numbers of the game, not
+the keys, so it is for these that frames are recorded on past the number asked for.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <fstream>           //for files
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>           //for istringstream
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for BasicGameState, stepGame, etc.
+#include "RulePresets.h"     //for StandardRules, HardRules, etc.
+#include "KeyFile.h"         //for loadKeyFile
+
+// the settings, if there is such a file
+const char* const SETTINGS_FILE("WorkloadSettings.txt");
+
+// the seed of the games recorded and the number of frames to record, unless the settings say otherwise
+const unsigned int SEED(256);
+const int TARGET_FRAMES(2000);
+
+// every event occurs at least this many times
+const int MIN_EVENTS(5);
+
+// frames are recorded on until every event has reached its target, for up to this many times the frames asked for
+const int MAX_OVERRUN(4);
+
+// number of key sequences tried out before keys are chosen, and their length
+const int NUM_SEQUENCES(128);
+const int SEQUENCE_KEYS(8);
+
+// an event that already occurred often enough counts against a sequence by this much
+const double OVERSHOOT(1.0);
+// getting closer to a lettuce counts this much of eating it per field, while lettuces are still needed (lettuces are
+// too far away to be reached by chance)
+const double APPROACH(0.1);
+
+// read in keys from this array (recorded for version 11), their events are the default mix
+const int NUM_KEYS(360);
+const unsigned int keys[NUM_KEYS] = {3,3,3,3,0,0,0,0,0,0,0,0,3,3,3,0,0,0,0,2,2,2,2,2,2,1,2,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,0,2,2,2,2,2,1,1,1,1,3,3,3,3,0,3,3,0,2,2,2,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,2,1,1,1,1,0,0,3,0,2,2,2,0,0,2,2,2,3,3,0,0,0,0,0,0,0,2,3,3,0,3,3,0,3,0,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,2,1,1,3,3,3,1,2,1,1,1,1,1,2,0,2,2,0,2,2,2,0,0,0,0,0,3,3,0,0,0,0,0,0,0,3,3,1,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,2,2,0,2,2,2,2,2,2,0,0,3,0,0,3,0,0,0,0,2,0,0,0,3,0,2,0,0,0,3,0,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,0,0,0,0,0,0,0,0,3,0,0,2,2,2,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,5,5};
+
+// what to record
+struct WorkloadSettings
+{
+	unsigned int seed;
+	string rules;
+	int frames;
+	int mix[NUM_EVENTS];		// events per 1000 frames, or -1 for the mix of the recorded games
+};
+
+// random number generator for the key sequences
+struct SequenceRandom
+{
+	unsigned int state;
+
+	unsigned int next()
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+// adds the events of a frame to the counts
+void countEvents(unsigned int events, int counts[NUM_EVENTS])
+{
+	for (int event = 0; event < NUM_EVENTS; ++event)
+	{
+		counts[event] += (events >> event) & 1;
+	}
+}
+
+/***************************************************************************************
+Recording
+****************************************************************************************/
+
+// distance from the snail to the closest lettuce in the garden
+template <class Rules>
+int lettuceDistance(const BasicGameState<Rules>& game)
+{
+	int closest(Rules::SIZEX + Rules::SIZEY);
+	for (int y = 1; y < Rules::SIZEY - 1; ++y)
+	{
+		for (int x = 1; x < Rules::SIZEX - 1; ++x)
+		{
+			if (game.garden[y][x] == LETTUCE)
+			{
+				const int distance = abs(y - game.snail[0]) + abs(x - game.snail[1]);
+				if (distance < closest)
+				{
+					closest = distance;
+				}
+			}
+		}
+	}
+	return closest;
+}
+
+// plays a sequence on a copy of the game and rates its events by how much they are still needed, a sequence ends
+// early if the game is over
+template <class Rules>
+double rateSequence(const BasicGameState<Rules>& game, const int sequence[SEQUENCE_KEYS], const int remaining[NUM_EVENTS],
+	const double weights[NUM_EVENTS], int& length)
+{
+	BasicGameState<Rules> copy = game;
+	int counts[NUM_EVENTS] = {0};
+
+	for (length = 0; length < SEQUENCE_KEYS && !isGameOver(copy); ++length)
+	{
+		countEvents(stepGame(copy, sequence[length]), counts);
+	}
+
+	double rating(0.0);
+	for (int event = 0; event < NUM_EVENTS; ++event)
+	{
+		const int needed = remaining[event] > 0 ? remaining[event] : 0;
+		if (counts[event] <= needed)
+		{
+			rating += weights[event] * counts[event];
+		}
+		else
+		{
+			rating += weights[event] * (needed - OVERSHOOT * (counts[event] - needed));
+		}
+	}
+
+	const int lettuce = eventIndex(EVENT_HIT_LETTUCE);
+	if (remaining[lettuce] > 0 && copy.isSnailAlive && counts[lettuce] == 0)
+	{
+		rating += weights[lettuce] * APPROACH * (lettuceDistance(game) - lettuceDistance(copy));
+	}
+	return rating;
+}
+
+// counts the events of the games in a key file, read as version 12 reads the keys
+template <class Rules>
+bool replayMix(const char* name, unsigned int seed, int counts[NUM_EVENTS], int& games, int& frames)
+{
+	vector<unsigned char> keyFile;
+	if (!loadKeyFile(name, keyFile))
+	{
+		return false;
+	}
+
+	BasicGameState<Rules> game;
+	seedGame(game, seed);
+
+	games = 0;
+	frames = 0;
+	size_t keyCount(0);
+	int key(4);
+
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		++games;
+		key = keyCount < keyFile.size() ? keyFile[keyCount++] : 5;
+		while (!isGameOver(game) && key != 5)
+		{
+			countEvents(stepGame(game, key), counts);
+			++frames;
+			key = keyCount < keyFile.size() ? keyFile[keyCount++] : 5;
+		}
+		// another go, also after 'q' (as in version 12)
+		key = keyCount < keyFile.size() ? keyFile[keyCount++] : 5;
+	}
+	return true;
+}
+
+// records the keys for the settings with a set of rules, shows the events and checks the keys written, returns the
+// exit code of the program
+template <class Rules>
+int generateWorkload(const WorkloadSettings& settings)
+{
+	int recordedMix(int[NUM_EVENTS]);
+	void makeSequence(SequenceRandom&, int, int[SEQUENCE_KEYS]);
+
+	/**********************************************************************************************
+	Work out how often every event should occur
+	***********************************************************************************************/
+
+	int recorded[NUM_EVENTS] = {0};
+	const int recordedFrames = recordedMix(recorded);
+	const int targetFrames = settings.frames;
+
+	int targets[NUM_EVENTS];
+	double weights[NUM_EVENTS];
+	for (int event = 0; event < NUM_EVENTS; ++event)
+	{
+		// rounded to the closest whole number of events
+		if (settings.mix[event] >= 0)
+		{
+			targets[event] = (settings.mix[event] * targetFrames + 500) / 1000;
+		}
+		else
+		{
+			targets[event] = (recorded[event] * targetFrames + recordedFrames / 2) / recordedFrames;
+		}
+		if (targets[event] < MIN_EVENTS)
+		{
+			targets[event] = MIN_EVENTS;
+		}
+
+		// rare events are worth more
+		weights[event] = static_cast<double>(targetFrames) / targets[event];
+	}
+
+	/**********************************************************************************************
+	Record the keys
+	***********************************************************************************************/
+
+	ofstream outKeys("WorkloadKeys.txt");
+
+	BasicGameState<Rules> game;
+	seedGame(game, settings.seed);
+	initialiseGame(game);
+
+	SequenceRandom random;
+	random.state = settings.seed | 1;
+
+	int counts[NUM_EVENTS] = {0};
+	int remaining[NUM_EVENTS];
+	int frames(0);
+	int games(1);
+	int lastKey(4);
+	int missing(NUM_EVENTS);		// events short of their target
+
+	while (frames < targetFrames || (missing > 0 && frames < MAX_OVERRUN * targetFrames))
+	{
+		// the events due by the end of the next sequence, so that they are spread over all frames (all of them once
+		// the frames asked for have been recorded)
+		const int due = frames + SEQUENCE_KEYS < targetFrames ? frames + SEQUENCE_KEYS : targetFrames;
+		for (int event = 0; event < NUM_EVENTS; ++event)
+		{
+			remaining[event] = (targets[event] * due + targetFrames - 1) / targetFrames - counts[event];
+		}
+
+		// try out a number of key sequences and keep the best
+		int best[SEQUENCE_KEYS];
+		int bestLength(0);
+		double bestRating(0.0);
+		for (int sequence = 0; sequence < NUM_SEQUENCES; ++sequence)
+		{
+			int sequenceKeys[SEQUENCE_KEYS];
+			makeSequence(random, lastKey, sequenceKeys);
+
+			int length(0);
+			const double rating = rateSequence(game, sequenceKeys, remaining, weights, length);
+			if (sequence == 0 || rating > bestRating)
+			{
+				bestRating = rating;
+				bestLength = length;
+				for (int i = 0; i < SEQUENCE_KEYS; ++i)
+				{
+					best[i] = sequenceKeys[i];
+				}
+			}
+		}
+
+		// play it
+		for (int i = 0; i < bestLength && (frames < targetFrames || missing > 0); ++i)
+		{
+			outKeys << keyCodes[best[i]] << ",";
+			countEvents(stepGame(game, best[i]), counts);
+			lastKey = best[i];
+			++frames;
+			missing = 0;
+			for (int event = 0; event < NUM_EVENTS; ++event)
+			{
+				missing += counts[event] < targets[event];
+			}
+		}
+
+		if (isGameOver(game) && (frames < targetFrames || (missing > 0 && frames < MAX_OVERRUN * targetFrames)))
+		{
+			outKeys << keyCodes[4] << ",";		// the key read after the last frame...
+			outKeys << keyCodes[4] << ",";		// ...and any key but 'q' to play another game
+			initialiseGame(game);
+			++games;
+		}
+	}
+
+	outKeys << keyCodes[5] << ",";				// quit the game (or the key read after its last frame)...
+	outKeys << keyCodes[5] << ",";				// ...and don't play another one
+	outKeys.close();
+
+	/**********************************************************************************************
+	Show the events asked for and recorded
+	***********************************************************************************************/
+
+	printf("%d frames (%d asked for), %d games recorded\n", frames, targetFrames, games);
+	printf("%-3s %-18s %10s %10s %10s %10s\n", "", "event", "recorded", "target", "generated", "count");
+	for (int event = 0; event < NUM_EVENTS; ++event)
+	{
+		printf("%-3d %-18s %10.1f %10.1f %10.1f %4d of %3d\n", event, eventNames[event],
+			recorded[event] * 1000.0 / recordedFrames, targets[event] * 1000.0 / targetFrames,
+			counts[event] * 1000.0 / frames, counts[event], targets[event]);
+	}
+	printf("(events per 1000 frames)\n");
+	int errors(0);
+	for (int event = 0; event < NUM_EVENTS; ++event)
+	{
+		if (counts[event] < targets[event])
+		{
+			printf("%s: only %d of the %d asked for in %d frames\n", eventNames[event], counts[event], targets[event],
+				frames);
+			++errors;
+		}
+	}
+
+	/**********************************************************************************************
+	Check that the keys replay as recorded
+	***********************************************************************************************/
+
+	int replayed[NUM_EVENTS] = {0};
+	int replayedGames(0);
+	int replayedFrames(0);
+	if (!replayMix<Rules>("WorkloadKeys.txt", settings.seed, replayed, replayedGames, replayedFrames))
+	{
+		printf("cannot read WorkloadKeys.txt\n");
+		return 1;
+	}
+	int differ = (replayedGames != games) + (replayedFrames != frames);
+	for (int event = 0; event < NUM_EVENTS; ++event)
+	{
+		differ += replayed[event] != counts[event];
+	}
+	printf("WorkloadKeys.txt replays %d frames, %d games, %d counts differ\n", replayedFrames, replayedGames, differ);
+
+	return errors + differ == 0 ? 0 : 1;
+}
+
+// the rules the keys can be recorded for, by the names of "RulePresets.h"
+struct WorkloadRules
+{
+	const char* name;
+	int (*generate)(const WorkloadSettings&);
+};
+
+const WorkloadRules workloadRules[] = {
+	{"standard", &generateWorkload<StandardRules>},
+	{"original", &generateWorkload<OriginalRules>},
+	{"easy", &generateWorkload<EasyRules>},
+	{"hard", &generateWorkload<HardRules>},
+	{"marathon", &generateWorkload<MarathonRules>},
+	{"swarm", &generateWorkload<SwarmRules>},
+	{"crowded", &generateWorkload<CrowdedRules>}
+};
+
+const int NUM_WORKLOAD_RULES(sizeof(workloadRules) / sizeof(workloadRules[0]));
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	bool readSettings(istream&, WorkloadSettings&);
+
+	WorkloadSettings settings;
+	settings.seed = SEED;
+	settings.rules = "standard";
+	settings.frames = TARGET_FRAMES;
+	for (int event = 0; event < NUM_EVENTS; ++event)
+	{
+		settings.mix[event] = -1;
+	}
+	ifstream inSettings(SETTINGS_FILE);
+	if (inSettings && !readSettings(inSettings, settings))
+	{
+		printf("the settings in %s cannot be read\n", SETTINGS_FILE);
+		return 1;
+	}
+
+	for (int i = 0; i < NUM_WORKLOAD_RULES; ++i)
+	{
+		if (settings.rules == workloadRules[i].name)
+		{
+			printf("seed %u, %s rules, %d frames\n", settings.seed, workloadRules[i].name, settings.frames);
+			return workloadRules[i].generate(settings);
+		}
+	}
+	printf("no rules named %s\n", settings.rules.c_str());
+	return 1;
+} //end main
+
+// reads the lines of the settings that are there, returns false if one cannot be read
+bool readSettings(istream& in, WorkloadSettings& settings)
+{
+	string line;
+	while (getline(in, line))
+	{
+		istringstream words(line);
+		string name;
+		if (!(words >> name) || name[0] == '#')
+		{
+			continue;
+		}
+		int event(0);
+		if (name == "seed" ? !(words >> settings.seed) : name == "rules" ? !(words >> settings.rules) :
+			name == "frames" ? !(words >> settings.frames) || settings.frames <= 0 :
+			name == "mix" ? !(words >> event >> settings.mix[event < 0 || event >= NUM_EVENTS ? 0 : event]) ||
+				event < 0 || event >= NUM_EVENTS : true)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/***************************************************************************************
+Events
+****************************************************************************************/
+
+// counts the events of the recorded games, returns the number of frames
+int recordedMix(int counts[NUM_EVENTS])
+{
+	GameState game;
+	seedGame(game, 256);
+
+	int frames(0);
+	unsigned int keyCount(0);
+	unsigned int key(4);
+
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		key = keys[keyCount++];
+		while (!isGameOver(game) && key != 5)
+		{
+			countEvents(stepGame(game, key), counts);
+			++frames;
+			key = keys[keyCount++];
+		}
+		// another go, also after 'q' (as in version 12)
+		key = keys[keyCount++];
+	}
+	return frames;
+}
+
+/***************************************************************************************
+Key sequences
+****************************************************************************************/
+
+// random keys, mostly going on in the same direction for a while as a player would
+void makeSequence(SequenceRandom& random, int lastKey, int sequence[SEQUENCE_KEYS])
+{
+	for (int i = 0; i < SEQUENCE_KEYS; ++i)
+	{
+		const unsigned int r = random.next();
+		if ((r & 3) != 0 && lastKey != 4)
+		{
+			sequence[i] = lastKey;
+		}
+		else
+		{
+			sequence[i] = (r >> 2) % 5;
+		}
+		lastKey = sequence[i];
+	}
+}
+
+// End of the 'SNAIL TRAIL' listing
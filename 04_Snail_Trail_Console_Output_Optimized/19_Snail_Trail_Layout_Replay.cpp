@@ -0,0 +1,184 @@
+/*
+19_Snail_Trail_Layout_Replay
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version turns the recorded keys into replays that do not depend on the random numbers of the game code. Every
+time the initialisation drew a different number of random numbers (version 09) or the eagle changed (version 11), the
+keys had to be recorded again, as the same keys led to different games. A replay (see "LayoutReplay.h") holds the
+layout of every game and whether the eagle got a frog each time it tried, next to the keys, so that it plays the same
+games whatever the game code does with random numbers.
+The keys recorded for version 11 are played with the game code of "SnailEngine.h" seeded with 256, with an eagle that
+logs its strikes, and written to "Replay.txt". That file is then read back and every game is played from it, with the
+random number generator seeded differently, and checked against the recorded game. Finally the time it takes to play
+all games from the replay is compared to playing them from the keys.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <fstream>           //for files
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "LayoutReplay.h"    //for ReplayGame, writeReplay, readReplay, etc.
+
+// play all games this many times for the timing
+const unsigned int numberOfCycles(20000);
+
+// read in keys from this array (recorded for version 11)
+const int NUM_KEYS(360);
+const unsigned int keys[NUM_KEYS] = {3,3,3,3,0,0,0,0,0,0,0,0,3,3,3,0,0,0,0,2,2,2,2,2,2,1,2,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,0,2,2,2,2,2,1,1,1,1,3,3,3,3,0,3,3,0,2,2,2,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,2,1,1,1,1,0,0,3,0,2,2,2,0,0,2,2,2,3,3,0,0,0,0,0,0,0,2,3,3,0,3,3,0,3,0,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,2,1,1,3,3,3,1,2,1,1,1,1,1,2,0,2,2,0,2,2,2,0,0,0,0,0,3,3,0,0,0,0,0,0,0,3,3,1,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,2,2,0,2,2,2,2,2,2,0,0,3,0,0,3,0,0,0,0,2,0,0,0,3,0,2,0,0,0,3,0,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,0,0,0,0,0,0,0,0,3,0,0,2,2,2,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,5,5};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	void recordReplay(vector<ReplayGame>&, vector<GameState>&);
+	bool sameGame(const GameState&, const GameState&);
+
+	/**********************************************************************************************
+	Record the games and write the replay
+	***********************************************************************************************/
+
+	vector<ReplayGame> recorded;
+	vector<GameState> endings;		// how every recorded game ended
+	recordReplay(recorded, endings);
+
+	ofstream outReplay("Replay.txt");
+	writeReplay(outReplay, recorded);
+	outReplay.close();
+
+	unsigned int tries(0);
+	for (size_t g = 0; g < recorded.size(); ++g)
+	{
+		tries += recorded[g].eagle.size();
+	}
+	printf("%u games recorded, %u eagle tries\n", static_cast<unsigned int>(recorded.size()), tries);
+
+	/**********************************************************************************************
+	Read the replay back and play it
+	***********************************************************************************************/
+
+	vector<ReplayGame> games;
+	ifstream inReplay("Replay.txt");
+	if (!readReplay(inReplay, games) || games.size() != recorded.size())
+	{
+		printf("could not read the replay\n");
+		return 1;
+	}
+
+	unsigned int errors(0);
+	GameState game;
+	for (size_t g = 0; g < games.size(); ++g)
+	{
+		seedGame(game, static_cast<unsigned int>(g) * 7919u);		// any seed, the replay does not use it
+		if (!playReplay(game, games[g]) || !sameGame(game, endings[g]))
+		{
+			printf("game %u does not play as recorded\n", static_cast<unsigned int>(g + 1));
+			++errors;
+		}
+	}
+	printf("%u errors\n", errors);
+
+	/**********************************************************************************************
+	Time playing from keys and from the replay
+	***********************************************************************************************/
+
+	CStopWatch s;
+	unsigned long long checksum(0);
+
+	s.startTimer();
+	for (unsigned int cycle = 0; cycle < numberOfCycles; ++cycle)
+	{
+		seedGame(game, 256);
+		unsigned int keyCount(0);
+		unsigned int key(4);
+		while (key != 5)
+		{
+			initialiseGame(game);
+			key = keys[keyCount++];
+			while (!isGameOver(game) && key != 5)
+			{
+				stepGame(game, key);
+				key = keys[keyCount++];
+			}
+			checksum += game.snail[0];
+			if (key != 5)
+			{
+				key = keys[keyCount++];
+			}
+		}
+	}
+	s.stopTimer();
+	printf("from keys:   %.2f us for all games\n", s.getElapsedTime() * 1e6 / numberOfCycles);
+
+	s.startTimer();
+	for (unsigned int cycle = 0; cycle < numberOfCycles; ++cycle)
+	{
+		for (size_t g = 0; g < games.size(); ++g)
+		{
+			playReplay(game, games[g]);
+			checksum += game.snail[0];
+		}
+	}
+	s.stopTimer();
+	printf("from replay: %.2f us for all games\n", s.getElapsedTime() * 1e6 / numberOfCycles);
+
+	printf("(checksum %llu)\n", checksum);
+
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// plays the recorded keys, keeping the layout, keys and eagle strikes of every game, and how it ended
+void recordReplay(vector<ReplayGame>& games, vector<GameState>& endings)
+{
+	GameState game;
+	seedGame(game, 256);
+
+	unsigned int keyCount(0);
+	unsigned int key(4);
+
+	while (key != 5)		// keep playing games
+	{
+		ReplayGame replay;
+		generateLayout(game, replay.layout);
+		setUpGame(game, replay.layout);
+		RecordingEagle eagle(replay.eagle);
+
+		key = keys[keyCount++];
+		while (!isGameOver(game) && key != 5)
+		{
+			replay.keys.push_back(keyCodes[key]);
+			stepGame(game, key, eagle);
+			key = keys[keyCount++];
+		}
+		if (key == 5)
+		{
+			replay.keys.push_back(keyCodes[5]);		// quit
+		}
+
+		games.push_back(replay);
+		endings.push_back(game);
+
+		if (key != 5)
+		{
+			key = keys[keyCount++];		// another go
+		}
+	}
+}
+
+// the same game, apart from the state of the random number generator
+bool sameGame(const GameState& a, const GameState& b)
+{
+	GameState c = b;
+	c.randomSeed = a.randomSeed;
+	return memcmp(&a, &c, sizeof(GameState)) == 0;
+}
+
+// End of the 'SNAIL TRAIL' listing
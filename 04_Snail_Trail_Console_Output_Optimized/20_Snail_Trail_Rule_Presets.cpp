@@ -0,0 +1,124 @@
+/*
+20_Snail_Trail_Rule_Presets
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version plays the game with other rules. Up to now the rules (SLIMELIFE, NUM_PELLETS, PELLET_THRESHOLD,
+LETTUCE_QUOTA, NUM_FROGS, FROGLEAP and EagleStrike) were constants copied into every version, so trying out other rules
+meant changing the code. In "SnailEngine.h" they are now a template parameter of the game, and "RulePresets.h" holds a
+number of sets of rules, each with the game code compiled for it.
+First the keys recorded for version 11 are played with the standard rules and with a copy of them that the game code
+is compiled for separately, to check that the rules as a template parameter play exactly the same games. Then the sets
+of rules named in presetNames are looked up by name, as a batch run would do with names from the command line, and
+NUM_GAMES games are played with each by a simple bot. How the games went and the time per frame are shown.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "RulePresets.h"     //for findRules, GameStats, etc.
+
+// the sets of rules to play, in this order (one of them does not exist)
+const char* presetNames[] = {"standard", "original", "easy", "hard", "marathon", "swarm", "crowded", "impossible"};
+const int NUM_NAMES(sizeof(presetNames) / sizeof(presetNames[0]));
+
+// number of games played with every set of rules, and the frames after which a game is stopped
+const int NUM_GAMES(20000);
+const int MAX_FRAMES(1000);
+
+// the seed of all games
+const unsigned int SEED(256);
+
+// the same rules as StandardRules, but a type of its own, so that the game code is compiled for it once more
+struct CopiedRules : StandardRules
+{
+};
+
+// read in keys from this array (recorded for version 11)
+const int NUM_KEYS(360);
+const unsigned int keys[NUM_KEYS] = {3,3,3,3,0,0,0,0,0,0,0,0,3,3,3,0,0,0,0,2,2,2,2,2,2,1,2,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,0,2,2,2,2,2,1,1,1,1,3,3,3,3,0,3,3,0,2,2,2,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,2,1,1,1,1,0,0,3,0,2,2,2,0,0,2,2,2,3,3,0,0,0,0,0,0,0,2,3,3,0,3,3,0,3,0,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,2,1,1,3,3,3,1,2,1,1,1,1,1,2,0,2,2,0,2,2,2,0,0,0,0,0,3,3,0,0,0,0,0,0,0,3,3,1,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,2,2,0,2,2,2,2,2,2,0,0,3,0,0,3,0,0,0,0,2,0,0,0,3,0,2,0,0,0,3,0,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,0,0,0,0,0,0,0,0,3,0,0,2,2,2,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,5,5};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	int compareRecording();
+
+	/**********************************************************************************************
+	Check the recorded games
+	***********************************************************************************************/
+
+	const int errors = compareRecording();
+	printf("recorded games: %d errors\n\n", errors);
+
+	/**********************************************************************************************
+	Play every set of rules
+	***********************************************************************************************/
+
+	printf("%-10s %5s %5s %5s %5s %5s %5s %5s %8s %8s %8s %8s %8s %10s\n", "rules", "slime", "pell.", "thr.", "lett.", "frogs", "leap", "eagle",
+		"won %", "pellet %", "frog %", "timeout", "frames", "ns/frame");
+
+	CStopWatch s;
+	for (int n = 0; n < NUM_NAMES; ++n)
+	{
+		const RulePreset* rules = findRules(presetNames[n]);
+		if (rules == 0)
+		{
+			printf("%-10s no rules with this name\n", presetNames[n]);
+			continue;
+		}
+
+		s.startTimer();
+		const GameStats stats = rules->playGames(SEED, NUM_GAMES, MAX_FRAMES);
+		s.stopTimer();
+
+		printf("%-10s %5d %5d %5d %5d %5d %5d %5d %8.1f %8.1f %8.1f %8d %8.1f %10.1f\n", rules->name, rules->slimeLife, rules->numPellets,
+			rules->pelletThreshold, rules->lettuceQuota, rules->numFrogs, rules->frogLeap, rules->eagleStrike,
+			stats.wins * 100.0 / stats.games, stats.pelletDeaths * 100.0 / stats.games, stats.frogDeaths * 100.0 / stats.games,
+			stats.timeouts, static_cast<double>(stats.frames) / stats.games, s.getElapsedTime() * 1e9 / stats.frames);
+	}
+
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// plays the recorded keys with StandardRules and CopiedRules side by side, returns the number of frames that differ
+int compareRecording()
+{
+	GameState game;
+	BasicGameState<CopiedRules> copy;
+	seedGame(game, 256);
+	seedGame(copy, 256);
+
+	int errors(0);
+	unsigned int keyCount(0);
+	unsigned int key(4);
+
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		initialiseGame(copy);
+		key = keys[keyCount++];
+		while (!isGameOver(game) && key != 5)
+		{
+			if (stepGame(game, key) != stepGame(copy, key) || memcmp(&game, &copy, sizeof(game)) != 0)
+			{
+				++errors;
+			}
+			key = keys[keyCount++];
+		}
+		if (key != 5)
+		{
+			key = keys[keyCount++];		// another go
+		}
+	}
+	return errors;
+}
+
+// End of the 'SNAIL TRAIL' listing
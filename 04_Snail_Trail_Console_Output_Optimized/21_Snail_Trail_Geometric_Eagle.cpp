@@ -0,0 +1,275 @@
+/*
+21_Snail_Trail_Geometric_Eagle
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version draws fewer random numbers for the eagle. Since version 00, every frog that moves asks for a random
+number to see whether the eagle gets it, a 1 in EagleStrike chance (eatenByEagle in version 00, inlined from version
+06 on). How many moves a frog survives is then geometrically distributed, so GeometricEagle (see "SnailEngine.h") draws
+that number once, when the frog is placed, and only counts it down while the frog moves.
+The number of moves frogs survive is sampled NUM_LIFETIMES times with both eagles and compared to the geometric
+distribution (and to each other) with a chi-square test, for the eagle of version 12 (1 in 32) and of versions 00 to 10
+(1 in 30). Only GeometricEagle has to pass: with 1 in 32, RandomEagle takes the lowest five bits of rand(), which repeat
+far too regularly for a frog that draws every number in a row, so it is RandomEagle that strays from the geometric
+distribution (in a game the frogs take turns drawing). Then NUM_GAMES games are played by the bot of "RulePresets.h"
+with both eagles, to compare how often the eagle strikes in a game, and the time per frame is measured with random keys
+for the standard rules and for the rules with most frogs.
+GeometricEagle is not faster. It draws two random numbers and takes a logarithm for every frog placed, to save one
+random number (a few instructions of the generator of version 12) for every move of the frog. The frames are timed in
+TIMED_ROUNDS rounds, the eagles in turns, and the best round of each counts: with the standard rules the two take the
+same time (between -1.1% and +1.6% over four runs, about 26 ns a frame). With SwarmRules, games with random keys
+last 3 frames, so its 12 frogs are placed again after about 3 moves each, and GeometricEagle takes 9% to 19% longer
+(e.g. 293 ns against 322 ns a frame; timing 10 million frames once with each, as this version first did, showed 318.5
+ns against 416.9 ns).
+So it is not the default for any rules, and would stay opt-in even where it won: RandomEagle draws the same random
+numbers as version 12, so that a seed and the recorded keys play the same games in every version, and GeometricEagle
+does not.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cmath>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, RandomEagle, GeometricEagle, etc.
+#include "RulePresets.h"     //for OriginalRules, SwarmRules, chooseBotKey, etc.
+
+// number of frog lives sampled for every eagle, and the longest life counted on its own (longer ones are counted together)
+const int NUM_LIFETIMES(2000000);
+const int MAX_LIFETIME(150);
+
+// chi-square values above the 99.9th percentile fail the test
+const double Z_999(3.090);
+
+// number of games played by the bot, stopped after MAX_FRAMES
+const int NUM_GAMES(20000);
+const int MAX_FRAMES(1000);
+
+// number of frames timed in a round, and the rounds timed with every eagle (in turns, the best round counts)
+const int TIMED_FRAMES(500000);
+const int TIMED_ROUNDS(21);
+
+// counts how often another eagle is asked whether it strikes
+template <class Eagle>
+struct CountingEagle
+{
+	Eagle eagle;
+	long long moves;
+	long long kills;
+
+	template <class State>
+	void onSpawn(State& state, int frog)
+	{
+		eagle.onSpawn(state, frog);
+	}
+
+	template <class State>
+	bool strikes(State& state, int frog)
+	{
+		const bool strike = eagle.strikes(state, frog);
+		++moves;
+		kills += strike;
+		return strike;
+	}
+};
+
+/***************************************************************************************
+Lifetimes
+****************************************************************************************/
+
+// the number of moves a frog survives with an eagle, counted in lifetimes[moves] up to MAX_LIFETIME
+template <class Rules, class Eagle>
+void sampleLifetimes(Eagle& eagle, unsigned int seed, long long lifetimes[MAX_LIFETIME + 1])
+{
+	BasicGameState<Rules> state;
+	seedGame(state, seed);
+
+	for (int i = 0; i < NUM_LIFETIMES; ++i)
+	{
+		eagle.onSpawn(state, 0);
+		int moves(1);
+		while (!eagle.strikes(state, 0))
+		{
+			++moves;
+		}
+		++lifetimes[moves < MAX_LIFETIME ? moves : MAX_LIFETIME];
+	}
+}
+
+// the chi-square value of the lifetimes compared to expected counts
+double chiSquare(const long long lifetimes[MAX_LIFETIME + 1], const double expected[MAX_LIFETIME + 1])
+{
+	double chi(0.0);
+	for (int moves = 1; moves <= MAX_LIFETIME; ++moves)
+	{
+		const double difference = lifetimes[moves] - expected[moves];
+		chi += difference * difference / expected[moves];
+	}
+	return chi;
+}
+
+// the chi-square value above which only 0.1% of all samples lie (Wilson-Hilferty)
+double criticalChiSquare(int degrees)
+{
+	const double a = 2.0 / (9.0 * degrees);
+	const double b = 1.0 - a + Z_999 * sqrt(a);
+	return degrees * b * b * b;
+}
+
+// compares the lifetimes of frogs with RandomEagle and GeometricEagle to the geometric distribution, returns 1 if
+// GeometricEagle fails the test
+template <class Rules>
+int compareLifetimes(const char* name)
+{
+	long long randomLifetimes[MAX_LIFETIME + 1] = {0};
+	long long geometricLifetimes[MAX_LIFETIME + 1] = {0};
+
+	RandomEagle randomEagle;
+	GeometricEagle<Rules> geometricEagle;
+	sampleLifetimes<Rules>(randomEagle, 256, randomLifetimes);
+	sampleLifetimes<Rules>(geometricEagle, 256, geometricLifetimes);
+
+	// a frog survives k moves with a chance of (1 - p)^(k-1) * p
+	const double p = 1.0 / Rules::EagleStrike;
+	double expected[MAX_LIFETIME + 1];
+	double survive(1.0);
+	for (int moves = 1; moves < MAX_LIFETIME; ++moves)
+	{
+		expected[moves] = NUM_LIFETIMES * survive * p;
+		survive *= 1.0 - p;
+	}
+	expected[MAX_LIFETIME] = NUM_LIFETIMES * survive;
+
+	// the two samples compared to each other, with the expected counts taken from both of them
+	double twoSamples(0.0);
+	double randomMean(0.0);
+	double geometricMean(0.0);
+	for (int moves = 1; moves <= MAX_LIFETIME; ++moves)
+	{
+		const double both = static_cast<double>(randomLifetimes[moves] + geometricLifetimes[moves]);
+		const double difference = randomLifetimes[moves] - geometricLifetimes[moves];
+		twoSamples += difference * difference / both;
+		randomMean += static_cast<double>(moves) * randomLifetimes[moves] / NUM_LIFETIMES;
+		geometricMean += static_cast<double>(moves) * geometricLifetimes[moves] / NUM_LIFETIMES;
+	}
+
+	const double randomChi = chiSquare(randomLifetimes, expected);
+	const double geometricChi = chiSquare(geometricLifetimes, expected);
+	const double critical = criticalChiSquare(MAX_LIFETIME - 1);
+	printf("%-10s %11.2f %11.2f %11.1f %11.1f %11.1f %11.1f\n", name, randomMean, geometricMean, randomChi, geometricChi, twoSamples, critical);
+
+	return geometricChi > critical;
+}
+
+/***************************************************************************************
+Games
+****************************************************************************************/
+
+// lets the bot play games with an eagle
+template <class Rules, class Eagle>
+void playBotGames(const char* name)
+{
+	CountingEagle<Eagle> eagle = CountingEagle<Eagle>();
+	BasicGameState<Rules> state;
+	seedGame(state, 256);
+	BotRandom random;
+	random.state = 257;
+
+	long long frames(0);
+	int wins(0);
+	for (int game = 0; game < NUM_GAMES; ++game)
+	{
+		initialiseGame(state, eagle);
+		for (int frame = 0; frame < MAX_FRAMES && !isGameOver(state); ++frame)
+		{
+			stepGame(state, chooseBotKey(state, random), eagle);
+			++frames;
+		}
+		wins += state.counters[3] == Rules::LETTUCE_QUOTA;
+	}
+
+	printf("%-10s %11.1f %11.3f %11.1f %11.1f\n", name, static_cast<double>(frames) / NUM_GAMES, eagle.kills * 1000.0 / eagle.moves,
+		1000.0 / Rules::EagleStrike, wins * 100.0 / NUM_GAMES);
+}
+
+// the time per frame with random keys, starting a new game whenever one is over
+template <class Rules, class Eagle>
+double timeFrames(unsigned long long& checksum)
+{
+	Eagle eagle;
+	BasicGameState<Rules> state;
+	seedGame(state, 256);
+	initialiseGame(state, eagle);
+	BotRandom random;
+	random.state = 257;
+
+	CStopWatch s;
+	s.startTimer();
+	for (int frame = 0; frame < TIMED_FRAMES; ++frame)
+	{
+		checksum += stepGame(state, random.next() % 5, eagle);
+		if (isGameOver(state))
+		{
+			initialiseGame(state, eagle);
+		}
+	}
+	s.stopTimer();
+	return s.getElapsedTime() * 1e9 / TIMED_FRAMES;
+}
+
+// times rounds of frames with both eagles in turns, and shows the best round of each
+template <class Rules>
+void compareTimes(const char* name, unsigned long long& checksum)
+{
+	double random(1e30);
+	double geometric(1e30);
+	for (int round = 0; round < TIMED_ROUNDS; ++round)
+	{
+		const double randomTime = timeFrames<Rules, RandomEagle>(checksum);
+		const double geometricTime = timeFrames<Rules, GeometricEagle<Rules> >(checksum);
+		random = randomTime < random ? randomTime : random;
+		geometric = geometricTime < geometric ? geometricTime : geometric;
+	}
+	printf("%-10s %8.2f ns %8.2f ns %10.1f%%\n", name, random, geometric, (geometric / random - 1.0) * 100.0);
+}
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	/**********************************************************************************************
+	Compare the lifetimes of frogs
+	***********************************************************************************************/
+
+	printf("%-10s %11s %11s %11s %11s %11s %11s\n", "rules", "mean random", "mean geom.", "chi random", "chi geom.", "chi both", "critical");
+	int failed(0);
+	failed += compareLifetimes<StandardRules>("standard");
+	failed += compareLifetimes<OriginalRules>("original");
+	printf("%d tests failed (%d moves, 99.9%%)\n\n", failed, MAX_LIFETIME - 1);
+
+	/**********************************************************************************************
+	Play games
+	***********************************************************************************************/
+
+	printf("%-10s %11s %11s %11s %11s\n", "eagle", "frames/game", "kills/1000", "expected", "won %");
+	playBotGames<StandardRules, RandomEagle>("random");
+	playBotGames<StandardRules, GeometricEagle<StandardRules> >("geometric");
+	printf("\n");
+
+	/**********************************************************************************************
+	Time the frames
+	***********************************************************************************************/
+
+	unsigned long long checksum(0);
+	printf("%-10s %11s %11s %11s\n", "rules", "random", "geometric", "change");
+	compareTimes<StandardRules>("standard", checksum);
+	compareTimes<SwarmRules>("swarm", checksum);
+	printf("(checksum %llu)\n", checksum);
+
+	return failed == 0 ? 0 : 1;
+} //end main
+
+// End of the 'SNAIL TRAIL' listing
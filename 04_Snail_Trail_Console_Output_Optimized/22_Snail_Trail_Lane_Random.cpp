@@ -0,0 +1,351 @@
+/*
+22_Snail_Trail_Lane_Random
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version plays games in batches of NUM_LANES, side by side, with random numbers for all of them drawn at once.
+The random number generator of the game code (rand() of version 12, gameRandom in "SnailEngine.h") gives one number
+per call, which has to be divided to get it into a range. With many games played at the same time, "LaneRandom.h"
+steps a generator for every game with the same few instructions (AVX2 if the compiler may use it, eight games per
+register, else SSE2, four games per register), and gets numbers into a range with a multiplication instead of a
+division (Lemire's method).
+Every game of a batch is set up from its lane (generateLaneLayouts), and in every iteration of the game loop the keys
+and the strikes of the eagle are drawn for all lanes at once. The random numbers of a game only depend on the seed, the
+batch and its lane, so the games are checked by playing each of them again on its own, drawing its numbers one at a
+time. The time to draw numbers and to play frames is compared to the random number generator of the game code.
+Drawing a number in lanes is only a little faster than gameRandom() % 28 (about a fifth with SSE2, the instructions
+of the project's build; drawing the lanes one at a time is slower), and a frame played in a batch takes two and a half
+to three times as long as one played on its own: a batch draws keys and strikes for all lanes until its longest game
+is over, and with random keys a few games go on for MAX_FRAMES while most are over within a hundred, so only about a
+fifth of the frames drawn for are played. Lanes are therefore not a speed-up for playing games: the game code and the
+batch runs (versions 36 and 37) keep drawing one number at a time, and lanes only pay off for games of about the same
+length, e.g. searches that play every game for a fixed number of frames.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "LaneRandom.h"      //for LaneRandom, boundedLanes, generateLaneLayouts, etc.
+
+// the seed of all batches
+const unsigned long long SEED(256);
+
+// number of batches played, a game is stopped after MAX_FRAMES
+const int NUM_BATCHES(20000);
+const int MAX_FRAMES(1000);
+
+// number of numbers drawn for the comparisons of the generators
+const int NUM_DRAWS(20000000);
+
+// ranges drawn from (the last one makes Lemire's method draw again for about a third of all numbers)
+const unsigned int ranges[] = {5, SIZEY - 2, SIZEX - 2, 30, 32, 3000000000u};
+const int NUM_RANGES(sizeof(ranges) / sizeof(ranges[0]));
+
+// random number generator for the keys of the games played one at a time
+struct KeyRandom
+{
+	unsigned int state;
+
+	unsigned int next()
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	int compareLanes();
+	void playBatch(unsigned int, GameState[NUM_LANES], long long&, long long&);
+	void playLane(unsigned int, int, GameState&);
+	double timeScalarFrames(long long);
+
+#if defined(__AVX2__)
+	printf("lanes drawn with AVX2\n");
+#elif defined(LANE_RANDOM_SSE2)
+	printf("lanes drawn with SSE2\n");
+#else
+	printf("lanes drawn one at a time\n");
+#endif
+
+	/**********************************************************************************************
+	Check the generators
+	***********************************************************************************************/
+
+	int errors = compareLanes();
+	printf("all lanes against one lane at a time: %d errors\n", errors);
+
+	/**********************************************************************************************
+	Play the batches and check them game by game
+	***********************************************************************************************/
+
+	vector<GameState> batchGames(NUM_BATCHES * NUM_LANES);
+	long long frames(0);
+	long long laneFrames(0);
+
+	CStopWatch s;
+	s.startTimer();
+	for (int batch = 0; batch < NUM_BATCHES; ++batch)
+	{
+		playBatch(batch, &batchGames[batch * NUM_LANES], frames, laneFrames);
+	}
+	s.stopTimer();
+	const double batchTime = s.getElapsedTime();
+
+	int gameErrors(0);
+	int wins(0);
+	GameState game;
+	for (int batch = 0; batch < NUM_BATCHES; ++batch)
+	{
+		for (int lane = 0; lane < NUM_LANES; ++lane)
+		{
+			playLane(batch, lane, game);
+			if (memcmp(&game, &batchGames[batch * NUM_LANES + lane], sizeof(GameState)) != 0)
+			{
+				++gameErrors;
+			}
+			wins += game.counters[3] == LETTUCE_QUOTA;
+		}
+	}
+	printf("%d games played in batches, %d won, %d differ when played on their own\n", NUM_BATCHES * NUM_LANES, wins, gameErrors);
+	errors += gameErrors;
+
+	/**********************************************************************************************
+	Time the generators
+	***********************************************************************************************/
+
+	unsigned long long checksum(0);
+	GameState randomGame;
+	seedGame(randomGame, 256);
+	LaneRandom random;
+	seedLanes(random, SEED, 0);
+	unsigned int numbers[NUM_LANES];
+	const LaneRange range = makeLaneRange(SIZEX - 2);
+
+	s.startTimer();
+	for (int i = 0; i < NUM_DRAWS; ++i)
+	{
+		checksum += gameRandom(randomGame) % (SIZEX - 2);
+	}
+	s.stopTimer();
+	printf("\ngameRandom() %% 28:        %6.2f ns per number\n", s.getElapsedTime() * 1e9 / NUM_DRAWS);
+
+	s.startTimer();
+	for (int i = 0; i < NUM_DRAWS / NUM_LANES; ++i)
+	{
+		boundedLanesPortable(random, range, numbers);
+		checksum += numbers[i % NUM_LANES];
+	}
+	s.stopTimer();
+	printf("boundedLanesPortable (28): %6.2f ns per number\n", s.getElapsedTime() * 1e9 / NUM_DRAWS);
+
+	s.startTimer();
+	for (int i = 0; i < NUM_DRAWS / NUM_LANES; ++i)
+	{
+		boundedLanes(random, range, numbers);
+		checksum += numbers[i % NUM_LANES];
+	}
+	s.stopTimer();
+	printf("boundedLanes (28):         %6.2f ns per number\n", s.getElapsedTime() * 1e9 / NUM_DRAWS);
+
+	/**********************************************************************************************
+	Time the frames
+	***********************************************************************************************/
+
+	const double scalarTime = timeScalarFrames(frames);
+	printf("\nin batches:    %6.1f ns per frame (%lld frames)\n", batchTime * 1e9 / frames, frames);
+	printf("one at a time: %6.1f ns per frame\n", scalarTime);
+	printf("batches take %.2f times as long per frame, %.0f%% of the frames drawn for were played\n",
+		batchTime * 1e9 / frames / scalarTime, frames * 100.0 / laneFrames);
+	printf("(checksum %llu)\n", checksum);
+
+	return errors == 0 ? 0 : 1;
+} //end main
+
+/***************************************************************************************
+Generators
+****************************************************************************************/
+
+// draws numbers for all lanes at once and one lane at a time, returns the number of numbers that differ
+int compareLanes()
+{
+	LaneRandom all;
+	LaneRandom single;
+	seedLanes(all, SEED, 1);
+	seedLanes(single, SEED, 1);
+
+	int errors(0);
+	unsigned int numbers[NUM_LANES];
+	for (int i = 0; i < NUM_DRAWS / NUM_LANES; ++i)
+	{
+		const int r = i % (NUM_RANGES + 1);
+		if (r == NUM_RANGES)
+		{
+			nextLanes(all, numbers);
+		}
+		else
+		{
+			boundedLanes(all, makeLaneRange(ranges[r]), numbers);
+		}
+
+		// the lanes in reverse, so that every lane is drawn on its own
+		for (int lane = NUM_LANES - 1; lane >= 0; --lane)
+		{
+			const unsigned int number = r == NUM_RANGES ? nextLane(single, lane) : boundedLane(single, lane, makeLaneRange(ranges[r]));
+			if (number != numbers[lane] || (r < NUM_RANGES && number >= ranges[r]))
+			{
+				++errors;
+			}
+		}
+	}
+	return errors;
+}
+
+/***************************************************************************************
+Games
+****************************************************************************************/
+
+// plays the games of a batch side by side with random keys, until all of them are over, adding the frames played and
+// the frames drawn for (in all lanes)
+void playBatch(unsigned int batch, GameState games[NUM_LANES], long long& frames, long long& laneFrames)
+{
+	static const LaneRange keyRange = makeLaneRange(5);
+
+	LaneRandom random;
+	seedLanes(random, SEED, batch);
+
+	GameLayout layouts[NUM_LANES];
+	LaneEagle<StandardRules> eagles[NUM_LANES];
+	generateLaneLayouts(random, layouts);
+	for (int lane = 0; lane < NUM_LANES; ++lane)
+	{
+		seedGame(games[lane], 0);		// not used
+		setUpGame(games[lane], layouts[lane], eagles[lane]);
+	}
+
+	unsigned int keys[NUM_LANES];
+	bool playing(true);
+	for (int frame = 0; frame < MAX_FRAMES && playing; ++frame)
+	{
+		boundedLanes(random, keyRange, keys);
+		drawLaneStrikes(random, eagles);
+		laneFrames += NUM_LANES;
+
+		playing = false;
+		for (int lane = 0; lane < NUM_LANES; ++lane)
+		{
+			if (!isGameOver(games[lane]))
+			{
+				stepGame(games[lane], keys[lane], eagles[lane]);
+				++frames;
+				playing = playing || !isGameOver(games[lane]);
+			}
+		}
+	}
+}
+
+// plays the game of one lane of a batch on its own, drawing only the numbers of that lane
+void playLane(unsigned int batch, int lane, GameState& game)
+{
+	//function prototypes
+	void drawPosition(LaneRandom&, int, const char[SIZEY][SIZEX], int[2]);
+
+	const LaneRange keyRange = makeLaneRange(5);
+	const LaneRange strikeRange = makeLaneRange(EagleStrike);
+
+	LaneRandom random;
+	seedLanes(random, SEED, batch);
+
+	// the layout, as generateLaneLayouts draws it
+	GameLayout layout;
+	char taken[SIZEY][SIZEX];
+	memset(taken, BLANK, sizeof(taken));
+	drawPosition(random, lane, taken, layout.snail);
+	taken[layout.snail[0]][layout.snail[1]] = SNAIL;
+	for (int slugP = 0; slugP < NUM_PELLETS; ++slugP)
+	{
+		drawPosition(random, lane, taken, layout.pellets[slugP]);
+		taken[layout.pellets[slugP][0]][layout.pellets[slugP][1]] = PELLET;
+	}
+	for (int lettuce = 0; lettuce < LETTUCE_QUOTA; ++lettuce)
+	{
+		drawPosition(random, lane, taken, layout.lettuces[lettuce]);
+		taken[layout.lettuces[lettuce][0]][layout.lettuces[lettuce][1]] = LETTUCE;
+	}
+	memset(taken, BLANK, sizeof(taken));
+	taken[layout.snail[0]][layout.snail[1]] = SNAIL;
+	for (int frog = 0; frog < NUM_FROGS; ++frog)
+	{
+		drawPosition(random, lane, taken, &layout.frogs[frog * 2]);
+		taken[layout.frogs[frog * 2]][layout.frogs[frog * 2 + 1]] = FROG;
+	}
+
+	LaneEagle<StandardRules> eagle;
+	seedGame(game, 0);
+	setUpGame(game, layout, eagle);
+
+	for (int frame = 0; frame < MAX_FRAMES && !isGameOver(game); ++frame)
+	{
+		const int key = static_cast<int>(boundedLane(random, lane, keyRange));
+		for (int frog = 0; frog < NUM_FROGS; ++frog)
+		{
+			eagle.hits[frog] = boundedLane(random, lane, strikeRange) == 0;
+		}
+		stepGame(game, key, eagle);
+	}
+}
+
+// draws a position for one lane, again until it is not taken
+void drawPosition(LaneRandom& random, int lane, const char taken[SIZEY][SIZEX], int position[2])
+{
+	const LaneRange rangeY = makeLaneRange(SIZEY - 2);
+	const LaneRange rangeX = makeLaneRange(SIZEX - 2);
+	do
+	{
+		position[0] = static_cast<int>(boundedLane(random, lane, rangeY)) + 1;
+		position[1] = static_cast<int>(boundedLane(random, lane, rangeX)) + 1;
+	}while(taken[position[0]][position[1]] != BLANK);
+}
+
+// the time per frame of games played one at a time with the random numbers of the game code, for the same number of frames
+double timeScalarFrames(long long frames)
+{
+	GameState game;
+	seedGame(game, 256);
+	initialiseGame(game);
+	KeyRandom random;
+	random.state = 257;
+
+	unsigned long long checksum(0);
+	CStopWatch s;
+	s.startTimer();
+	for (long long frame = 0; frame < frames; ++frame)
+	{
+		checksum += stepGame(game, random.next() % 5);
+		if (isGameOver(game))
+		{
+			initialiseGame(game);
+		}
+	}
+	s.stopTimer();
+	if (checksum == 0)
+	{
+		printf("(no events)\n");
+	}
+	return s.getElapsedTime() * 1e9 / frames;
+}
+
+// End of the 'SNAIL TRAIL' listing
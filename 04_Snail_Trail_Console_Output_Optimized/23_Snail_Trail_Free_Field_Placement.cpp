@@ -0,0 +1,173 @@
+/*
+23_Snail_Trail_Free_Field_Placement
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version places the pellets, lettuces and frogs on free fields straight away. Since version 00 (scatterStuff and
+scatterFrogs, unrolled into initialiseGame from version 09 on) positions are drawn again and again until a free one
+comes up. With 15 pellets that hardly ever happens, but the fuller the garden gets, the more tries every item takes, and
+there is no limit to the number of tries. Rules with PLACE_FROM_FREE_FIELDS (see "SnailEngine.h") draw every item from a
+list of the fields still free instead, which always takes two random numbers per item.
+For a number of pellet counts up to nearly the whole garden, layouts are drawn both ways and the time per layout is
+compared. Every layout drawn from the free fields is checked (everything inside the walls, snail, pellets and lettuces
+on different fields, frogs on different fields than the snail and each other), and how often every field gets a pellet
+is compared to an even spread with a chi-square test.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for BasicGameState, generateLayout, etc.
+
+// number of layouts drawn for every pellet count
+const int NUM_LAYOUTS(20000);
+
+// chi-square values above the 99.9th percentile fail the test
+const double Z_999(3.090);
+
+// the standard rules with another number of pellets, placed either way
+template <int Pellets, bool FreeFields>
+struct DensityRules : StandardRules
+{
+	static const int NUM_PELLETS = Pellets;
+	static const bool PLACE_FROM_FREE_FIELDS = FreeFields;
+};
+
+// checks a layout drawn from the free fields, returns the number of mistakes
+template <class Rules>
+int checkLayout(const BasicGameLayout<Rules>& layout)
+{
+	int mistakes(0);
+	char taken[SIZEY][SIZEX];
+	memset(taken, BLANK, sizeof(taken));
+
+	// snail, pellets and lettuces on different fields inside the walls
+	int positions[1 + Rules::NUM_PELLETS + Rules::LETTUCE_QUOTA][2];
+	positions[0][0] = layout.snail[0];
+	positions[0][1] = layout.snail[1];
+	memcpy(positions[1], layout.pellets, sizeof(layout.pellets));
+	memcpy(positions[1 + Rules::NUM_PELLETS], layout.lettuces, sizeof(layout.lettuces));
+	for (int i = 0; i < 1 + Rules::NUM_PELLETS + Rules::LETTUCE_QUOTA; ++i)
+	{
+		const int y = positions[i][0];
+		const int x = positions[i][1];
+		if (y < 1 || y > SIZEY - 2 || x < 1 || x > SIZEX - 2 || taken[y][x] != BLANK)
+		{
+			++mistakes;
+			continue;
+		}
+		taken[y][x] = PELLET;
+	}
+
+	// frogs on different fields than the snail and each other
+	memset(taken, BLANK, sizeof(taken));
+	taken[layout.snail[0]][layout.snail[1]] = SNAIL;
+	for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+	{
+		const int y = layout.frogs[frog * 2];
+		const int x = layout.frogs[frog * 2 + 1];
+		if (y < 1 || y > SIZEY - 2 || x < 1 || x > SIZEX - 2 || taken[y][x] != BLANK)
+		{
+			++mistakes;
+			continue;
+		}
+		taken[y][x] = FROG;
+	}
+	return mistakes;
+}
+
+// draws layouts with a number of pellets both ways, returns the number of mistakes and failed tests
+template <int Pellets>
+int compareLayouts(unsigned long long& checksum)
+{
+	typedef DensityRules<Pellets, false> RetryRules;
+	typedef DensityRules<Pellets, true> FreeRules;
+
+	BasicGameState<RetryRules> retryState;
+	BasicGameState<FreeRules> freeState;
+	seedGame(retryState, 256);
+	seedGame(freeState, 256);
+	BasicGameLayout<RetryRules> retryLayout;
+	BasicGameLayout<FreeRules> freeLayout;
+
+	CStopWatch s;
+	s.startTimer();
+	for (int i = 0; i < NUM_LAYOUTS; ++i)
+	{
+		generateLayout(retryState, retryLayout);
+		checksum += retryLayout.frogs[0];
+	}
+	s.stopTimer();
+	const double retryTime = s.getElapsedTime() * 1e9 / NUM_LAYOUTS;
+
+	s.startTimer();
+	for (int i = 0; i < NUM_LAYOUTS; ++i)
+	{
+		generateLayout(freeState, freeLayout);
+		checksum += freeLayout.frogs[0];
+	}
+	s.stopTimer();
+	const double freeTime = s.getElapsedTime() * 1e9 / NUM_LAYOUTS;
+
+	// check the layouts and count the pellets on every field
+	seedGame(freeState, 257);
+	int mistakes(0);
+	static long long pellets[SIZEY][SIZEX];
+	memset(pellets, 0, sizeof(pellets));
+	for (int i = 0; i < NUM_LAYOUTS; ++i)
+	{
+		generateLayout(freeState, freeLayout);
+		mistakes += checkLayout(freeLayout);
+		for (int slugP = 0; slugP < Pellets; ++slugP)
+		{
+			++pellets[freeLayout.pellets[slugP][0]][freeLayout.pellets[slugP][1]];
+		}
+	}
+
+	// a field gets a pellet in a layout with a chance of p, so the count of a field varies by NUM_LAYOUTS * p * (1 - p)
+	const double p = static_cast<double>(Pellets) / NUM_FIELDS;
+	const double expected = NUM_LAYOUTS * p;
+	double chi(0.0);
+	for (int y = 1; y < SIZEY - 1; ++y)
+	{
+		for (int x = 1; x < SIZEX - 1; ++x)
+		{
+			chi += (pellets[y][x] - expected) * (pellets[y][x] - expected) / (expected * (1.0 - p));
+		}
+	}
+	const int degrees = NUM_FIELDS - 1;
+	const double a = 2.0 / (9.0 * degrees);
+	const double critical = degrees * pow(1.0 - a + Z_999 * sqrt(a), 3.0);
+
+	printf("%7d %12.0f %12.0f %10.1f %10.1f %9d\n", Pellets, retryTime, freeTime, chi, critical, mistakes);
+	return mistakes + (chi > critical);
+}
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	printf("%7s %12s %12s %10s %10s %9s\n", "pellets", "retry ns", "free ns", "chi", "critical", "mistakes");
+
+	int failed(0);
+	unsigned long long checksum(0);
+	failed += compareLayouts<15>(checksum);
+	failed += compareLayouts<50>(checksum);
+	failed += compareLayouts<100>(checksum);
+	failed += compareLayouts<250>(checksum);
+	failed += compareLayouts<400>(checksum);
+	failed += compareLayouts<480>(checksum);
+	failed += compareLayouts<NUM_FIELDS - 1 - LETTUCE_QUOTA>(checksum);		// not a free field left
+
+	printf("%d mistakes and failed tests\n", failed);
+	printf("(checksum %llu)\n", checksum);
+	return failed == 0 ? 0 : 1;
+} //end main
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,149 @@
+/*
+24_Snail_Trail_Layout_Pool
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version starts new games without waiting for them to be set up. In every version so far, another game sets up the
+garden and scatters the snail, pellets, lettuces and frogs before it can start. For short games played one after the
+other (by a server or a batch job) that is a good part of the time. Here a LayoutPool (see "LayoutPool.h") sets up
+the games in advance on a thread of its own, and starting a game is copying one that is ready.
+First the games handed out by the pool are checked against games set up on the spot with the same seeds. Then
+NUM_RESTARTS games are started both ways, once back to back and once with a short game played in between (random keys
+until the game is over), and the time every start takes is measured. The mean, the median, the 99th percentile and
+the longest start are shown, with the number of games the pool had ready.
+The pool only pays off with a core to spare for its thread. On a single core the thread takes turns with the games:
+when restart wakes it up, it sets up games until the ring is full before the start that woke it returns, which shows
+in the 99th percentile, and the mean is no better than setting up every game on the spot.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>         //for sort
+#include <thread>            //for hardware_concurrency
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, initialiseGame, stepGame, etc.
+#include "LayoutPool.h"      //for LayoutPool
+
+// the seed of the first game
+const unsigned int SEED(256);
+
+// number of games kept ready
+const unsigned int POOL_CAPACITY(64);
+
+// number of games checked and started
+const int NUM_CHECKED(100000);
+const int NUM_RESTARTS(200000);
+
+// random number generator for the keys of the games played in between
+struct KeyRandom
+{
+	unsigned int state;
+
+	unsigned int next()
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	void timeRestarts(const char*, bool, bool);
+
+	/**********************************************************************************************
+	Check the games of the pool
+	***********************************************************************************************/
+
+	int errors(0);
+	{
+		LayoutPool pool(SEED, POOL_CAPACITY);
+		GameState pooled;
+		GameState game;
+		for (int n = 0; n < NUM_CHECKED; ++n)
+		{
+			const unsigned int seed = pool.restart(pooled);
+			seedGame(game, SEED + n);
+			initialiseGame(game);
+			if (seed != SEED + n || memcmp(&pooled, &game, sizeof(GameState)) != 0)
+			{
+				++errors;
+			}
+		}
+		printf("%d games checked, %d errors (%llu ready, %llu set up on the spot)\n\n", NUM_CHECKED, errors, pool.hits(), pool.misses());
+	}
+
+	/**********************************************************************************************
+	Time the restarts
+	***********************************************************************************************/
+
+	printf("%u cores\n", thread::hardware_concurrency());
+	printf("%-28s %10s %10s %10s %10s %10s\n", "", "mean ns", "median ns", "99% ns", "max ns", "ready %");
+	timeRestarts("on the spot, back to back", false, false);
+	timeRestarts("from the pool, back to back", true, false);
+	timeRestarts("on the spot, with games", false, true);
+	timeRestarts("from the pool, with games", true, true);
+
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// starts NUM_RESTARTS games, from a pool or set up on the spot, and shows how long the starts took
+void timeRestarts(const char* name, bool fromPool, bool playGames)
+{
+	LayoutPool* pool = fromPool ? new LayoutPool(SEED, POOL_CAPACITY) : 0;
+	vector<double> times(NUM_RESTARTS);
+	GameState game;
+	KeyRandom random;
+	random.state = 257;
+	unsigned long long checksum(0);
+	CStopWatch s;
+
+	for (int n = 0; n < NUM_RESTARTS; ++n)
+	{
+		s.startTimer();
+		if (fromPool)
+		{
+			pool->restart(game);
+		}
+		else
+		{
+			seedGame(game, SEED + n);
+			initialiseGame(game);
+		}
+		s.stopTimer();
+		times[n] = s.getElapsedTime() * 1e9;
+
+		if (playGames)
+		{
+			while (!isGameOver(game))
+			{
+				checksum += stepGame(game, random.next() % 5);
+			}
+		}
+		checksum += game.snail[0];
+	}
+
+	double total(0.0);
+	for (int n = 0; n < NUM_RESTARTS; ++n)
+	{
+		total += times[n];
+	}
+	sort(times.begin(), times.end());
+	const double ready = fromPool ? pool->hits() * 100.0 / NUM_RESTARTS : 0.0;
+	printf("%-28s %10.0f %10.0f %10.0f %10.0f %10.1f   (checksum %llu)\n", name, total / NUM_RESTARTS,
+		times[NUM_RESTARTS / 2], times[NUM_RESTARTS * 99 / 100], times[NUM_RESTARTS - 1], ready, checksum % 1000);
+	delete pool;
+}
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,242 @@
+/*
+25_Snail_Trail_Real_Time
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version runs the game in real time. Up to version 12 the game loop waits in getKeyPress for every frame, so the
+frogs and the slime only move when a key is pressed and the frame rate is the time it takes to handle a key. Here the
+loop runs on a TickClock (see "TickClock.h") at TICKS_PER_SECOND: every tick the keyboard is polled without waiting
+and the garden is painted. A key moves the snail, the slime and the frogs at once as before, but without a key the
+slime and the frogs move on their own every STEP_TICKS ticks, so the game goes on while the player thinks.
+How late every tick started (the jitter of the clock) and how long its work took are recorded, and shown with the
+number of overruns (ticks that were due before the tick before was done) when the game is quit.
+If the input is not a terminal the keys recorded for version 11 are played instead, one every REPLAY_TICKS ticks, so
+the jitter can be measured without a player. The keyboard is read with a TerminalInput (see "TerminalInput.h"), at
+most once a tick: all keys pressed since are read in one go and then handled one per tick.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>           //for memcpy
+#include <ctime>             //for time
+#include <vector>
+#include <algorithm>         //for sort
+#ifdef _WIN32
+#include <io.h>              //for _isatty
+#else
+#include <unistd.h>          //for isatty
+#endif
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, translateKey, etc.
+#include "TickClock.h"       //for TickClock, tickClockNow
+#include "TerminalInput.h"   //for TerminalInput
+#ifdef _WIN32
+#include "ConsoleUtils.h"    //for Clrscr, Gotoxy
+#endif
+
+// ticks per second, and the ticks after which the slime and the frogs move if no key was pressed
+const int TICKS_PER_SECOND(60);
+const int STEP_TICKS(30);
+
+// ticks between two recorded keys if the input is not a terminal
+const int REPLAY_TICKS(4);
+
+// most keys read in one go
+const int MAX_PENDING_KEYS(32);
+
+// all possible messages
+const char* messages[13] = {"READY TO SLITHER!? PRESS A KEY...",
+								"TOO MANY PELLETS SLITHERED OVER!",
+								"LAST LETTUCE EATEN",
+								"LETTUCE EATEN",
+								"TRY A DIFFERENT DIRECTION",
+								"THAT'S A WALL!",
+								"OOPS! ENCOUNTERED A FROG!",
+								"INVALID KEY",
+								"FROG GOT YOU!",
+								"EAGLE GOT A FROG",
+								"WELL DONE, YOU'VE SURVIVED",
+								"REST IN PEAS.",
+								""};
+
+// read in keys from this array (recorded for version 11) if the input is not a terminal
+const int NUM_KEYS(360);
+const unsigned int keys[NUM_KEYS] = {3,3,3,3,0,0,0,0,0,0,0,0,3,3,3,0,0,0,0,2,2,2,2,2,2,1,2,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,0,0,2,2,2,2,2,1,1,1,1,3,3,3,3,0,3,3,0,2,2,2,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,2,1,1,1,1,0,0,3,0,2,2,2,0,0,2,2,2,3,3,0,0,0,0,0,0,0,2,3,3,0,3,3,0,3,0,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,2,1,1,3,3,3,1,2,1,1,1,1,1,2,0,2,2,0,2,2,2,0,0,0,0,0,3,3,0,0,0,0,0,0,0,3,3,1,1,1,1,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,2,2,0,2,2,2,2,2,2,0,0,3,0,0,3,0,0,0,0,2,0,0,0,3,0,2,0,0,0,3,0,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,0,0,0,0,0,0,0,0,3,0,0,2,2,2,0,0,0,2,2,2,2,0,0,0,0,0,0,0,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,5,5};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	bool isTerminal(FILE*);
+	void paintFrame(const GameState&, long long);
+	void showTimes(const char*, vector<long long>&);
+
+	TerminalInput input;
+	const bool interactive = input.isTerminal();
+	const bool painting = isTerminal(stdout);
+
+	GameState game;
+	seedGame(game, interactive ? static_cast<unsigned int>(time(0)) : 256);
+	initialiseGame(game);
+	game.counters[0] = 0;
+
+	vector<long long> lateness;		// how late every tick started
+	vector<long long> work;			// how long the work of every tick took
+	int keyCount(0);
+	int pendingKeys[MAX_PENDING_KEYS];	// keys read, but not handled yet
+	int numberOfPending(0);
+	int nextPending(0);
+	int idleTicks(0);				// ticks since the snail, the slime and the frogs last moved
+	bool started(false);			// whether the first key of the game has been pressed
+
+#ifdef _WIN32
+	if (painting)
+	{
+		Clrscr();
+	}
+#else
+	if (painting)
+	{
+		fputs("\033[2J", stdout);
+	}
+#endif
+
+	TickClock clock(TICKS_PER_SECOND);
+	int key(4);
+	while (key != 5)		// keep playing games
+	{
+		lateness.push_back(clock.waitForTick());
+		const long long start = tickClockNow();
+
+		/**********************************************************************************************
+		Poll the input
+		***********************************************************************************************/
+
+		key = -1;
+		if (interactive)
+		{
+			if (nextPending == numberOfPending)
+			{
+				numberOfPending = input.readKeys(pendingKeys, MAX_PENDING_KEYS);
+				nextPending = 0;
+			}
+			if (nextPending < numberOfPending)
+			{
+				key = pendingKeys[nextPending++];
+			}
+		}
+		else if (lateness.size() % REPLAY_TICKS == 0)
+		{
+			key = keys[keyCount++];
+		}
+
+		/**********************************************************************************************
+		Run the game
+		***********************************************************************************************/
+
+		if (key == 5)
+		{
+			break;
+		}
+		if (isGameOver(game))
+		{
+			if (key >= 0)		// another go
+			{
+				initialiseGame(game);
+				game.counters[0] = 0;
+				started = false;
+			}
+		}
+		else if (key >= 0)
+		{
+			stepGame(game, key);
+			started = true;
+			idleTicks = 0;
+		}
+		else if (started && ++idleTicks == STEP_TICKS)
+		{
+			// the slime and the frogs move on their own, without the message for a key that is not an arrow key
+			stepGame(game, 4);
+			if (game.counters[0] == 7)
+			{
+				game.counters[0] = 12;
+			}
+			idleTicks = 0;
+		}
+
+		if (painting)
+		{
+			paintFrame(game, lateness.back());
+		}
+		work.push_back(tickClockNow() - start);
+	}
+
+	/**********************************************************************************************
+	Show the times
+	***********************************************************************************************/
+
+	printf("\n%lld ticks at %d per second, %lld overruns, %lld ticks skipped\n", static_cast<long long>(lateness.size()),
+		TICKS_PER_SECOND, clock.overruns(), clock.skipped());
+	printf("%-12s %10s %10s %10s %10s\n", "", "mean us", "median us", "99% us", "max us");
+	showTimes("lateness", lateness);
+	showTimes("work", work);
+
+	return 0;
+} //end main
+
+bool isTerminal(FILE* file)
+{
+#ifdef _WIN32
+	return _isatty(_fileno(file)) != 0;
+#else
+	return isatty(fileno(file)) != 0;
+#endif
+}
+
+// paints the garden and the game info in one write, over the frame before
+void paintFrame(const GameState& game, long long lateness)
+{
+	const int LINE(SIZEX + 40);
+	char frame[(SIZEY + 4) * (LINE + 1) + 1];
+	int length(0);
+
+	for (int y = 0; y < SIZEY; ++y)
+	{
+		memcpy(frame + length, game.garden[y], SIZEX);
+		length += SIZEX;
+		frame[length++] = '\n';
+	}
+	length += sprintf(frame + length, "\nPELLETS EATEN: %d  LETTUCES EATEN: %d  TICK LATE: %6.1f us\n%-*s\n",
+		game.counters[2], game.counters[3], lateness / 1000.0, LINE, messages[game.counters[0]]);
+
+#ifdef _WIN32
+	Gotoxy(0, 0);
+#else
+	fputs("\033[H", stdout);
+#endif
+	fwrite(frame, 1, length, stdout);
+	fflush(stdout);
+}
+
+// shows the mean, median, 99th percentile and longest of a number of times in nanoseconds
+void showTimes(const char* name, vector<long long>& times)
+{
+	if (times.empty())
+	{
+		return;
+	}
+	sort(times.begin(), times.end());
+	double sum(0.0);
+	for (size_t i = 0; i < times.size(); ++i)
+	{
+		sum += times[i];
+	}
+	printf("%-12s %10.1f %10.1f %10.1f %10.1f\n", name, sum / times.size() / 1000.0, times[times.size() / 2] / 1000.0,
+		times[times.size() * 99 / 100] / 1000.0, times.back() / 1000.0);
+}
+
+// End of the 'SNAIL TRAIL' listing
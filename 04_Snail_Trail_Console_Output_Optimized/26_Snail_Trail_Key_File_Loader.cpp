@@ -0,0 +1,191 @@
+/*
+26_Snail_Trail_Key_File_Loader
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version loads recorded keys from files again, but all at once. Versions 02 to 10 read "Keys.txt" a character at
+a time while the game runs, which was so slow (and so much part of the time measured) that version 11 copied the keys
+into the code instead. Here a whole file is mapped into memory and parsed with SSE2 (see "KeyFile.h") into an array
+of keys, one byte per key, so any recorded file can be played without the reading being part of the game.
+First "Keys.txt" is loaded and compared to the keys read from it the way version 02 does. Then a file of NUM_CORPUS_KEYS
+random key codes (with a line break now and then) is written to "CorpusKeys.txt", parsed both ways, and checked against
+the keys written. Last the file is loaded REPEATS times the way of version 02 and with both parsers of "KeyFile.h", and
+the best time is shown in MB per second and ns per key. The file is deleted at the end.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <fstream>           //for files
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for translateKey
+#include "KeyFile.h"         //for MappedFile, parseKeys, loadKeyFile, etc.
+
+// number of key codes in the file written for timing
+const int NUM_CORPUS_KEYS(16000000);
+
+// number of times every way of loading is timed
+const int REPEATS(3);
+
+// the key codes recorded in "Keys.txt"
+const int recordedCodes[7] = {LEFT, RIGHT, UP, DOWN, 100, 102, 113};
+
+// random number generator for the corpus
+struct KeyRandom
+{
+	unsigned int state;
+
+	unsigned int next()
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	void loadLikeVersion02(const char*, vector<unsigned char>&);
+	size_t loadScalar(const char*, vector<unsigned char>&);
+
+	int errors(0);
+
+	/**********************************************************************************************
+	Check "Keys.txt"
+	***********************************************************************************************/
+
+	vector<unsigned char> expected;
+	vector<unsigned char> keys;
+	loadLikeVersion02("Keys.txt", expected);
+	if (!loadKeyFile("Keys.txt", keys))
+	{
+		printf("Keys.txt could not be opened\n");
+		return 1;
+	}
+	errors += keys != expected;
+	printf("Keys.txt: %d keys, %s\n", static_cast<int>(keys.size()), keys == expected ? "same as version 02" : "DIFFERENT");
+
+	/**********************************************************************************************
+	Write and check the corpus
+	***********************************************************************************************/
+
+	KeyRandom random;
+	random.state = 256;
+	expected.resize(NUM_CORPUS_KEYS);
+	{
+		string text;
+		text.reserve(NUM_CORPUS_KEYS * 4);
+		char code[8];
+		for (int i = 0; i < NUM_CORPUS_KEYS; ++i)
+		{
+			const unsigned int r = random.next();
+			const int command = recordedCodes[r % 7];
+			expected[i] = static_cast<unsigned char>(translateKey(command));
+			sprintf(code, "%d", command);
+			text += code;
+			text += (r >> 16) % 64 == 0 ? "\r\n" : ",";
+		}
+		ofstream outKeys("CorpusKeys.txt", ios::binary);
+		outKeys.write(text.data(), text.size());
+	}
+
+	loadKeyFile("CorpusKeys.txt", keys);
+	errors += keys != expected;
+	vector<unsigned char> scalarKeys;
+	loadScalar("CorpusKeys.txt", scalarKeys);
+	errors += scalarKeys != expected;
+	printf("CorpusKeys.txt: %d keys, SSE2 %s, scalar %s\n\n", static_cast<int>(keys.size()), keys == expected ? "right" : "WRONG",
+		scalarKeys == expected ? "right" : "WRONG");
+
+	/**********************************************************************************************
+	Time the loading
+	***********************************************************************************************/
+
+	const double megabytes = MappedFile("CorpusKeys.txt").size() / 1e6;
+	double best[3] = {1e9, 1e9, 1e9};
+	CStopWatch s;
+	for (int repeat = 0; repeat < REPEATS; ++repeat)
+	{
+		s.startTimer();
+		loadLikeVersion02("CorpusKeys.txt", keys);
+		s.stopTimer();
+		best[0] = s.getElapsedTime() < best[0] ? s.getElapsedTime() : best[0];
+
+		s.startTimer();
+		loadScalar("CorpusKeys.txt", keys);
+		s.stopTimer();
+		best[1] = s.getElapsedTime() < best[1] ? s.getElapsedTime() : best[1];
+
+		s.startTimer();
+		loadKeyFile("CorpusKeys.txt", keys);
+		s.stopTimer();
+		best[2] = s.getElapsedTime() < best[2] ? s.getElapsedTime() : best[2];
+	}
+
+	const char* names[3] = {"ifstream (version 02)", "mapped, scalar", "mapped, SSE2"};
+	printf("%-24s %10s %10s\n", "", "MB/s", "ns/key");
+	for (int way = 0; way < 3; ++way)
+	{
+		printf("%-24s %10.1f %10.2f\n", names[way], megabytes / best[way], best[way] * 1e9 / NUM_CORPUS_KEYS);
+	}
+
+	remove("CorpusKeys.txt");
+	printf("\n%d errors\n", errors);
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// reads all keys of a file the way getKeyPress of version 02 does (until the stream is no longer good)
+void loadLikeVersion02(const char* name, vector<unsigned char>& keys)
+{
+	ifstream inKeys(name);
+	keys.clear();
+	while (inKeys.good())
+	{
+		int command;
+
+		// read keys from file
+		ostringstream oss;
+
+		bool doStop = false;
+		while(inKeys.good() && !doStop)
+		{
+			char ch = inKeys.get();
+			if(ch != ',')
+			{
+				oss << ch;
+			}else
+			{
+				doStop = true;
+			}
+		}
+
+		if(inKeys.good())
+		{
+			istringstream iss(oss.str());
+			iss >> command;
+			keys.push_back(static_cast<unsigned char>(translateKey(command)));
+		}
+	}
+}
+
+// loads all keys of a file like loadKeyFile, but with the scalar parser
+size_t loadScalar(const char* name, vector<unsigned char>& keys)
+{
+	MappedFile file(name);
+	keys.resize(maxKeyCount(file.size()));
+	keys.resize(parseKeysScalar(file.data(), file.size(), &keys[0]));
+	return keys.size();
+}
+
+// End of the 'SNAIL TRAIL' listing
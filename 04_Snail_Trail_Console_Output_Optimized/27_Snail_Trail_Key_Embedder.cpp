@@ -0,0 +1,142 @@
+/*
+27_Snail_Trail_Key_Embedder
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version turns recorded key files into code. Version 11 had the keys of one recorded game copied into the code by
+hand, so that the benchmark does not read a file while it runs, and versions 15 to 20 copied them again. Here every
+file named in recordingFiles is loaded (see "KeyFile.h") and written to "EmbeddedKeys.h" as an array of keys, one byte
+per key, with a list of all of them by name. A benchmark includes "EmbeddedKeys.h" and looks up the keys it wants to
+play with findEmbeddedKeys, without any input at run time and without anything copied by hand.
+Files that do not exist are left out (with a note), e.g. "WorkloadKeys.txt" if version 18 has not been run; if none
+of them exist, nothing is written and "EmbeddedKeys.h" is left as it was.
+"EmbeddedKeys.h" is not made by the build: most of the recordings are made by other versions and are not kept with
+the code, so a build would leave them out. Whenever a recording changes, run by hand, in the project folder:
+	version 14 for "MonteCarloKeys.txt" and version 18 for "WorkloadKeys.txt" (if they are to change),
+	then version 27, and check in the "EmbeddedKeys.h" it writes ("EmbeddedKeys.h" names the files it was made from).
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+//include our own libraries
+#include "KeyFile.h"         //for loadKeyFile
+
+// the recordings to embed, by name, and the files they are read from
+const char* recordingFiles[][2] = {{"keys", "Keys.txt"},
+									{"newkeys", "NewKeys.txt"},
+									{"workload", "WorkloadKeys.txt"},
+									{"montecarlo", "MonteCarloKeys.txt"},
+									{"fuzz", "FuzzKeys.txt"}};
+const int NUM_RECORDING_FILES(sizeof(recordingFiles) / sizeof(recordingFiles[0]));
+
+// number of keys written on one line of an array
+const int KEYS_PER_LINE(40);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	/**********************************************************************************************
+	Load the recordings
+	***********************************************************************************************/
+
+	vector<vector<unsigned char> > keys(NUM_RECORDING_FILES);
+	vector<bool> embedded(NUM_RECORDING_FILES);
+	int numberEmbedded(0);
+	for (int recording = 0; recording < NUM_RECORDING_FILES; ++recording)
+	{
+		embedded[recording] = loadKeyFile(recordingFiles[recording][1], keys[recording]);
+		if (embedded[recording])
+		{
+			printf("%-12s %-20s %6d keys\n", recordingFiles[recording][0], recordingFiles[recording][1],
+				static_cast<int>(keys[recording].size()));
+			++numberEmbedded;
+		}
+		else
+		{
+			printf("%-12s %-20s not found, left out\n", recordingFiles[recording][0], recordingFiles[recording][1]);
+		}
+	}
+	if (numberEmbedded == 0)		// no list of size 0
+	{
+		printf("no recordings found, EmbeddedKeys.h is left as it was\n");
+		return 1;
+	}
+
+	FILE* header = fopen("EmbeddedKeys.h", "w");
+	if (header == 0)
+	{
+		printf("EmbeddedKeys.h could not be written\n");
+		return 1;
+	}
+
+	fprintf(header, "/* Recorded keys built into the code, made by 27_Snail_Trail_Key_Embedder from the files named below "
+		"(run it\nagain instead of changing this file). It is not run by the build, see version 27 for when and how to "
+		"run it.\n\n");
+	fprintf(header, "Use the following procedures/functions for the following results:\n\n");
+	fprintf(header, "findEmbeddedKeys(name) to look up a recording by name, returns 0 if there is none with that name\n");
+	fprintf(header, "embeddedRecordings, NUM_EMBEDDED_RECORDINGS for the list of all recordings\n\n");
+	fprintf(header, "Every recording holds the keys from 0 to 5 (see translateKey in \"SnailEngine.h\"), one byte per key, "
+		"in the order\nthey were recorded.\n*/\n\n");
+	fprintf(header, "#ifndef EMBEDDED_KEYS_H\n#define EMBEDDED_KEYS_H\n\n");
+	fprintf(header, "#include <cstring>           //for strcmp\n\n");
+	fprintf(header, "struct EmbeddedRecording\n{\n\tconst char* name;\n\tconst char* file;\t\t\t// the file it was made from\n"
+		"\tconst unsigned char* keys;\n\tint numberOfKeys;\n};\n\n");
+
+	/**********************************************************************************************
+	Write the keys of every recording
+	***********************************************************************************************/
+
+	for (int recording = 0; recording < NUM_RECORDING_FILES; ++recording)
+	{
+		if (keys[recording].empty())
+		{
+			continue;		// left out, or no array of size 0
+		}
+
+		fprintf(header, "// \"%s\"\nconst unsigned char %sKeys[%d] = {", recordingFiles[recording][1], recordingFiles[recording][0],
+			static_cast<int>(keys[recording].size()));
+		for (size_t i = 0; i < keys[recording].size(); ++i)
+		{
+			fprintf(header, "%s%s%d", i == 0 ? "" : ",", i % KEYS_PER_LINE == 0 ? "\n\t" : "", keys[recording][i]);
+		}
+		fprintf(header, "};\n\n");
+	}
+
+	/**********************************************************************************************
+	Write the list of recordings
+	***********************************************************************************************/
+
+	fprintf(header, "const EmbeddedRecording embeddedRecordings[] = {\n");
+	bool first(true);
+	for (int recording = 0; recording < NUM_RECORDING_FILES; ++recording)
+	{
+		if (embedded[recording])
+		{
+			fprintf(header, "%s\t{\"%s\", \"%s\", ", first ? "" : ",\n", recordingFiles[recording][0], recordingFiles[recording][1]);
+			if (!keys[recording].empty())
+			{
+				fprintf(header, "%sKeys, %d}", recordingFiles[recording][0], static_cast<int>(keys[recording].size()));
+			}
+			else
+			{
+				fprintf(header, "0, 0}");
+			}
+			first = false;
+		}
+	}
+	fprintf(header, "\n};\n\n");
+	fprintf(header, "const int NUM_EMBEDDED_RECORDINGS(sizeof(embeddedRecordings) / sizeof(embeddedRecordings[0]));\n\n");
+	fprintf(header, "inline const EmbeddedRecording* findEmbeddedKeys(const char* name)\n{\n"
+		"\tfor (int i = 0; i < NUM_EMBEDDED_RECORDINGS; ++i)\n\t{\n\t\tif (strcmp(embeddedRecordings[i].name, name) == 0)\n"
+		"\t\t{\n\t\t\treturn &embeddedRecordings[i];\n\t\t}\n\t}\n\treturn 0;\n}\n\n#endif\n");
+
+	fclose(header);
+	return 0;
+} //end main
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,121 @@
+/*
+28_Snail_Trail_Embedded_Replay
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version replays recordings that are built into the code. The keys come from "EmbeddedKeys.h", which version 27
+makes from the recorded key files, and are looked up by name as a benchmark would with a name from the command line.
+Nothing is read at run time except to check that the recordings are still up to date: if the file a recording was made
+from is still there, it is loaded (see "KeyFile.h") and compared with the embedded keys before anything is timed.
+Every recording named in recordingNames is then played REPEATS times like version 11 plays its keys (seeded with 256,
+the first key of a game is its first move, the key after a game is over starts another one unless it is 'q', and the
+recording ends with 'q' or with its last key), and the best time per frame is shown.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>           //for memcmp
+#include <vector>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "KeyFile.h"         //for loadKeyFile
+#include "EmbeddedKeys.h"    //for findEmbeddedKeys
+
+// the recordings to play, in this order (one of them has not been embedded)
+const char* recordingNames[] = {"keys", "workload", "montecarlo", "newkeys", "version11"};
+const int NUM_NAMES(sizeof(recordingNames) / sizeof(recordingNames[0]));
+
+// number of times every recording is played
+const int REPEATS(200);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	int playRecording(const EmbeddedRecording&, unsigned long long&);
+
+	/**********************************************************************************************
+	Check the recordings against their files
+	***********************************************************************************************/
+
+	int stale(0);
+	for (int i = 0; i < NUM_EMBEDDED_RECORDINGS; ++i)
+	{
+		const EmbeddedRecording& recording = embeddedRecordings[i];
+		vector<unsigned char> keys;
+		if (!loadKeyFile(recording.file, keys))
+		{
+			printf("%-12s %-20s file not found, not checked\n", recording.name, recording.file);
+			continue;
+		}
+		const bool same = static_cast<int>(keys.size()) == recording.numberOfKeys &&
+			(keys.empty() || memcmp(&keys[0], recording.keys, keys.size()) == 0);
+		stale += !same;
+		printf("%-12s %-20s %s\n", recording.name, recording.file, same ? "up to date" : "CHANGED, run version 27 again");
+	}
+	printf("\n");
+
+	/**********************************************************************************************
+	Play the recordings
+	***********************************************************************************************/
+
+	printf("%-12s %8s %8s %10s\n", "recording", "keys", "frames", "ns/frame");
+	CStopWatch s;
+	unsigned long long checksum(0);
+	for (int n = 0; n < NUM_NAMES; ++n)
+	{
+		const EmbeddedRecording* recording = findEmbeddedKeys(recordingNames[n]);
+		if (recording == 0)
+		{
+			printf("%-12s no recording with this name\n", recordingNames[n]);
+			continue;
+		}
+
+		int frames(0);
+		double best(1e9);
+		for (int repeat = 0; repeat < REPEATS; ++repeat)
+		{
+			s.startTimer();
+			frames = playRecording(*recording, checksum);
+			s.stopTimer();
+			best = s.getElapsedTime() < best ? s.getElapsedTime() : best;
+		}
+		printf("%-12s %8d %8d %10.1f\n", recording->name, recording->numberOfKeys, frames, frames > 0 ? best * 1e9 / frames : 0.0);
+	}
+	printf("(checksum %llu)\n", checksum % 1000);
+
+	return stale == 0 ? 0 : 1;
+} //end main
+
+// plays all games of a recording, returns the number of frames played
+int playRecording(const EmbeddedRecording& recording, unsigned long long& checksum)
+{
+	GameState game;
+	seedGame(game, 256);
+
+	int frames(0);
+	int keyCount(0);
+	int key(4);
+
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+		while (!isGameOver(game) && key != 5)
+		{
+			checksum += stepGame(game, key);
+			++frames;
+			key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+		}
+		// another go, also after 'q' (as in version 12)
+		key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+	}
+	return frames;
+}
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,305 @@
+/*
+29_Snail_Trail_Pty_Render_Benchmark
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version measures how fast the game can be painted on a terminal. Versions 04 to 12 measured the output on whatever
+console they were started in, so the numbers changed with the console, its size and its font, and could not be taken
+at all on a machine without one. Here a pseudo terminal is opened (openpty), a thread of its own reads everything
+written to it as fast as it can (as a terminal would), and the three renderers of "TerminalRender.h" paint the games
+of the "workload" recording (see "EmbeddedKeys.h") on it: the whole garden every frame, the fields in the change queue,
+and the fields that differ from the frame before. Every frame is written with one call of write.
+First every renderer is checked: its output is played on a simple screen that only knows the cursor moves of
+"TerminalRender.h", which has to show the same as a full repaint after every frame. Then the recording is painted
+REPEATS times by every renderer, and the bytes and write calls per frame and the frames per second are shown.
+Pseudo terminals are a POSIX feature, so on Windows this version only says so.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>
+#ifndef _WIN32
+#include <atomic>            //for atomic
+#include <thread>            //for thread
+#include <termios.h>         //for cfmakeraw
+#include <unistd.h>          //for read, write, close
+#ifdef __APPLE__
+#include <util.h>            //for openpty
+#else
+#include <pty.h>             //for openpty (link with -lutil)
+#endif
+#endif
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "TerminalRender.h"  //for renderFull, ChangeQueueRenderer, DiffRenderer
+#include "EmbeddedKeys.h"    //for findEmbeddedKeys
+
+// the recording played
+const char* const RECORDING("workload");
+
+// number of times the recording is painted by every renderer
+const int REPEATS(20);
+
+// size of the simple screen, the garden and the game info
+const int SCREEN_ROWS(SIZEY + 3);
+const int SCREEN_COLUMNS(SIZEX + MESSAGE_WIDTH);
+
+// the ways of painting
+enum RenderWay
+{
+	RENDER_FULL,
+	RENDER_CHANGE_QUEUE,
+	RENDER_DIFF
+};
+const int NUM_RENDER_WAYS(3);
+const char* renderNames[NUM_RENDER_WAYS] = {"full repaint", "change queue", "diff"};
+
+// a screen that plays the output of the renderers
+struct Screen
+{
+	char cells[SCREEN_ROWS][SCREEN_COLUMNS];
+	int row;
+	int column;
+
+	void clear()
+	{
+		memset(cells, ' ', sizeof(cells));
+		row = 0;
+		column = 0;
+	}
+
+	void play(const char* bytes, int length)
+	{
+		for (int i = 0; i < length; ++i)
+		{
+			if (bytes[i] == '\033')		// ESC [ row ; column H
+			{
+				int numbers[2] = {0, 0};
+				int number(0);
+				for (i += 2; bytes[i] != 'H'; ++i)
+				{
+					if (bytes[i] == ';')
+					{
+						number = 1;
+					}
+					else
+					{
+						numbers[number] = numbers[number] * 10 + (bytes[i] - '0');
+					}
+				}
+				row = numbers[0] - 1;
+				column = numbers[1] - 1;
+			}
+			else if (row >= 0 && row < SCREEN_ROWS && column >= 0 && column < SCREEN_COLUMNS)
+			{
+				cells[row][column++] = bytes[i];
+			}
+		}
+	}
+};
+
+// the painting of a recording
+struct RenderStats
+{
+	long long frames;
+	long long bytes;
+	long long writes;
+	double seconds;
+};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+#ifdef _WIN32
+	printf("no pseudo terminals on this system\n");
+	return 0;
+#else
+	//function prototypes
+	int checkRenderer(const EmbeddedRecording&, RenderWay);
+	RenderStats paintRecording(const EmbeddedRecording&, RenderWay, int);
+
+	const EmbeddedRecording* recording = findEmbeddedKeys(RECORDING);
+	if (recording == 0)
+	{
+		printf("no recording named %s, run version 27 first\n", RECORDING);
+		return 1;
+	}
+
+	/**********************************************************************************************
+	Check the renderers
+	***********************************************************************************************/
+
+	int errors(0);
+	for (int way = 0; way < NUM_RENDER_WAYS; ++way)
+	{
+		const int wrong = checkRenderer(*recording, static_cast<RenderWay>(way));
+		printf("%-14s %d frames painted wrong\n", renderNames[way], wrong);
+		errors += wrong;
+	}
+	printf("\n");
+
+	/**********************************************************************************************
+	Paint on a pseudo terminal
+	***********************************************************************************************/
+
+	int master(-1);
+	int slave(-1);
+	if (openpty(&master, &slave, 0, 0, 0) != 0)
+	{
+		printf("no pseudo terminal could be opened\n");
+		return 1;
+	}
+	termios raw;
+	tcgetattr(slave, &raw);
+	cfmakeraw(&raw);		// no changes to the bytes written
+	tcsetattr(slave, TCSANOW, &raw);
+
+	// the terminal: read everything until the other side is closed
+	atomic<long long> bytesRead(0);
+	thread terminal([master, &bytesRead]()
+	{
+		char bytes[65536];
+		ssize_t length;
+		while ((length = read(master, bytes, sizeof(bytes))) > 0)
+		{
+			bytesRead += length;
+		}
+	});
+
+	printf("%-14s %10s %10s %12s\n", "", "bytes/fr.", "writes/fr.", "frames/s");
+	for (int way = 0; way < NUM_RENDER_WAYS; ++way)
+	{
+		const RenderStats stats = paintRecording(*recording, static_cast<RenderWay>(way), slave);
+		printf("%-14s %10.1f %10.3f %12.0f\n", renderNames[way], static_cast<double>(stats.bytes) / stats.frames,
+			static_cast<double>(stats.writes) / stats.frames, stats.frames / stats.seconds);
+	}
+
+	close(slave);
+	terminal.join();
+	close(master);
+	printf("(%lld bytes read by the terminal)\n\n%d errors\n", bytesRead.load(), errors);
+	return errors == 0 ? 0 : 1;
+#endif
+} //end main
+
+#ifndef _WIN32
+
+// plays a recording like version 11 and lets a renderer paint every frame into buffer, calling paint(game, length)
+// for it
+template <class Paint>
+void renderRecording(const EmbeddedRecording& recording, RenderWay way, char* buffer, Paint paint)
+{
+	GameState game;
+	seedGame(game, 256);
+	ChangeQueueRenderer<StandardRules> changeQueue;
+	DiffRenderer diff;
+
+	int keyCount(0);
+	int key(4);
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		switch (way)
+		{
+		case RENDER_FULL:
+			paint(game, renderFull(game, buffer));
+			break;
+		case RENDER_CHANGE_QUEUE:
+			paint(game, changeQueue.renderNewGame(game, buffer));
+			break;
+		case RENDER_DIFF:
+			paint(game, diff.render(game, buffer));
+			break;
+		}
+
+		key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+		while (!isGameOver(game) && key != 5)
+		{
+			switch (way)
+			{
+			case RENDER_FULL:
+				stepGame(game, key);
+				paint(game, renderFull(game, buffer));
+				break;
+			case RENDER_CHANGE_QUEUE:
+				changeQueue.step(game, key);
+				paint(game, changeQueue.render(game, buffer));
+				break;
+			case RENDER_DIFF:
+				stepGame(game, key);
+				paint(game, diff.render(game, buffer));
+				break;
+			}
+			key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+		}
+		// another go, also after 'q' (as in version 12)
+		key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+	}
+}
+
+// plays the output of a renderer on a Screen and compares it with a full repaint of the garden, returns the frames
+// that differ
+int checkRenderer(const EmbeddedRecording& recording, RenderWay way)
+{
+	static char buffer[MAX_FRAME_BYTES];
+	static char expectedBuffer[MAX_FRAME_BYTES];
+	Screen screen;
+	Screen expected;
+	screen.clear();
+	int wrong(0);
+
+	renderRecording(recording, way, buffer, [&](const GameState& game, int length)
+	{
+		screen.play(buffer, length);
+		expected.clear();
+		expected.play(expectedBuffer, renderFull(game, expectedBuffer));
+		bool same = memcmp(screen.cells, expected.cells, sizeof(screen.cells)) == 0;
+		for (int y = 0; y < SIZEY; ++y)
+		{
+			same = same && memcmp(screen.cells[y], game.garden[y], SIZEX) == 0;
+		}
+		wrong += !same;
+	});
+	return wrong;
+}
+
+// paints a recording REPEATS times on a terminal, with one write per frame
+RenderStats paintRecording(const EmbeddedRecording& recording, RenderWay way, int terminal)
+{
+	static char buffer[MAX_FRAME_BYTES];
+	RenderStats stats = {0, 0, 0, 0.0};
+
+	CStopWatch s;
+	s.startTimer();
+	for (int repeat = 0; repeat < REPEATS; ++repeat)
+	{
+		renderRecording(recording, way, buffer, [&](const GameState&, int length)
+		{
+			int written(0);
+			while (written < length)
+			{
+				const ssize_t result = write(terminal, buffer + written, length - written);
+				++stats.writes;
+				if (result <= 0)
+				{
+					break;
+				}
+				written += static_cast<int>(result);
+			}
+			stats.bytes += length;
+			++stats.frames;
+		});
+	}
+	s.stopTimer();
+	stats.seconds = s.getElapsedTime();
+	return stats;
+}
+
+#endif
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,281 @@
+/*
+30_Snail_Trail_Input_Latency
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version measures the time from a key to the frame it changes being on the screen. The frame times of versions 02
+to 11 start after getKeyPress has returned and stop before the next key is read, so they leave out reading the key and
+the last bit of the output, which are what a player notices. Here the game runs in real time like version 25, painted
+with a DiffRenderer (see "TerminalRender.h"), and for every key three times are taken: when the read that got it
+returned, when the game loop has run for it, and when the write of its frame has returned. The times between them are
+collected in LatencyHistograms (see "LatencyHistogram.h") and shown when the game is quit. Keys that arrive together
+are handled one per tick, so the time a key waits for its tick counts as well.
+If the input is not a terminal, the keys of the "workload" recording (see "EmbeddedKeys.h") are typed into a pseudo
+terminal by a thread of its own, one every KEY_INTERVAL_MS milliseconds, followed by 'q'. The game reads them from
+the pseudo terminal and paints on it, another thread reads what is painted. The time a key is typed is taken as well,
+so the latency includes the way through the terminal. Pseudo terminals are a POSIX feature, so on Windows only the
+keyboard can be measured.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>
+#include <atomic>            //for atomic
+#include <thread>            //for thread
+#ifdef _WIN32
+#include <windows.h>         //for SetConsoleMode
+#else
+#include <unistd.h>          //for read, write, close
+#ifdef __APPLE__
+#include <util.h>            //for openpty
+#else
+#include <pty.h>             //for openpty (link with -lutil)
+#endif
+#endif
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "TickClock.h"       //for TickClock, tickClockNow
+#include "TerminalInput.h"   //for TerminalInput
+#include "TerminalRender.h"  //for DiffRenderer
+#include "LatencyHistogram.h"//for LatencyHistogram, showHistogram
+#include "EmbeddedKeys.h"    //for findEmbeddedKeys
+
+// ticks per second, and the ticks after which the slime and the frogs move if no key was pressed
+const int TICKS_PER_SECOND(60);
+const int STEP_TICKS(30);
+
+// most keys read in one go
+const int MAX_PENDING_KEYS(32);
+
+// the recording typed if the input is not a terminal, how many of its keys and how fast
+const char* const RECORDING("workload");
+const int NUM_TYPED_KEYS(300);
+const int KEY_INTERVAL_MS(20);
+
+// the latencies of the keys
+struct KeyLatencies
+{
+	LatencyHistogram typed;			// from typing the key to reading it (only for typed keys)
+	LatencyHistogram simulated;		// from reading the key to the end of its iteration of the game loop
+	LatencyHistogram painted;		// from there to the end of the write of the frame
+	LatencyHistogram total;			// from typing or reading the key to the end of the write of the frame
+};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	void playGame(TerminalInput&, int, const atomic<long long>*, KeyLatencies&);
+
+	KeyLatencies latencies;
+	bool typed(false);
+	{
+		TerminalInput keyboard;
+		if (keyboard.isTerminal())
+		{
+#ifdef _WIN32
+			// let the console understand the cursor moves of the renderer
+			HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+			DWORD mode(0);
+			GetConsoleMode(console, &mode);
+			SetConsoleMode(console, mode | 0x0004);		// ENABLE_VIRTUAL_TERMINAL_PROCESSING
+			playGame(keyboard, 1, 0, latencies);
+#else
+			playGame(keyboard, STDOUT_FILENO, 0, latencies);
+#endif
+		}
+		else
+		{
+#ifdef _WIN32
+			printf("the input is not a terminal, and there are no pseudo terminals on this system\n");
+			return 1;
+#else
+			/**********************************************************************************************
+			Type the recorded keys into a pseudo terminal
+			***********************************************************************************************/
+
+			const EmbeddedRecording* recording = findEmbeddedKeys(RECORDING);
+			int master(-1);
+			int slave(-1);
+			if (recording == 0 || openpty(&master, &slave, 0, 0, 0) != 0)
+			{
+				printf("no recording named %s or no pseudo terminal\n", RECORDING);
+				return 1;
+			}
+			const int numberOfKeys = recording->numberOfKeys < NUM_TYPED_KEYS ? recording->numberOfKeys : NUM_TYPED_KEYS;
+			atomic<long long>* typeTimes = new atomic<long long>[numberOfKeys + 1];
+			TerminalInput terminal(slave);
+
+			thread typist([&]()
+			{
+				const char* sequences[6] = {"\033[D", "\033[C", "\033[A", "\033[B", "x", "q"};
+				TickClock clock(1000 / KEY_INTERVAL_MS);
+				for (int i = 0; i <= numberOfKeys; ++i)
+				{
+					clock.waitForTick();
+					const char* sequence = i < numberOfKeys ? sequences[recording->keys[i]] : "q";
+					typeTimes[i] = tickClockNow();
+					if (write(master, sequence, strlen(sequence)) < 0)
+					{
+						break;
+					}
+				}
+			});
+			thread screen([master]()
+			{
+				char bytes[65536];
+				while (read(master, bytes, sizeof(bytes)) > 0)
+				{
+				}
+			});
+
+			playGame(terminal, slave, typeTimes, latencies);
+			typist.join();
+			close(slave);
+			screen.join();
+			close(master);
+			delete[] typeTimes;
+			typed = true;
+#endif
+		}
+	}		// the terminal is restored here
+
+	/**********************************************************************************************
+	Show the latencies
+	***********************************************************************************************/
+
+	printf("\n");
+	if (typed)
+	{
+		showHistogram("typed to read", latencies.typed);
+	}
+	showHistogram("read to simulated", latencies.simulated);
+	showHistogram("simulated to painted", latencies.painted);
+	showHistogram(typed ? "typed to painted" : "read to painted", latencies.total);
+	return 0;
+} //end main
+
+// writes all of a frame
+void writeFrame(int out, const char* bytes, int length)
+{
+#ifdef _WIN32
+	fwrite(bytes, 1, length, out == 1 ? stdout : stderr);
+	fflush(out == 1 ? stdout : stderr);
+#else
+	int written(0);
+	while (written < length)
+	{
+		const ssize_t result = write(out, bytes + written, length - written);
+		if (result <= 0)
+		{
+			return;
+		}
+		written += static_cast<int>(result);
+	}
+#endif
+}
+
+// plays in real time, with keys from input and frames written to out, until 'q' is pressed; typeTimes holds the time
+// every key was typed (0 if the keys come from a player)
+void playGame(TerminalInput& input, int out, const atomic<long long>* typeTimes, KeyLatencies& latencies)
+{
+	static char buffer[MAX_FRAME_BYTES];
+	GameState game;
+	seedGame(game, 256);
+	initialiseGame(game);
+	game.counters[0] = 0;
+	DiffRenderer renderer;
+	writeFrame(out, "\033[2J", 4);
+	writeFrame(out, buffer, renderer.render(game, buffer));
+
+	int pendingKeys[MAX_PENDING_KEYS];	// keys read, but not handled yet
+	long long readTime(0);				// when they were read
+	int numberOfPending(0);
+	int nextPending(0);
+	int keysHandled(0);
+	int idleTicks(0);
+	bool started(false);
+
+	TickClock clock(TICKS_PER_SECOND);
+	int key(4);
+	while (key != 5)		// keep playing games
+	{
+		clock.waitForTick();
+
+		/**********************************************************************************************
+		Poll the input
+		***********************************************************************************************/
+
+		key = -1;
+		if (nextPending == numberOfPending)
+		{
+			numberOfPending = input.readKeys(pendingKeys, MAX_PENDING_KEYS);
+			readTime = tickClockNow();
+			nextPending = 0;
+		}
+		if (nextPending < numberOfPending)
+		{
+			key = pendingKeys[nextPending++];
+		}
+
+		/**********************************************************************************************
+		Run the game
+		***********************************************************************************************/
+
+		if (key == 5)
+		{
+			break;
+		}
+		if (isGameOver(game))
+		{
+			if (key >= 0)		// another go
+			{
+				initialiseGame(game);
+				game.counters[0] = 0;
+				started = false;
+			}
+		}
+		else if (key >= 0)
+		{
+			stepGame(game, key);
+			started = true;
+			idleTicks = 0;
+		}
+		else if (started && ++idleTicks == STEP_TICKS)
+		{
+			stepGame(game, 4);
+			if (game.counters[0] == 7)
+			{
+				game.counters[0] = 12;
+			}
+			idleTicks = 0;
+		}
+		const long long simulated = tickClockNow();
+
+		/**********************************************************************************************
+		Paint the frame
+		***********************************************************************************************/
+
+		writeFrame(out, buffer, renderer.render(game, buffer));
+		const long long painted = tickClockNow();
+
+		if (key >= 0)
+		{
+			const long long arrived = typeTimes != 0 ? typeTimes[keysHandled].load() : readTime;
+			if (typeTimes != 0)
+			{
+				latencies.typed.add(readTime - arrived);
+			}
+			latencies.simulated.add(simulated - readTime);
+			latencies.painted.add(painted - simulated);
+			latencies.total.add(painted - arrived);
+			++keysHandled;
+		}
+	}
+}
+
+// End of the 'SNAIL TRAIL' listing
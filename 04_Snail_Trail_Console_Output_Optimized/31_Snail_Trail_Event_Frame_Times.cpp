@@ -0,0 +1,109 @@
+/*
+31_Snail_Trail_Event_Frame_Times
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version shows which events make a frame slow. Version 01 wrote the events of every frame to "Data.txt" and
+versions 02 to 12 the time of every frame to "Framerates.txt", but the two were never put together, so a slow frame
+could not be told from a fast one by what happened in it. Here the recordings named in recordingNames (see
+"EmbeddedKeys.h") are played REPEATS times each, and every frame is timed from the key to the end of its output: the
+iteration of the game loop, painting it with a DiffRenderer (see "TerminalRender.h") and the bells of version 12 (one
+for a warning, four for a death knell, seven for a win), written with one call of write to a pseudo terminal that a
+thread of its own reads (see "FrameSamples.h"). The events the frame returned are kept with its time.
+The times of all frames, and of the frames in which each event happened, are collected in LatencyHistograms (see
+"LatencyHistogram.h") and shown side by side, with their mean compared to the mean of all frames. Every frame is also
+written to "FrameEvents.txt", one line per frame with the recording, the frame, its time in nanoseconds and its
+events, as a baseline to compare later builds with.
+Pseudo terminals are a POSIX feature, so on Windows the frames are only painted into the buffer and not written.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for eventNames, etc.
+#include "FrameSamples.h"    //for TerminalSink, timeRecording, writeFrameEvents
+#include "LatencyHistogram.h"//for LatencyHistogram
+#include "EmbeddedKeys.h"    //for findEmbeddedKeys
+
+// the recordings played
+const char* const recordingNames[] = {"keys", "workload", "montecarlo"};
+const int NUM_NAMES(sizeof(recordingNames) / sizeof(recordingNames[0]));
+
+// number of times every recording is played
+const int REPEATS(20);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	void showEventTimes(const vector<FrameSample>&);
+
+	/**********************************************************************************************
+	Play the recordings
+	***********************************************************************************************/
+
+	vector<FrameSample> samples;
+	{
+		TerminalSink sink;
+		for (int n = 0; n < NUM_NAMES; ++n)
+		{
+			const EmbeddedRecording* recording = findEmbeddedKeys(recordingNames[n]);
+			if (recording == 0)
+			{
+				printf("%-12s no recording with this name\n", recordingNames[n]);
+				continue;
+			}
+			vector<FrameSample> warmUp;
+			timeRecording(*recording, n, sink.terminal(), warmUp);
+			for (int repeat = 0; repeat < REPEATS; ++repeat)
+			{
+				timeRecording(*recording, n, sink.terminal(), samples);
+			}
+		}
+	}		// the pseudo terminal is closed here
+
+	showEventTimes(samples);
+	writeFrameEvents("FrameEvents.txt", recordingNames, samples);
+	return 0;
+} //end main
+
+// shows the times of all frames, and of the frames in which each event happened
+void showEventTimes(const vector<FrameSample>& samples)
+{
+	static LatencyHistogram all;
+	static LatencyHistogram byEvent[NUM_EVENTS];
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		all.add(samples[i].nanoseconds);
+		for (int event = 0; event < NUM_EVENTS; ++event)
+		{
+			if ((samples[i].events >> event) & 1)
+			{
+				byEvent[event].add(samples[i].nanoseconds);
+			}
+		}
+	}
+
+	printf("%-18s %8s %9s %9s %9s %9s %7s\n", "frames with", "frames", "mean us", "50% us", "99% us", "max us", "x all");
+	printf("%-18s %8lld %9.2f %9.2f %9.2f %9.2f %7.2f\n", "(all)", all.count, all.mean() / 1000.0,
+		all.percentile(50.0) / 1000.0, all.percentile(99.0) / 1000.0, all.max / 1000.0, 1.0);
+	for (int event = 0; event < NUM_EVENTS; ++event)
+	{
+		const LatencyHistogram& histogram = byEvent[event];
+		if (histogram.count == 0)
+		{
+			printf("%-18s %8d\n", eventNames[event], 0);
+			continue;
+		}
+		printf("%-18s %8lld %9.2f %9.2f %9.2f %9.2f %7.2f\n", eventNames[event], histogram.count,
+			histogram.mean() / 1000.0, histogram.percentile(50.0) / 1000.0, histogram.percentile(99.0) / 1000.0,
+			histogram.max / 1000.0, histogram.mean() / all.mean());
+	}
+}
+
+// End of the 'SNAIL TRAIL' listing
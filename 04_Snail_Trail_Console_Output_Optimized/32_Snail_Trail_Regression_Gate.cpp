@@ -0,0 +1,312 @@
+/*
+32_Snail_Trail_Regression_Gate
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version decides whether a build has become slower, so that a slow build can be stopped before it is used. Up to
+version 12 two builds were compared by looking at the numbers in their "Framerates.txt", which differ from run to run
+anyway. Here the frames of the recordings named in recordingNames are timed as version 31 times them (see
+"FrameSamples.h"), and compared with the frames of a baseline: the "FrameEvents.txt" written by version 31 (or by this
+version if there is none), or else a "Framerates.txt" of versions 02 to 12.
+The frames are compared in zones: all frames, the frames of each recording and the frames in which each event happened.
+In every zone a Mann-Whitney U test checks whether the frames of this build tend to take longer than those of the
+baseline, which needs no assumption about how the times are distributed (they are not normally distributed, most
+frames are fast and a few are very slow). With tens of thousands of frames even a tiny difference is significant, so a
+zone only counts as slower if the difference is large enough as well: a frame of this build has to take longer than one
+of the baseline with a probability of at least MIN_SUPERIORITY (a small effect after Vargha and Delaney), and the
+median frame has to be at least MIN_SLOWDOWN slower.
+The zones that got slower are listed, and the program ends with 1 if there are any (0 otherwise), so that a build
+script can stop on it.
+A "Framerates.txt" of versions 02 to 04 holds the time of every frame index summed over LEGACY_CYCLES runs, which
+gives one zone of all frames; those of versions 05 to 12 only hold the total time and the number of frames, so only
+the mean can be compared, without a test. Either way the legacy frames were timed for another workload (other keys,
+painted to a Windows console or not painted at all), so they are only shown next to this build and never stop it:
+the program ends with 0 and writes the frames of this build to "FrameEvents.txt", the baseline of the next run.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cmath>             //for sqrt
+#include <cstdio>
+#include <cstdlib>           //for atof
+#include <algorithm>         //for sort
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for eventNames, etc.
+#include "FrameSamples.h"    //for TerminalSink, timeRecording, readFrameEvents, writeFrameEvents
+#include "EmbeddedKeys.h"    //for findEmbeddedKeys
+
+// the recordings played
+const char* const recordingNames[] = {"keys", "workload", "montecarlo"};
+const int NUM_NAMES(sizeof(recordingNames) / sizeof(recordingNames[0]));
+
+// number of times every recording is played
+const int REPEATS(20);
+
+// the baselines, and the number of runs summed up in a per frame "Framerates.txt"
+const char* const BASELINE_FILE("FrameEvents.txt");
+const char* const LEGACY_FILE("Framerates.txt");
+const int LEGACY_CYCLES(100);
+
+// z of the one-sided test at a significance level of 0.1%, the least effect and slowdown of the median that count,
+// and the least frames in a zone to test it
+const double Z_CRITICAL(3.09);
+const double MIN_SUPERIORITY(0.56);
+const double MIN_SLOWDOWN(0.10);
+const int MIN_ZONE_FRAMES(20);
+
+// zones: all frames, the frames of each recording, the frames with each event
+const int NUM_ZONES(1 + NUM_NAMES + NUM_EVENTS);
+
+// the result of comparing a zone
+struct ZoneComparison
+{
+	double baselineMedian;		// in nanoseconds
+	double currentMedian;
+	double superiority;			// how likely a frame of this build takes longer than one of the baseline
+	double z;
+	bool slower;
+};
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	bool readLegacyFramerates(const char*, vector<FrameSample>&, double&);
+	const char* zoneName(int);
+	void zoneTimes(const vector<FrameSample>&, int, vector<long long>&);
+	ZoneComparison compareZone(vector<long long>&, vector<long long>&);
+
+	/**********************************************************************************************
+	Time this build
+	***********************************************************************************************/
+
+	vector<FrameSample> current;
+	{
+		TerminalSink sink;
+		for (int n = 0; n < NUM_NAMES; ++n)
+		{
+			const EmbeddedRecording* recording = findEmbeddedKeys(recordingNames[n]);
+			if (recording == 0)
+			{
+				printf("%-12s no recording with this name\n", recordingNames[n]);
+				continue;
+			}
+			vector<FrameSample> warmUp;
+			timeRecording(*recording, n, sink.terminal(), warmUp);
+			for (int repeat = 0; repeat < REPEATS; ++repeat)
+			{
+				timeRecording(*recording, n, sink.terminal(), current);
+			}
+		}
+	}		// the pseudo terminal is closed here
+
+	/**********************************************************************************************
+	Load the baseline
+	***********************************************************************************************/
+
+	vector<FrameSample> baseline;
+	double legacyMean(0.0);
+	bool legacy(false);
+	if (readFrameEvents(BASELINE_FILE, recordingNames, NUM_NAMES, baseline))
+	{
+		printf("baseline: %s, %d frames\n\n", BASELINE_FILE, static_cast<int>(baseline.size()));
+	}
+	else if (readLegacyFramerates(LEGACY_FILE, baseline, legacyMean))
+	{
+		legacy = true;
+		printf("baseline: %s (legacy, all frames only, another workload: shown only)\n\n", LEGACY_FILE);
+	}
+	else
+	{
+		writeFrameEvents(BASELINE_FILE, recordingNames, current);
+		printf("no baseline found, %d frames of this build written to %s as the baseline\n",
+			static_cast<int>(current.size()), BASELINE_FILE);
+		return 0;
+	}
+
+	/**********************************************************************************************
+	Compare the zones
+	***********************************************************************************************/
+
+	vector<long long> currentTimes;
+	vector<long long> baselineTimes;
+	if (baseline.empty())		// only the mean of the baseline is known
+	{
+		zoneTimes(current, 0, currentTimes);
+		double mean(0.0);
+		for (size_t i = 0; i < currentTimes.size(); ++i)
+		{
+			mean += currentTimes[i];
+		}
+		mean /= currentTimes.empty() ? 1 : currentTimes.size();
+		printf("mean frame: baseline %.3f us, this build %.3f us (x %.2f)\n", legacyMean / 1000.0, mean / 1000.0,
+			mean / legacyMean);
+	}
+	else
+	{
+		printf("%-18s %8s %8s %10s %10s %7s %6s %8s\n", "zone", "base n", "build n", "base 50%", "build 50%", "x base",
+			"P(>)", "z");
+	}
+
+	string slowerZones;
+	for (int zone = 0; zone < NUM_ZONES && !baseline.empty(); ++zone)
+	{
+		zoneTimes(baseline, zone, baselineTimes);
+		zoneTimes(current, zone, currentTimes);
+		if (static_cast<int>(baselineTimes.size()) < MIN_ZONE_FRAMES || static_cast<int>(currentTimes.size()) < MIN_ZONE_FRAMES)
+		{
+			printf("%-18s %8d %8d (too few frames)\n", zoneName(zone), static_cast<int>(baselineTimes.size()),
+				static_cast<int>(currentTimes.size()));
+			continue;
+		}
+		const ZoneComparison result = compareZone(baselineTimes, currentTimes);
+		printf("%-18s %8d %8d %10.3f %10.3f %7.2f %6.3f %8.2f%s\n", zoneName(zone), static_cast<int>(baselineTimes.size()),
+			static_cast<int>(currentTimes.size()), result.baselineMedian / 1000.0, result.currentMedian / 1000.0,
+			result.currentMedian / result.baselineMedian, result.superiority, result.z, result.slower ? "  SLOWER" : "");
+		if (result.slower)
+		{
+			slowerZones += slowerZones.empty() ? "" : ", ";
+			slowerZones += zoneName(zone);
+		}
+	}
+
+	if (legacy)
+	{
+		writeFrameEvents(BASELINE_FILE, recordingNames, current);
+		printf("\nno comparable baseline, %d frames of this build written to %s as the baseline\n",
+			static_cast<int>(current.size()), BASELINE_FILE);
+		return 0;
+	}
+	if (slowerZones.empty())
+	{
+		printf("\nno zone got slower\n");
+		return 0;
+	}
+	printf("\nSLOWER: %s\n", slowerZones.c_str());
+	return 1;
+} //end main
+
+const char* zoneName(int zone)
+{
+	if (zone == 0)
+	{
+		return "(all)";
+	}
+	return zone <= NUM_NAMES ? recordingNames[zone - 1] : eventNames[zone - 1 - NUM_NAMES];
+}
+
+// the times of the frames in a zone
+void zoneTimes(const vector<FrameSample>& samples, int zone, vector<long long>& times)
+{
+	times.clear();
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		const FrameSample& sample = samples[i];
+		if (zone == 0 || (zone <= NUM_NAMES ? sample.recording == zone - 1 : ((sample.events >> (zone - 1 - NUM_NAMES)) & 1) != 0))
+		{
+			times.push_back(sample.nanoseconds);
+		}
+	}
+}
+
+// the median of sorted times
+double median(const vector<long long>& times)
+{
+	const size_t middle = times.size() / 2;
+	return times.size() % 2 != 0 ? times[middle] : (times[middle - 1] + times[middle]) / 2.0;
+}
+
+// compares the times of a zone with a one-sided Mann-Whitney U test (normal approximation with tie correction)
+ZoneComparison compareZone(vector<long long>& baselineTimes, vector<long long>& currentTimes)
+{
+	sort(baselineTimes.begin(), baselineTimes.end());
+	sort(currentTimes.begin(), currentTimes.end());
+	const double n1 = static_cast<double>(baselineTimes.size());
+	const double n2 = static_cast<double>(currentTimes.size());
+
+	// rank both sorted lists together, ties get the mean of their ranks
+	double currentRanks(0.0);
+	double ties(0.0);		// sum of t^3 - t over groups of t equal times
+	size_t b(0);
+	size_t c(0);
+	double rank(1.0);
+	while (b < baselineTimes.size() || c < currentTimes.size())
+	{
+		const long long value = c == currentTimes.size() || (b < baselineTimes.size() && baselineTimes[b] < currentTimes[c]) ?
+			baselineTimes[b] : currentTimes[c];
+		double inBaseline(0.0);
+		double inCurrent(0.0);
+		for (; b < baselineTimes.size() && baselineTimes[b] == value; ++b)
+		{
+			++inBaseline;
+		}
+		for (; c < currentTimes.size() && currentTimes[c] == value; ++c)
+		{
+			++inCurrent;
+		}
+		const double count = inBaseline + inCurrent;
+		currentRanks += inCurrent * (rank + (count - 1.0) / 2.0);
+		ties += count * count * count - count;
+		rank += count;
+	}
+
+	const double n = n1 + n2;
+	const double u = currentRanks - n2 * (n2 + 1.0) / 2.0;
+	const double variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+
+	ZoneComparison result;
+	result.baselineMedian = median(baselineTimes);
+	result.currentMedian = median(currentTimes);
+	result.superiority = u / (n1 * n2);
+	result.z = variance > 0.0 ? (u - n1 * n2 / 2.0 - 0.5) / sqrt(variance) : 0.0;
+	result.slower = result.z > Z_CRITICAL && result.superiority >= MIN_SUPERIORITY && result.currentMedian >= result.baselineMedian * (1.0 + MIN_SLOWDOWN);
+	return result;
+}
+
+// reads a "Framerates.txt" of versions 02 to 12, either as the frames of one run (versions 02 to 04, which write the
+// seconds of every frame index summed over LEGACY_CYCLES runs, separated by commas) or as the mean frame only (versions
+// 05 to 12, which write the total seconds and the number of frames)
+bool readLegacyFramerates(const char* name, vector<FrameSample>& samples, double& mean)
+{
+	ifstream inFramerates(name);
+	string text((istreambuf_iterator<char>(inFramerates)), istreambuf_iterator<char>());
+	if (text.empty())
+	{
+		return false;
+	}
+
+	if (text.find(',') != string::npos)
+	{
+		size_t start(0);
+		for (int frame = 0; start < text.size(); ++frame)
+		{
+			size_t end = text.find(',', start);
+			end = end == string::npos ? text.size() : end;
+			const double seconds = atof(text.substr(start, end - start).c_str());
+			if (seconds > 0.0)
+			{
+				const FrameSample sample = {-1, frame, static_cast<long long>(seconds / LEGACY_CYCLES * 1e9), 0};
+				samples.push_back(sample);
+			}
+			start = end + 1;
+		}
+		return !samples.empty();
+	}
+
+	double seconds(0.0);
+	double frames(0.0);
+	if (sscanf(text.c_str(), "%lf %lf", &seconds, &frames) != 2 || frames <= 0.0)
+	{
+		return false;
+	}
+	mean = seconds / frames * 1e9;
+	return true;
+}
+
+// End of the 'SNAIL TRAIL' listing
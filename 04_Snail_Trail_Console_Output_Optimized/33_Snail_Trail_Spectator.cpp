@@ -0,0 +1,287 @@
+/*
+33_Snail_Trail_Spectator
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version lets other processes watch the game while it is played. The game runs in real time like version 25, and
+after every tick the garden and the game info are published in shared memory with a SpectatorPublisher (see
+"SpectatorChannel.h"). Version 34 is the viewer: it can be started (as often as wanted) in other terminals while this
+version runs, and paints what it reads. The game never waits for a viewer, the frame is guarded by a sequence lock
+that only the viewers retry on, so a slow or stopped viewer cannot slow down the game; it only misses frames.
+Every publish is timed into a LatencyHistogram (see "LatencyHistogram.h"). When the game is quit, publishing is
+timed again on a segment of its own, with 0 to 4 viewer threads in this process reading the frames as fast as they
+can, to show that what a publish costs does not depend on the number of viewers. Publishing starts once every viewer
+has opened the segment and read it, and goes on for BENCH_MS milliseconds, so that every viewer reads for as long.
+If the input is not a terminal, the keys of the "workload" recording (see "EmbeddedKeys.h") are replayed, one every
+REPLAY_TICKS ticks, and nothing is painted.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <ctime>             //for time
+#include <atomic>            //for atomic
+#include <thread>            //for thread
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>         //for SetConsoleMode
+#endif
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "TickClock.h"       //for TickClock, tickClockNow
+#include "TerminalInput.h"   //for TerminalInput
+#include "TerminalRender.h"  //for DiffRenderer
+#include "LatencyHistogram.h"//for LatencyHistogram, showHistogram
+#include "EmbeddedKeys.h"    //for findEmbeddedKeys
+#include "SpectatorChannel.h"//for SpectatorPublisher, SpectatorViewer
+
+// the segments of the game and of the timing of the viewers (read by version 34)
+const char* const SPECTATOR_NAME("/snail_trail_spectator");
+const char* const BENCH_NAME("/snail_trail_spectator_bench");
+
+// ticks per second, and the ticks after which the slime and the frogs move if no key was pressed
+const int TICKS_PER_SECOND(60);
+const int STEP_TICKS(30);
+
+// most keys read in one go
+const int MAX_PENDING_KEYS(32);
+
+// the recording replayed if the input is not a terminal, how many of its keys and how fast
+const char* const RECORDING("workload");
+const int NUM_REPLAYED_KEYS(600);
+const int REPLAY_TICKS(2);
+
+// the numbers of viewer threads publishing is timed with, and how long it is timed for each
+const int viewerCounts[] = {0, 1, 2, 4};
+const int NUM_VIEWER_COUNTS(sizeof(viewerCounts) / sizeof(viewerCounts[0]));
+const int BENCH_MS(200);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	void writeFrame(const char*, int);
+
+	static char buffer[MAX_FRAME_BYTES];
+	TerminalInput input;
+	const bool interactive = input.isTerminal();
+	const EmbeddedRecording* recording = findEmbeddedKeys(RECORDING);
+	if (!interactive && recording == 0)
+	{
+		printf("the input is not a terminal, and there is no recording named %s\n", RECORDING);
+		return 1;
+	}
+	const int numberOfKeys = interactive ? 0 :
+		recording->numberOfKeys < NUM_REPLAYED_KEYS ? recording->numberOfKeys : NUM_REPLAYED_KEYS;
+
+	LatencyHistogram publishTimes;
+	long long ticks(0);
+	{
+		SpectatorPublisher publisher(SPECTATOR_NAME);
+		if (!publisher.isOpen())
+		{
+			printf("the shared memory segment %s cannot be created\n", SPECTATOR_NAME);
+			return 1;
+		}
+
+		GameState game;
+		seedGame(game, interactive ? static_cast<unsigned int>(time(0)) : 256);
+		initialiseGame(game);
+		game.counters[0] = 0;
+		DiffRenderer renderer;
+		if (interactive)
+		{
+#ifdef _WIN32
+			// let the console understand the cursor moves of the renderer
+			HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+			DWORD mode(0);
+			GetConsoleMode(console, &mode);
+			SetConsoleMode(console, mode | 0x0004);		// ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#endif
+			writeFrame("\033[2J", 4);
+			writeFrame(buffer, renderer.render(game, buffer));
+		}
+		else
+		{
+			printf("replaying %d keys of the %s recording, watch them with version 34\n", numberOfKeys, RECORDING);
+		}
+
+		int pendingKeys[MAX_PENDING_KEYS];	// keys read, but not handled yet
+		int numberOfPending(0);
+		int nextPending(0);
+		int keyCount(0);
+		int idleTicks(0);
+		bool started(false);
+
+		TickClock clock(TICKS_PER_SECOND);
+		int key(4);
+		while (key != 5)		// keep playing games
+		{
+			clock.waitForTick();
+			++ticks;
+
+			/**********************************************************************************************
+			Poll the input
+			***********************************************************************************************/
+
+			key = -1;
+			if (interactive)
+			{
+				if (nextPending == numberOfPending)
+				{
+					numberOfPending = input.readKeys(pendingKeys, MAX_PENDING_KEYS);
+					nextPending = 0;
+				}
+				if (nextPending < numberOfPending)
+				{
+					key = pendingKeys[nextPending++];
+				}
+			}
+			else if (ticks % REPLAY_TICKS == 0)
+			{
+				key = keyCount < numberOfKeys ? recording->keys[keyCount++] : 5;
+			}
+
+			/**********************************************************************************************
+			Run the game
+			***********************************************************************************************/
+
+			if (key == 5)
+			{
+				break;
+			}
+			if (isGameOver(game))
+			{
+				if (key >= 0)		// another go
+				{
+					initialiseGame(game);
+					game.counters[0] = 0;
+					started = false;
+				}
+			}
+			else if (key >= 0)
+			{
+				stepGame(game, key);
+				started = true;
+				idleTicks = 0;
+			}
+			else if (started && ++idleTicks == STEP_TICKS)
+			{
+				stepGame(game, 4);
+				if (game.counters[0] == 7)
+				{
+					game.counters[0] = 12;
+				}
+				idleTicks = 0;
+			}
+
+			/**********************************************************************************************
+			Publish and paint the frame
+			***********************************************************************************************/
+
+			const long long start = tickClockNow();
+			publisher.publish(game);
+			publishTimes.add(tickClockNow() - start);
+
+			if (interactive)
+			{
+				writeFrame(buffer, renderer.render(game, buffer));
+			}
+		}
+	}		// the viewers are told that the game is over here
+
+	/**********************************************************************************************
+	Time publishing with viewers reading
+	***********************************************************************************************/
+
+	printf("\n%lld ticks published\n", ticks);
+	showHistogram("publish during the game", publishTimes);
+	printf("\n%-8s %10s %10s %10s %10s %10s %14s %10s\n", "viewers", "publishes", "mean ns", "50% ns", "99% ns",
+		"max ns", "frames read", "retries");
+	GameState game;
+	seedGame(game, 256);
+	initialiseGame(game);
+	for (int c = 0; c < NUM_VIEWER_COUNTS; ++c)
+	{
+		SpectatorPublisher publisher(BENCH_NAME);
+		if (!publisher.isOpen())
+		{
+			printf("the shared memory segment %s cannot be created\n", BENCH_NAME);
+			return 1;
+		}
+		atomic<bool> stop(false);
+		atomic<int> ready(0);			// viewers that have read the segment (or could not open it)
+		atomic<int> opened(0);
+		atomic<long long> framesRead(0);
+		atomic<long long> retries(0);
+		vector<thread> viewers;
+		for (int v = 0; v < viewerCounts[c]; ++v)
+		{
+			viewers.push_back(thread([&]()
+			{
+				SpectatorViewer viewer(BENCH_NAME);
+				SpectatorFrame frame;
+				int last(0);
+				long long read(0);
+				if (viewer.isOpen())
+				{
+					last = viewer.read(frame);
+					++opened;
+				}
+				++ready;
+				while (viewer.isOpen() && !stop)
+				{
+					const int number = viewer.read(frame);
+					if (number < 0)
+					{
+						break;		// the publisher stopped in the middle of a frame
+					}
+					read += number != last;
+					last = number;
+				}
+				framesRead += read;
+				retries += viewer.retries();
+			}));
+		}
+
+		while (ready < viewerCounts[c])
+		{
+			this_thread::yield();
+		}
+
+		LatencyHistogram times;
+		const long long end = tickClockNow() + BENCH_MS * 1000000LL;
+		long long publishes(0);
+		for (long long start = tickClockNow(); start < end; start = tickClockNow())
+		{
+			game.counters[1] = static_cast<int>(++publishes);		// a different frame every time
+			publisher.publish(game);
+			times.add(tickClockNow() - start);
+		}
+		stop = true;
+		for (size_t v = 0; v < viewers.size(); ++v)
+		{
+			viewers[v].join();
+		}
+		printf("%-8d %10lld %10.1f %10lld %10lld %10lld %14lld %10lld\n", viewerCounts[c], publishes, times.mean(),
+			times.percentile(50.0), times.percentile(99.0), times.max, framesRead.load(), retries.load());
+		if (opened < viewerCounts[c])
+		{
+			printf("only %d of the viewers could open the segment %s\n", opened.load(), BENCH_NAME);
+			return 1;
+		}
+	}
+	return 0;
+} //end main
+
+// writes all of a frame to the console
+void writeFrame(const char* bytes, int length)
+{
+	fwrite(bytes, 1, length, stdout);
+	fflush(stdout);
+}
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,122 @@
+/*
+34_Snail_Trail_Spectator_Viewer
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version watches a game played by version 33 in another process. It opens the shared memory segment the game is
+published in with a SpectatorViewer (see "SpectatorChannel.h"), reads the frame published last TICKS_PER_SECOND times
+a second and paints it with a DiffRenderer (see "TerminalRender.h") whenever it is a new one. The viewer only reads the
+segment, so the game does not know it is watched and does not wait for it; if the viewer is slower than the game, the
+frames published in between are skipped. When the game is over (or 'q' is pressed, or the game stopped publishing in
+the middle of a frame), the frames painted and skipped are shown, and how often a frame had to be read again because
+it was published while it was read.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>           //for memset, memcpy
+#ifdef _WIN32
+#include <windows.h>         //for SetConsoleMode
+#endif
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState
+#include "TickClock.h"       //for TickClock
+#include "TerminalInput.h"   //for TerminalInput
+#include "TerminalRender.h"  //for DiffRenderer
+#include "SpectatorChannel.h"//for SpectatorViewer, SpectatorFrame
+
+// the segment version 33 publishes the game in
+const char* const SPECTATOR_NAME("/snail_trail_spectator");
+
+// frames read per second
+const int TICKS_PER_SECOND(60);
+
+// most keys read in one go
+const int MAX_PENDING_KEYS(32);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	void writeFrame(const char*, int);
+
+	SpectatorViewer viewer(SPECTATOR_NAME);
+	if (!viewer.isOpen())
+	{
+		printf("no game to watch, start version 33 first\n");
+		return 1;
+	}
+
+#ifdef _WIN32
+	// let the console understand the cursor moves of the renderer
+	HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+	DWORD mode(0);
+	GetConsoleMode(console, &mode);
+	SetConsoleMode(console, mode | 0x0004);		// ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#endif
+
+	static char buffer[MAX_FRAME_BYTES];
+	TerminalInput input;
+	SpectatorFrame frame;
+	GameState view;				// only the garden and the game info are used
+	memset(&view, 0, sizeof(view));
+	DiffRenderer renderer;
+	writeFrame("\033[2J", 4);
+
+	int lastFrame(0);
+	long long framesPainted(0);
+	long long framesSkipped(0);
+	TickClock clock(TICKS_PER_SECOND);
+	for (;;)
+	{
+		clock.waitForTick();
+		int keys[MAX_PENDING_KEYS];
+		const int numberOfKeys = input.isTerminal() ? input.readKeys(keys, MAX_PENDING_KEYS) : 0;
+		bool quit(false);
+		for (int i = 0; i < numberOfKeys; ++i)
+		{
+			quit = quit || keys[i] == 5;
+		}
+		const bool over = viewer.isClosed();		// read before the frame, so that the last frame is painted
+
+		const int number = viewer.read(frame);
+		if (number < 0)
+		{
+			printf("\nthe game stopped in the middle of a frame\n");
+			break;
+		}
+		if (number > lastFrame)
+		{
+			framesSkipped += lastFrame > 0 ? number - lastFrame - 1 : 0;
+			lastFrame = number;
+			for (int y = 0; y < SIZEY; ++y)
+			{
+				memcpy(view.garden[y], frame.garden[y], SIZEX);
+			}
+			memcpy(view.counters, frame.counters, sizeof(view.counters));
+			writeFrame(buffer, renderer.render(view, buffer));
+			++framesPainted;
+		}
+		if (over || quit)
+		{
+			break;
+		}
+	}
+
+	printf("\n%lld frames painted, %lld skipped, %lld reads taken again\n", framesPainted, framesSkipped,
+		viewer.retries());
+	return 0;
+} //end main
+
+// writes all of a frame to the console
+void writeFrame(const char* bytes, int length)
+{
+	fwrite(bytes, 1, length, stdout);
+	fflush(stdout);
+}
+
+// End of the 'SNAIL TRAIL' listing
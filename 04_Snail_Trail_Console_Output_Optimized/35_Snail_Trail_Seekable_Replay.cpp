@@ -0,0 +1,228 @@
+/*
+35_Snail_Trail_Seekable_Replay
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version records a session in a SeekableReplay (see "SeekableReplay.h"), which can be opened at any frame in a
+time that only depends on how often it holds a keyframe, not on how long the session is. To look at frame N of a
+recording of keys, the game has to be played from the start up to frame N.
+The session is made up of the recordings named in recordingNames (see "EmbeddedKeys.h"), played one after the other
+in the same way as version 28 plays them. The frames after a key are recorded from the fields the game loop changes
+(as version 04 notes them in its changeQueue, see stepQueued in "TerminalRender.h"), the first frame of every game
+from the whole garden. It is recorded with a keyframe every keyframeIntervals[i] frames, and for each interval every
+frame is checked against the frames of the game, the recording is written to a stream and read back, and NUM_SEEKS
+frames drawn at random are opened and timed. The same frames are then opened by playing the keys from the start.
+The recording with DEFAULT_KEYFRAME_INTERVAL is written to SEEKABLE_FILE.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstdlib>           //for srand, rand
+#include <cstring>           //for memcmp
+#include <fstream>
+#include <sstream>           //for stringstream
+#include <vector>
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "TerminalRender.h"  //for ChangeQueue, stepQueued
+#include "SeekableReplay.h"  //for SeekableReplay, ReplayFrame
+#include "EmbeddedKeys.h"    //for findEmbeddedKeys
+#include "hr_time.h"         //for CStopWatch
+
+// the recordings making up the session
+const char* const recordingNames[] = {"keys", "workload", "montecarlo"};
+const int NUM_NAMES(sizeof(recordingNames) / sizeof(recordingNames[0]));
+
+// the keyframe intervals compared
+const int keyframeIntervals[] = {8, DEFAULT_KEYFRAME_INTERVAL, 128, 512};
+const int NUM_INTERVALS(sizeof(keyframeIntervals) / sizeof(keyframeIntervals[0]));
+
+// frames opened in every recording, and in the recording of keys (which takes much longer)
+const int NUM_SEEKS(20000);
+const int NUM_KEY_SEEKS(200);
+
+const char* const SEEKABLE_FILE("Session.seek");
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	int playSession(vector<unsigned char>&, int, vector<SeekableReplay>*, vector<ReplayFrame>*, ReplayFrame*);
+
+	// the keys of the session, as one recording of keys (without the 'q' that ends every recording)
+	vector<unsigned char> keys;
+	for (int n = 0; n < NUM_NAMES; ++n)
+	{
+		const EmbeddedRecording* recording = findEmbeddedKeys(recordingNames[n]);
+		for (int i = 0; recording != 0 && i < recording->numberOfKeys; ++i)
+		{
+			if (recording->keys[i] != 5)
+			{
+				keys.push_back(recording->keys[i]);
+			}
+		}
+	}
+
+	/**********************************************************************************************
+	Record the session
+	***********************************************************************************************/
+
+	vector<SeekableReplay> replays;
+	for (int i = 0; i < NUM_INTERVALS; ++i)
+	{
+		replays.push_back(SeekableReplay(keyframeIntervals[i]));
+	}
+	vector<ReplayFrame> frames;		// every frame of the session, to check the recordings
+	CStopWatch s;
+	s.startTimer();
+	const int numberOfFrames = playSession(keys, -1, &replays, &frames, 0);
+	s.stopTimer();
+	printf("%d keys, %d frames, recorded in %.3f ms with %d intervals\n\n", static_cast<int>(keys.size()), numberOfFrames,
+		s.getElapsedTime() * 1000.0, NUM_INTERVALS);
+
+	/**********************************************************************************************
+	Check and time the recordings
+	***********************************************************************************************/
+
+	srand(256);
+	vector<int> seeks(NUM_SEEKS);
+	for (int i = 0; i < NUM_SEEKS; ++i)
+	{
+		seeks[i] = rand() % numberOfFrames;
+	}
+
+	int errors(0);
+	long long checksum(0);		// keeps the frames opened from being optimised away
+	printf("%-12s %10s %10s %12s %12s\n", "recording", "bytes", "bytes/fr", "seek us", "frames off");
+	for (int i = 0; i < NUM_INTERVALS; ++i)
+	{
+		// write the recording and check what is read back
+		stringstream stream;
+		replays[i].write(stream);
+		SeekableReplay replay;
+		ReplayFrame view;
+		if (!replay.read(stream) || replay.numberOfFrames() != numberOfFrames)
+		{
+			printf("interval %d: the recording read back differs\n", keyframeIntervals[i]);
+			++errors;
+			continue;
+		}
+		for (int frame = 0; frame < numberOfFrames; ++frame)
+		{
+			if (!replay.seek(frame, view) || memcmp(&view, &frames[frame], sizeof(view)) != 0)
+			{
+				printf("interval %d: frame %d differs\n", keyframeIntervals[i], frame);
+				++errors;
+				break;
+			}
+		}
+
+		s.startTimer();
+		for (int seek = 0; seek < NUM_SEEKS; ++seek)
+		{
+			replay.seek(seeks[seek], view);
+			checksum += view.counters[1] + view.garden[seeks[seek] % SIZEY][seek % SIZEX];
+		}
+		s.stopTimer();
+
+		char name[32];
+		sprintf(name, "interval %d", keyframeIntervals[i]);
+		printf("%-12s %10d %10.2f %12.3f %12d\n", name, static_cast<int>(replay.size()),
+			static_cast<double>(replay.size()) / numberOfFrames, s.getElapsedTime() * 1e6 / NUM_SEEKS,
+			keyframeIntervals[i] - 1);
+
+		if (keyframeIntervals[i] == DEFAULT_KEYFRAME_INTERVAL)
+		{
+			ofstream outSeekable(SEEKABLE_FILE, ios::binary);
+			replay.write(outSeekable);
+		}
+	}
+
+	// open the same frames by playing the keys from the start
+	s.startTimer();
+	for (int seek = 0; seek < NUM_KEY_SEEKS; ++seek)
+	{
+		ReplayFrame view;
+		playSession(keys, seeks[seek], 0, 0, &view);
+		errors += memcmp(&view, &frames[seeks[seek]], sizeof(view)) != 0;
+	}
+	s.stopTimer();
+	printf("%-12s %10d %10.2f %12.3f %12d\n", "keys", static_cast<int>(keys.size()),
+		static_cast<double>(keys.size()) / numberOfFrames, s.getElapsedTime() * 1e6 / NUM_KEY_SEEKS, numberOfFrames - 1);
+	printf("\n(frames off: the most frames played or decoded to open a frame, checksum %lld)\n%d errors\n", checksum,
+		errors);
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// plays the keys as version 28 does, a frame after every new game and every key of a game, and records the frames into
+// replays and frames (if they are not 0), or stops at frame 'stop' and copies it into view; returns the frames played
+int playSession(vector<unsigned char>& keys, int stop, vector<SeekableReplay>* replays, vector<ReplayFrame>* frames,
+	ReplayFrame* view)
+{
+	GameState game;
+	ChangeQueue<StandardRules> queue;
+	int numberOfFrames(0);
+	size_t next(0);
+	seedGame(game, 256);
+
+	// a frame of the game, after a new game (queue 0) or a key
+	auto addFrame = [&](const ChangeQueue<StandardRules>* changes) -> bool
+	{
+		if (replays != 0)
+		{
+			for (size_t i = 0; i < replays->size(); ++i)
+			{
+				changes != 0 ? (*replays)[i].addFrame(game, *changes) : (*replays)[i].addFrame(game);
+			}
+		}
+		if (frames != 0 || numberOfFrames == stop)
+		{
+			ReplayFrame frame;
+			for (int y = 0; y < SIZEY; ++y)
+			{
+				memcpy(frame.garden[y], game.garden[y], SIZEX);
+			}
+			memcpy(frame.counters, game.counters, sizeof(frame.counters));
+			if (frames != 0)
+			{
+				frames->push_back(frame);
+			}
+			if (view != 0)
+			{
+				*view = frame;
+			}
+		}
+		return numberOfFrames++ != stop;
+	};
+
+	int key(4);
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		if (!addFrame(0))
+		{
+			break;
+		}
+		key = next < keys.size() ? keys[next++] : 5;
+		while (!isGameOver(game) && key != 5)
+		{
+			stepQueued(game, key, queue);
+			if (!addFrame(&queue))
+			{
+				return numberOfFrames;
+			}
+			key = next < keys.size() ? keys[next++] : 5;
+		}
+		if (key != 5)
+		{
+			key = next < keys.size() ? keys[next++] : 5;
+		}
+	}
+	return numberOfFrames;
+}
+
+// End of the 'SNAIL TRAIL' listing
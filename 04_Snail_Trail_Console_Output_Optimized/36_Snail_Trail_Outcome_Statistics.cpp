@@ -0,0 +1,337 @@
+/*
+36_Snail_Trail_Outcome_Statistics
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version collects the statistics of a batch run played by many threads: how many games were won, what killed the
+snail in the others, the lettuces eaten, the frames survived and the frogs the eagle got. Version 20 adds up a
+GameStats per call of playGames, on one thread. Here every thread plays its share of NUM_GAMES games with the bot of
+"RulePresets.h" and adds every game to its own shard of an OutcomeAggregator (see "OutcomeStats.h"), without locks.
+While the threads play, the main thread collects the shards every PROGRESS_MS milliseconds to show how far the run
+has got; the shards are added up once more at the end.
+The totals are checked against playGames with the same seeds, and no game may end with an unknown outcome.
+To show what the statistics cost, batches of TIMED_GAMES games with and without them are timed in BATCH_REPEATS pairs,
+taken in turns in either order so that neither is favoured by what runs before it. The batches are short, so that few
+pairs are hit by anything else running, and the overhead is the median of the pairs, so that those that are do not
+count; it must not be more than MAX_OVERHEAD percent.
+The bot does not run into frogs and seldom takes the final pellet, so the games of the recordings in "EmbeddedKeys.h"
+are added as well, played as version 12 plays them: the outcome of every game is checked against the events of the
+frame it ended in, and the recordings have to hold games lost to pellets and to running into a frog.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>           //for memset
+#include <atomic>            //for atomic
+#include <algorithm>         //for sort
+#include <chrono>            //for milliseconds
+#include <thread>            //for thread
+#include <vector>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for GameState, stepGame, etc.
+#include "RulePresets.h"     //for chooseBotKey, playGames, GameStats
+#include "OutcomeStats.h"    //for OutcomeAggregator, OutcomeStats, outcomeNames
+#include "EmbeddedKeys.h"    //for embeddedRecordings
+
+// number of games in a batch, the frames after which a game is stopped, and the seed of the first thread
+const int NUM_GAMES(40000);
+const int MAX_FRAMES(1000);
+const unsigned int SEED(256);
+
+// how often the progress is shown, the games of a timed batch and how often one is timed with and without
+// statistics, and the most the statistics may cost, in percent of a batch without them
+const int PROGRESS_MS(100);
+const int TIMED_GAMES(2000);
+const int BATCH_REPEATS(101);
+const double MAX_OVERHEAD(1.0);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	double playBatch(int, int, OutcomeAggregator*, bool);
+	int checkTotals(const OutcomeStats&, int);
+	int checkRecordings();
+	void showStats(const OutcomeStats&);
+
+	int numberOfThreads = thread::hardware_concurrency();
+	if (numberOfThreads < 1) numberOfThreads = 1;
+	printf("%d games on %d threads\n\n", NUM_GAMES, numberOfThreads);
+
+	/**********************************************************************************************
+	Play a batch, showing its progress
+	***********************************************************************************************/
+
+	OutcomeStats stats;
+	{
+		OutcomeAggregator aggregator(numberOfThreads);
+		playBatch(NUM_GAMES, numberOfThreads, &aggregator, true);
+		stats = aggregator.collect();
+	}
+	showStats(stats);
+	int errors = checkTotals(stats, numberOfThreads);
+
+	/**********************************************************************************************
+	Play the recorded keys
+	***********************************************************************************************/
+
+	errors += checkRecordings();
+
+	/**********************************************************************************************
+	Time batches with and without statistics
+	***********************************************************************************************/
+
+	vector<double> withoutStats(BATCH_REPEATS);
+	vector<double> withStats(BATCH_REPEATS);
+	vector<double> overheads(BATCH_REPEATS);
+	for (int repeat = 0; repeat < BATCH_REPEATS; ++repeat)
+	{
+		OutcomeAggregator aggregator(numberOfThreads);
+		if (repeat % 2 == 0)
+		{
+			withoutStats[repeat] = playBatch(TIMED_GAMES, numberOfThreads, 0, false);
+			withStats[repeat] = playBatch(TIMED_GAMES, numberOfThreads, &aggregator, false);
+		}
+		else
+		{
+			withStats[repeat] = playBatch(TIMED_GAMES, numberOfThreads, &aggregator, false);
+			withoutStats[repeat] = playBatch(TIMED_GAMES, numberOfThreads, 0, false);
+		}
+		overheads[repeat] = (withStats[repeat] / withoutStats[repeat] - 1.0) * 100.0;
+	}
+	sort(withoutStats.begin(), withoutStats.end());
+	sort(withStats.begin(), withStats.end());
+	sort(overheads.begin(), overheads.end());
+	const double overhead = overheads[BATCH_REPEATS / 2];
+	printf("\n%d pairs of batches: best %.1f ms without statistics, %.1f ms with statistics\n", BATCH_REPEATS,
+		withoutStats[0] * 1000.0, withStats[0] * 1000.0);
+	printf("overhead of the pairs: median %+.2f%%, from %+.2f%% to %+.2f%% (at most %.1f%% allowed)\n", overhead,
+		overheads[0], overheads[BATCH_REPEATS - 1], MAX_OVERHEAD);
+	if (overhead > MAX_OVERHEAD)
+	{
+		printf("the statistics cost more than %.1f%%\n", MAX_OVERHEAD);
+		++errors;
+	}
+	printf("%d errors\n", errors);
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// the share of thread t of a batch of numberOfGames games: seeded with SEED + t and played by the bot as playGames
+// does, added to shard if it is not 0; returns the frames played
+long long playShare(int numberOfGames, int t, int numberOfThreads, OutcomeShard* shard)
+{
+	const int games = numberOfGames / numberOfThreads + (t < numberOfGames % numberOfThreads);
+	GameState state;
+	seedGame(state, SEED + t);
+	BotRandom random;
+	random.state = (SEED + t) | 1;
+
+	long long totalFrames(0);
+	for (int game = 0; game < games; ++game)
+	{
+		initialiseGame(state);
+		int frames(0);
+		while (!isGameOver(state) && frames < MAX_FRAMES)
+		{
+			stepGame(state, chooseBotKey(state, random));
+			++frames;
+		}
+		if (shard != 0)
+		{
+			shard->addGame(state, frames, frogsEaten(state));
+		}
+		totalFrames += frames;
+	}
+	return totalFrames;
+}
+
+// plays a batch of numberOfGames games on a number of threads, with statistics if aggregator is not 0, collecting and showing them every
+// PROGRESS_MS milliseconds if showProgress is set; returns the seconds taken
+double playBatch(int numberOfGames, int numberOfThreads, OutcomeAggregator* aggregator, bool showProgress)
+{
+	vector<long long> frames(numberOfThreads);
+	atomic<int> running(numberOfThreads);
+	CStopWatch s;
+	s.startTimer();
+
+	vector<thread> workers;
+	for (int t = 0; t < numberOfThreads; ++t)
+	{
+		workers.push_back(thread([&, t]()
+		{
+			frames[t] = playShare(numberOfGames, t, numberOfThreads, aggregator != 0 ? &aggregator->shard(t) : 0);
+			--running;
+		}));
+	}
+	while (showProgress && aggregator != 0 && running > 0)
+	{
+		this_thread::sleep_for(chrono::milliseconds(PROGRESS_MS));
+		const OutcomeStats sofar = aggregator->collect();
+		printf("%8lld games, %5.1f%% won, %7.1f frames per game\n", sofar.games, sofar.winRate() * 100.0,
+			sofar.games > 0 ? static_cast<double>(sofar.frames) / sofar.games : 0.0);
+	}
+	for (int t = 0; t < numberOfThreads; ++t)
+	{
+		workers[t].join();
+	}
+
+	s.stopTimer();
+	long long total(0);
+	for (int t = 0; t < numberOfThreads; ++t)
+	{
+		total += frames[t];
+	}
+	if (total == 0)		// the frames are used, so the games cannot be left out
+	{
+		printf("no frames played\n");
+	}
+	return s.getElapsedTime();
+}
+
+// compares the statistics with playGames for the same seeds, returns the number of totals that differ
+int checkTotals(const OutcomeStats& stats, int numberOfThreads)
+{
+	GameStats expected;
+	memset(&expected, 0, sizeof(expected));
+	for (int t = 0; t < numberOfThreads; ++t)
+	{
+		const GameStats share = playGames<StandardRules>(SEED + t, NUM_GAMES / numberOfThreads +
+			(t < NUM_GAMES % numberOfThreads), MAX_FRAMES);
+		expected.games += share.games;
+		expected.frames += share.frames;
+		expected.wins += share.wins;
+		expected.pelletDeaths += share.pelletDeaths;
+		expected.frogDeaths += share.frogDeaths;
+		expected.timeouts += share.timeouts;
+		expected.lettuces += share.lettuces;
+		expected.eagleStrikes += share.eagleStrikes;
+	}
+
+	// playGames counts a game in which the last lettuce is eaten and a frog lands on the snail as won as well
+	const long long wonAndDead = expected.wins + expected.pelletDeaths + expected.frogDeaths + expected.timeouts -
+		expected.games;
+	const long long frogDeaths = stats.outcomes[OUTCOME_FROG_LANDED] + stats.outcomes[OUTCOME_RAN_INTO_FROG];
+	long long outcomes(0);
+	for (int outcome = 0; outcome < NUM_OUTCOMES; ++outcome)
+	{
+		outcomes += stats.outcomes[outcome];
+	}
+	int errors(0);
+	errors += stats.games != expected.games || outcomes != stats.games;
+	errors += stats.frames != expected.frames;
+	errors += stats.outcomes[OUTCOME_WON] != expected.wins - wonAndDead;
+	errors += stats.outcomes[OUTCOME_PELLETS] != expected.pelletDeaths;
+	errors += frogDeaths != expected.frogDeaths;
+	errors += stats.outcomes[OUTCOME_TIMEOUT] != expected.timeouts;
+	errors += stats.outcomes[OUTCOME_UNKNOWN] != 0;
+	errors += stats.lettuces != expected.lettuces;
+	errors += stats.eagleKills != expected.eagleStrikes;
+	printf("%lld games won and lost in the same frame\n", wonAndDead);
+	if (errors > 0)
+	{
+		printf("%d totals differ from playGames\n", errors);
+	}
+	return errors;
+}
+
+// the outcome of a game told by the events of the frame it ended in (a game stopped by 'q' counts as a timeout)
+Outcome eventOutcome(unsigned int events)
+{
+	if (events & EVENT_HIT_FINAL_PELLET) return OUTCOME_PELLETS;
+	if (events & EVENT_HIT_FROG) return OUTCOME_RAN_INTO_FROG;
+	if (events & EVENT_FROG_HITS_SNAIL) return OUTCOME_FROG_LANDED;
+	return events & EVENT_HIT_FINAL_LETTUCE ? OUTCOME_WON : OUTCOME_TIMEOUT;
+}
+
+// plays the games of every embedded recording with a shard each, as version 12 plays them after srand(256), and
+// compares their outcomes with the events; returns the number of counts that differ or are missing
+int checkRecordings()
+{
+	Outcome eventOutcome(unsigned int);
+
+	OutcomeAggregator aggregator(NUM_EMBEDDED_RECORDINGS);
+	long long expected[NUM_OUTCOMES] = {0};
+	printf("\n%-12s %6s", "recording", "games");
+	for (int outcome = 0; outcome < NUM_OUTCOMES; ++outcome)
+	{
+		printf(" %14s", outcomeNames[outcome]);
+	}
+	printf("\n");
+	for (int r = 0; r < NUM_EMBEDDED_RECORDINGS; ++r)
+	{
+		const EmbeddedRecording& recording = embeddedRecordings[r];
+		GameState state;
+		seedGame(state, 256);
+		int keyCount(0);
+		int key(4);
+		while (key != 5)		// keep playing games
+		{
+			initialiseGame(state);
+			int frames(0);
+			unsigned int events(0);
+			key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+			while (!isGameOver(state) && key != 5)
+			{
+				events = stepGame(state, key);
+				++frames;
+				key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+			}
+			aggregator.shard(r).addGame(state, frames, frogsEaten(state));
+			++expected[eventOutcome(events)];
+			// another go, also after 'q' (as in version 12)
+			key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+		}
+
+		const OutcomeStats stats = aggregator.collect(r, 1);
+		printf("%-12s %6lld", recording.name, stats.games);
+		for (int outcome = 0; outcome < NUM_OUTCOMES; ++outcome)
+		{
+			printf(" %14lld", stats.outcomes[outcome]);
+		}
+		printf("\n");
+	}
+
+	const OutcomeStats stats = aggregator.collect();
+	int errors(0);
+	for (int outcome = 0; outcome < NUM_OUTCOMES; ++outcome)
+	{
+		errors += stats.outcomes[outcome] != expected[outcome];
+	}
+	errors += stats.outcomes[OUTCOME_PELLETS] == 0;
+	errors += stats.outcomes[OUTCOME_RAN_INTO_FROG] == 0;
+	if (errors > 0)
+	{
+		printf("%d outcomes of the recordings differ from their events or are missing\n", errors);
+	}
+	return errors;
+}
+
+void showStats(const OutcomeStats& stats)
+{
+	printf("\n%lld games, %lld frames (%.1f per game), %.2f lettuces and %.3f frogs eaten by the eagle per game\n",
+		stats.games, stats.frames, static_cast<double>(stats.frames) / stats.games,
+		static_cast<double>(stats.lettuces) / stats.games, static_cast<double>(stats.eagleKills) / stats.games);
+	for (int outcome = 0; outcome < NUM_OUTCOMES; ++outcome)
+	{
+		printf("%-14s %8lld %6.2f%%\n", outcomeNames[outcome], stats.outcomes[outcome],
+			stats.outcomes[outcome] * 100.0 / stats.games);
+	}
+	printf("frames survived: 50%% %d, 90%% %d, 99%% %d (in buckets of %d)\n", stats.survivalPercentile(50.0),
+		stats.survivalPercentile(90.0), stats.survivalPercentile(99.0), SURVIVAL_BUCKET_FRAMES);
+	printf("lettuces eaten:");
+	for (int lettuces = 0; lettuces < NUM_LETTUCE_BUCKETS; ++lettuces)
+	{
+		if (stats.lettuceCounts[lettuces] > 0)
+		{
+			printf(" %d: %.1f%%", lettuces, stats.lettuceCounts[lettuces] * 100.0 / stats.games);
+		}
+	}
+	printf("\n");
+}
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,227 @@
+/*
+37_Snail_Trail_Parameter_Sweep
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+This version tunes the difficulty of the game by playing it with every combination of the values in DifficultyGrid:
+how often the eagle strikes, how far frogs leap, how many pellets there are and how many can be eaten, how long slime
+lasts and how large the garden is. Version 20 plays a handful of sets of rules written out one by one; here the sets
+of rules are made up from the grid (see "ParameterSweep.h") and GAMES_PER_CELL games are played with each of them on
+all threads, once with the bot of "RulePresets.h" and once with the keys of the KEY_RECORDING recording (see
+"EmbeddedKeys.h") played in a loop.
+For both, the cells of the grid are shown sorted by how often the games were won (only the SHOWN_CELLS/2 easiest and
+hardest if there are more): the rules of the cell, the games won, the games in which a frog killed the snail, the
+frames survived on average and the frames per second of one thread.
+The grid is compiled, every cell with a copy of the game code of its own, which makes the compiler take longer over
+DifficultyGrid than the sweeps take to run, and puts a grid of thousands of cells out of reach. So the bot sweep is
+played once more with RuntimeRules, whose values are set at run time, and every cell has to come out exactly as the compiled one.
+The games per second of that sweep are used to work out how long a sweep of LARGE_SWEEP_CELLS cells with
+LARGE_SWEEP_GAMES games each would take on this machine with RuntimeRules. If there is a GRID_FILE, the grid in it
+(see "ParameterSweep.h" for the format) is swept with RuntimeRules as well, with GRID_GAMES_PER_CELL games per cell.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>           //for memcmp
+#include <algorithm>         //for sort
+#include <fstream>           //for ifstream
+#include <thread>            //for hardware_concurrency
+#include <vector>
+#include "hr_time.h"         //for timers
+
+using namespace std;
+
+//include our own libraries
+#include "SnailEngine.h"     //for SIZEY, SIZEX
+#include "ParameterSweep.h"  //for SweepAxis, SweepTable, runSweep, readSweepGrid, etc.
+#include "EmbeddedKeys.h"    //for findEmbeddedKeys
+
+// the values of the rules in the sweep (the gardens are 20 by 30 as in version 12, and 12 by 18)
+struct DifficultyGrid
+{
+	typedef SweepAxis<16, 32, 64> EagleStrikes;
+	typedef SweepAxis<2, 4> FrogLeaps;
+	typedef SweepAxis<10, 15, 25> Pellets;
+	typedef SweepAxis<3, 5> Thresholds;
+	typedef SweepAxis<16, 25> SlimeLives;
+	typedef SweepAxis<SIZEY, 12> GardenRows;
+	typedef SweepAxis<SIZEX, 18> GardenColumns;
+};
+
+const int NUM_CELLS(SweepTable<DifficultyGrid>::NUM_CELLS);
+
+// games per cell, and the frames after which a game is stopped
+const int GAMES_PER_CELL(4096);
+const int MAX_FRAMES(1000);
+
+// the recording played by the second sweep
+const char* const KEY_RECORDING("montecarlo");
+
+// the most cells shown for a sweep
+const int SHOWN_CELLS(20);
+
+// the sweep with RuntimeRules the time is worked out for
+const double LARGE_SWEEP_CELLS(1e4);
+const double LARGE_SWEEP_GAMES(1e4);
+
+// the grid swept with RuntimeRules if the file is there, and its games per cell
+const char* const GRID_FILE("SweepGrid.txt");
+const int GRID_GAMES_PER_CELL(1024);
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	//function prototypes
+	double sweep(const char*, const vector<SweepCell>&, int, const SweepPolicy&, int, vector<SweepResult>&);
+	int compareSweeps(const vector<SweepResult>&, const vector<SweepResult>&);
+
+	int numberOfThreads = thread::hardware_concurrency();
+	if (numberOfThreads < 1) numberOfThreads = 1;
+
+	vector<SweepCell> cells(NUM_CELLS);
+	SweepTable<DifficultyGrid>::fill(&cells[0]);
+	printf("%d cells, %d games each, %d threads\n", NUM_CELLS, GAMES_PER_CELL, numberOfThreads);
+
+	const EmbeddedRecording* recording = findEmbeddedKeys(KEY_RECORDING);
+	if (recording == 0)
+	{
+		printf("no recording named %s\n", KEY_RECORDING);
+		return 1;
+	}
+	vector<unsigned char> keys;		// without the 'q' at the end
+	for (int i = 0; i < recording->numberOfKeys; ++i)
+	{
+		if (recording->keys[i] != 5)
+		{
+			keys.push_back(recording->keys[i]);
+		}
+	}
+	const SweepPolicy bot = {0, 0};
+	const SweepPolicy recorded = {&keys[0], static_cast<int>(keys.size())};
+
+	/**********************************************************************************************
+	Sweep the compiled grid with the bot and with recorded keys
+	***********************************************************************************************/
+
+	vector<SweepResult> results;
+	const double compiledSeconds = sweep("bot", cells, GAMES_PER_CELL, bot, numberOfThreads, results);
+	vector<SweepResult> recordedResults;
+	sweep(KEY_RECORDING, cells, GAMES_PER_CELL, recorded, numberOfThreads, recordedResults);
+
+	/**********************************************************************************************
+	Sweep the same grid with RuntimeRules
+	***********************************************************************************************/
+
+	vector<SweepCell> runtimeCells;
+	for (int cell = 0; cell < NUM_CELLS; ++cell)
+	{
+		runtimeCells.push_back(runtimeCell(cells[cell]));
+	}
+	vector<SweepResult> runtimeResults;
+	const double runtimeSeconds = sweep("bot, RuntimeRules", runtimeCells, GAMES_PER_CELL, bot, numberOfThreads,
+		runtimeResults);
+	int errors = compareSweeps(results, runtimeResults);
+	printf("RuntimeRules take %.2f times as long as the compiled grid, %d cells differ\n",
+		runtimeSeconds / compiledSeconds, errors);
+
+	const double gamesPerSecond = static_cast<double>(NUM_CELLS) * GAMES_PER_CELL / runtimeSeconds;
+	printf("a sweep of %.0f cells with %.0f games each would take about %.0f minutes on %d threads with RuntimeRules\n",
+		LARGE_SWEEP_CELLS, LARGE_SWEEP_GAMES, LARGE_SWEEP_CELLS * LARGE_SWEEP_GAMES / gamesPerSecond / 60.0,
+		numberOfThreads);
+
+	/**********************************************************************************************
+	Sweep the grid of the grid file
+	***********************************************************************************************/
+
+	ifstream inGrid(GRID_FILE);
+	if (inGrid)
+	{
+		SweepGrid grid;
+		if (!readSweepGrid(inGrid, grid))
+		{
+			printf("\nthe grid in %s cannot be read\n", GRID_FILE);
+			return 1;
+		}
+		const int unfit = makeRuntimeCells(grid, runtimeCells);
+		if (unfit >= 0)
+		{
+			const SweepCell& cell = runtimeCells[unfit];
+			printf("\nthe rules of cell %d of %s do not fit into RuntimeRules (eagle %d, leap %d, pellets %d, "
+				"threshold %d, slime %d, garden %dx%d)\n", unfit, GRID_FILE, cell.eagleStrike, cell.frogLeap,
+				cell.numPellets, cell.pelletThreshold, cell.slimeLife, cell.rows, cell.columns);
+			return 1;
+		}
+		printf("\n%s: %d cells, %d games each\n", GRID_FILE, static_cast<int>(runtimeCells.size()),
+			GRID_GAMES_PER_CELL);
+		sweep("bot", runtimeCells, GRID_GAMES_PER_CELL, bot, numberOfThreads, runtimeResults);
+		sweep(KEY_RECORDING, runtimeCells, GRID_GAMES_PER_CELL, recorded, numberOfThreads, runtimeResults);
+	}
+
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// sweeps the cells with a policy and shows them, returns the seconds it took
+double sweep(const char* policy, const vector<SweepCell>& cells, int gamesPerCell, const SweepPolicy& keys,
+	int numberOfThreads, vector<SweepResult>& results)
+{
+	void showSweep(const char*, const vector<SweepCell>&, const vector<SweepResult>&, double);
+
+	CStopWatch s;
+	s.startTimer();
+	runSweep(&cells[0], static_cast<int>(cells.size()), gamesPerCell, MAX_FRAMES, keys, numberOfThreads, results);
+	s.stopTimer();
+	showSweep(policy, cells, results, s.getElapsedTime());
+	return s.getElapsedTime();
+}
+
+// the number of cells whose statistics differ
+int compareSweeps(const vector<SweepResult>& a, const vector<SweepResult>& b)
+{
+	int differ(0);
+	for (size_t cell = 0; cell < a.size(); ++cell)
+	{
+		differ += cell >= b.size() || memcmp(&a[cell].stats, &b[cell].stats, sizeof(OutcomeStats)) != 0;
+	}
+	return differ;
+}
+
+// shows the cells of a sweep from the most to the fewest games won, and the time it took
+void showSweep(const char* policy, const vector<SweepCell>& cells, const vector<SweepResult>& results, double seconds)
+{
+	vector<int> order(results.size());
+	long long games(0);
+	long long frames(0);
+	for (size_t cell = 0; cell < results.size(); ++cell)
+	{
+		order[cell] = static_cast<int>(cell);
+		games += results[cell].stats.games;
+		frames += results[cell].stats.frames;
+	}
+	sort(order.begin(), order.end(), [&](int a, int b)
+	{
+		return results[a].stats.winRate() > results[b].stats.winRate();
+	});
+
+	printf("\n%s: %lld games, %lld frames in %.2f s (%.0f games/s)\n", policy, games, frames, seconds, games / seconds);
+	printf("%5s %5s %5s %5s %5s %7s %8s %8s %8s %12s\n", "eagle", "leap", "pell.", "thr.", "slime", "garden", "won %",
+		"frog %", "frames", "frames/s");
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		if (static_cast<int>(order.size()) > SHOWN_CELLS && i == SHOWN_CELLS / 2)
+		{
+			printf("%5s\n", "...");
+			i = order.size() - SHOWN_CELLS / 2;
+		}
+		const SweepCell& cell = cells[order[i]];
+		const OutcomeStats& stats = results[order[i]].stats;
+		char garden[16];
+		sprintf(garden, "%dx%d", cell.rows, cell.columns);
+		printf("%5d %5d %5d %5d %5d %7s %8.1f %8.1f %8.1f %12.0f\n", cell.eagleStrike, cell.frogLeap, cell.numPellets,
+			cell.pelletThreshold, cell.slimeLife, garden, stats.winRate() * 100.0,
+			(stats.outcomes[OUTCOME_FROG_LANDED] + stats.outcomes[OUTCOME_RAN_INTO_FROG]) * 100.0 / stats.games,
+			static_cast<double>(stats.frames) / stats.games, stats.frames / results[order[i]].seconds);
+	}
+}
+
+// End of the 'SNAIL TRAIL' listing
@@ -0,0 +1,259 @@
+/* Recorded keys built into the code, made by 27_Snail_Trail_Key_Embedder from the files named below (run it
+again instead of changing this file). It is not run by the build, see version 27 for when and how to run it.
+
+Use the following procedures/functions for the following results:
+
+findEmbeddedKeys(name) to look up a recording by name, returns 0 if there is none with that name
+embeddedRecordings, NUM_EMBEDDED_RECORDINGS for the list of all recordings
+
+Every recording holds the keys from 0 to 5 (see translateKey in "SnailEngine.h"), one byte per key, in the order
+they were recorded.
+*/
+
+#ifndef EMBEDDED_KEYS_H
+#define EMBEDDED_KEYS_H
+
+#include <cstring>           //for strcmp
+
+struct EmbeddedRecording
+{
+	const char* name;
+	const char* file;			// the file it was made from
+	const unsigned char* keys;
+	int numberOfKeys;
+};
+
+// "Keys.txt"
+const unsigned char keysKeys[132] = {
+	0,0,3,3,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,2,2,2,0,0,2,1,2,1,2,2,2,1,2,
+	2,1,1,1,1,1,0,0,1,1,1,2,1,1,1,1,4,4,4,1,1,2,3,3,0,0,2,2,2,0,3,1,1,1,1,1,1,1,0,0,
+	0,0,0,0,3,1,1,1,1,1,2,2,2,1,1,1,1,1,3,0,3,3,3,3,3,0,0,0,0,0,0,0,2,3,3,0,2,4,0,2,
+	2,2,1,1,3,0,0,3,1,3,3,5};
+
+// "WorkloadKeys.txt"
+const unsigned char workloadKeys[5975] = {
+	3,1,1,1,1,1,3,3,4,4,3,3,2,1,1,4,4,1,1,2,2,2,2,2,2,2,2,2,2,1,1,1,1,1,2,2,2,2,2,2,
+	4,4,4,1,1,4,4,1,2,4,1,1,1,1,1,1,1,1,1,3,3,3,3,3,3,3,1,2,2,2,2,1,1,1,1,1,1,1,1,1,
+	1,3,0,0,0,0,0,0,0,3,3,3,3,3,1,1,1,3,3,3,0,0,0,3,3,3,4,4,3,3,3,3,3,3,3,3,3,3,3,1,
+	3,3,4,1,4,4,0,3,3,3,3,3,3,3,3,3,0,0,2,2,0,0,2,2,2,2,2,2,2,2,4,0,0,0,0,4,0,0,0,0,
+	3,3,3,0,0,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,0,2,2,2,0,0,0,2,2,2,2,2,0,0,0,4,4,0,0,
+	0,0,0,0,0,3,4,4,3,3,3,3,3,3,0,0,4,4,3,3,1,1,1,1,1,2,2,2,2,2,4,1,1,1,3,3,3,4,4,3,
+	3,1,1,1,2,2,1,1,2,2,4,0,0,0,0,0,0,2,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+	1,1,1,1,1,1,1,3,3,3,3,3,3,3,1,1,1,1,3,3,3,3,3,0,0,3,3,3,4,4,3,3,3,0,4,2,4,4,2,2,
+	2,1,1,3,3,3,3,3,3,3,3,3,3,0,0,0,0,0,0,0,0,0,2,4,4,0,0,0,3,3,3,3,3,3,3,4,0,0,4,4,
+	0,0,0,4,1,0,4,4,0,3,3,3,3,3,3,3,3,3,3,3,0,0,0,0,2,2,2,2,2,2,2,4,2,2,2,2,2,1,1,1,
+	1,1,1,1,1,1,1,1,1,4,2,2,2,2,1,1,1,1,3,3,0,3,3,3,3,3,3,3,1,1,4,3,1,1,1,1,1,1,1,1,
+	1,2,2,2,4,4,2,2,2,2,2,2,0,4,4,0,0,0,0,0,2,2,2,2,4,4,1,1,4,4,1,1,1,1,1,1,1,1,2,2,
+	2,2,2,2,2,2,2,2,0,0,0,0,2,2,0,0,0,4,3,3,3,3,3,3,3,3,0,0,4,3,1,1,1,1,1,1,1,1,1,1,
+	1,1,1,1,1,1,0,4,1,2,2,1,1,1,4,4,3,3,4,4,3,3,3,3,1,1,2,1,1,1,1,1,1,1,1,2,2,2,2,2,
+	2,0,0,0,0,0,0,2,2,2,2,2,0,0,0,0,3,3,3,3,3,3,3,3,1,1,3,1,1,1,1,2,2,2,1,1,4,2,2,0,
+	0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,3,3,3,3,3,0,0,4,2,2,2,2,1,2,2,2,2,1,3,3,1,1,1,4,
+	2,2,0,0,4,2,2,2,2,4,0,0,0,3,3,3,3,3,3,4,0,0,0,3,3,4,4,3,3,3,0,0,0,0,3,4,4,0,0,0,
+	0,0,2,2,2,4,4,1,1,1,1,1,1,1,1,1,3,3,3,4,4,0,0,0,1,3,3,4,4,3,1,1,1,1,1,1,1,3,3,3,
+	4,4,4,3,3,3,3,3,1,1,3,3,3,1,1,3,3,3,3,1,1,1,1,1,3,3,0,0,4,4,2,2,4,0,0,0,0,0,0,0,
+	3,1,1,1,1,3,3,3,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,0,0,0,0,0,0,0,0,2,1,1,1,1,1,1,1,1,
+	1,1,1,2,2,2,2,2,4,1,1,1,1,1,1,3,0,0,0,0,0,3,3,3,3,3,0,0,0,0,0,0,0,0,0,0,2,2,4,4,
+	2,1,2,2,2,4,4,2,1,3,3,3,3,3,3,1,1,1,1,1,1,1,1,3,3,3,3,3,3,3,3,0,0,4,0,0,0,4,3,0,
+	0,4,4,0,2,4,1,1,1,1,0,4,1,3,4,4,3,3,0,0,2,2,2,2,4,4,1,1,1,1,1,1,1,1,3,3,3,0,0,0,
+	3,4,1,1,1,4,4,1,1,1,4,2,2,2,2,0,0,2,2,2,2,0,0,0,0,0,2,2,4,0,0,4,4,1,1,1,2,2,2,2,
+	2,4,0,0,0,0,4,3,3,3,3,3,3,3,3,0,0,3,3,3,3,0,0,0,0,0,0,0,0,0,3,3,3,3,1,1,1,1,1,1,
+	1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,1,4,4,2,4,4,4,2,2,2,4,4,2,2,2,1,1,1,1,1,3,3,3,3,
+	3,3,3,3,3,3,3,3,3,3,4,0,0,0,0,4,2,2,2,2,2,2,2,3,1,4,4,1,1,3,3,1,4,4,1,3,0,0,0,0,
+	0,0,0,0,0,4,3,1,1,1,3,3,0,0,0,0,4,3,0,0,0,0,0,0,0,0,4,2,2,2,2,2,2,2,0,0,0,0,2,2,
+	2,2,1,1,1,1,1,1,1,1,1,3,3,1,1,4,4,1,2,2,2,0,0,4,4,3,3,1,1,2,2,2,0,2,2,2,4,1,1,1,
+	1,3,3,3,0,2,2,0,0,0,0,0,2,4,4,4,4,3,3,3,3,3,3,3,3,1,3,3,3,3,3,4,1,1,1,1,2,2,2,2,
+	2,2,2,2,0,0,0,0,0,0,0,0,2,2,2,2,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,3,3,3,1,1,3,
+	4,4,3,3,0,4,2,2,2,2,4,4,2,0,0,0,0,3,3,4,4,1,1,1,1,1,1,1,1,4,4,2,2,4,0,0,0,0,0,0,
+	0,0,0,4,2,2,1,1,1,1,1,4,2,2,2,2,2,0,0,0,4,4,1,1,1,1,2,2,2,2,0,0,0,0,0,0,0,2,2,2,
+	2,1,1,1,3,3,4,1,1,1,1,1,1,1,3,0,0,0,0,0,0,0,0,3,1,1,1,1,1,1,1,1,3,3,3,0,0,0,0,0,
+	3,1,1,1,1,1,1,1,1,1,1,1,4,4,0,0,0,3,3,3,4,4,3,1,1,1,1,3,3,3,3,3,3,0,0,2,2,2,2,0,
+	0,0,0,0,0,0,0,2,2,2,2,2,2,2,2,2,2,0,3,4,0,0,0,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,1,1,
+	1,1,1,1,2,2,2,2,2,0,0,0,0,0,2,2,2,0,2,2,2,2,0,4,3,4,4,1,4,2,2,0,3,3,4,4,3,3,3,1,
+	1,1,4,4,1,1,1,4,3,3,3,4,4,3,0,0,0,0,0,0,0,3,3,4,3,3,3,3,3,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,2,2,2,2,2,2,2,2,2,2,1,1,4,4,1,1,3,3,3,3,3,1,1,1,1,1,1,1,1,2,1,1,3,4,
+	1,1,1,1,1,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,3,4,1,3,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,4,
+	4,0,2,2,2,2,2,2,2,4,4,2,2,2,2,2,2,4,1,4,4,1,2,0,0,0,0,0,4,0,4,4,3,3,3,3,3,3,0,2,
+	2,2,2,2,2,2,2,2,2,2,1,1,3,3,1,1,1,1,2,2,2,1,3,1,1,1,1,3,3,0,0,0,4,3,3,4,1,1,3,3,
+	3,4,4,0,0,0,2,2,2,2,2,2,2,1,1,1,1,1,1,3,3,1,1,1,1,1,4,4,1,1,1,1,4,2,2,0,4,4,0,0,
+	0,0,0,3,3,4,4,4,1,1,1,1,1,1,1,1,1,1,3,3,3,3,1,1,1,1,1,3,3,3,3,0,0,0,0,0,0,0,0,3,
+	3,3,0,0,0,2,0,0,3,3,3,3,4,4,0,0,4,0,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,1,2,2,1,
+	4,4,1,1,1,4,3,1,4,4,4,0,0,0,0,0,0,4,4,0,0,2,2,2,2,2,2,2,1,1,1,2,4,4,2,2,2,2,2,2,
+	0,0,0,0,0,4,2,2,2,2,1,1,1,1,1,1,1,1,1,1,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,
+	1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,4,4,3,3,0,0,2,2,2,4,4,3,3,4,1,1,1,1,1,3,3,3,3,3,3,
+	3,3,1,1,1,1,1,1,1,1,2,2,0,0,0,0,0,0,0,3,1,1,1,1,1,1,1,1,1,2,2,4,4,4,3,3,3,4,1,1,
+	1,4,4,1,1,1,1,3,3,3,4,4,3,3,4,4,0,0,0,0,3,3,3,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,1,1,
+	4,4,1,4,2,2,2,2,2,2,2,4,4,0,0,4,4,2,1,1,1,1,2,2,2,2,1,1,2,2,2,2,2,2,2,1,1,1,1,1,
+	1,1,1,1,1,1,3,3,3,3,3,3,3,3,4,1,3,3,3,1,1,1,1,1,1,1,1,4,4,2,2,2,1,1,3,0,0,4,4,0,
+	0,4,2,2,2,2,2,1,1,1,1,1,1,3,3,1,1,1,1,1,1,1,1,1,1,3,3,3,3,3,3,0,0,0,0,0,2,2,0,0,
+	0,2,2,2,2,2,2,4,0,0,0,0,2,1,1,4,2,4,4,1,1,1,1,1,1,1,4,1,2,2,2,2,4,4,2,2,2,0,0,0,
+	0,0,0,0,3,3,3,3,3,3,1,1,1,1,1,1,1,1,1,4,2,1,1,1,1,1,1,1,1,2,2,2,2,4,0,0,0,0,0,0,
+	0,0,4,3,3,3,3,3,3,4,4,3,3,3,0,3,3,3,3,3,3,3,3,1,1,1,1,3,3,0,4,0,3,3,3,0,4,4,1,1,
+	1,1,1,1,1,1,1,1,1,3,3,0,0,0,0,0,0,0,3,3,3,0,0,3,0,0,3,3,3,3,3,0,0,0,0,0,0,0,2,2,
+	2,4,4,2,1,1,1,1,1,4,3,0,0,0,3,3,3,3,3,3,3,3,3,1,3,3,3,3,3,4,4,1,1,1,1,1,2,2,2,4,
+	0,0,0,4,2,2,2,1,1,1,4,2,2,2,2,2,2,2,2,2,2,0,0,0,0,0,0,3,4,3,3,3,3,3,3,3,3,1,1,1,
+	3,3,3,3,3,3,4,1,2,2,1,1,4,2,2,2,2,0,0,2,2,0,0,0,0,3,3,0,0,0,0,0,0,0,0,3,3,4,4,0,
+	0,0,0,0,0,0,0,0,0,0,2,2,2,2,2,2,2,0,0,0,4,2,2,0,0,4,4,0,0,0,0,2,2,2,2,2,2,4,1,4,
+	1,1,1,1,2,2,2,2,2,2,2,4,4,2,0,0,0,0,0,0,0,0,0,3,3,3,3,4,1,1,1,3,1,1,1,2,2,2,2,0,
+	4,4,0,4,2,2,2,1,4,1,3,3,4,1,1,4,3,3,3,4,4,4,1,3,3,3,3,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,2,2,2,2,2,4,4,2,4,4,0,0,0,0,0,3,3,3,3,1,1,1,3,1,1,4,1,1,2,2,2,2,2,2,0,0,
+	3,3,3,3,0,0,0,0,2,2,2,4,0,0,0,2,0,0,4,0,0,0,0,2,2,2,2,4,4,1,1,1,3,3,3,1,1,1,1,1,
+	1,1,1,4,3,3,3,3,3,3,3,4,4,4,0,0,0,0,0,0,0,2,2,2,2,4,4,2,2,0,0,4,3,3,3,3,3,0,0,2,
+	2,0,0,0,0,0,4,3,1,1,1,1,1,3,3,1,4,4,3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,4,4,4,2,2,2,2,
+	2,2,2,1,1,1,1,2,2,2,4,0,0,4,4,0,4,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1,3,3,3,3,3,3,3,3,
+	3,3,3,3,4,0,0,0,0,3,1,3,4,4,3,4,1,4,4,4,2,2,2,2,2,2,2,0,0,0,0,0,0,4,0,3,3,3,3,3,
+	3,3,3,3,3,3,3,3,3,3,1,1,1,1,1,2,1,1,1,4,4,2,2,2,2,2,2,4,0,0,2,1,1,4,4,1,1,2,2,2,
+	2,2,2,2,2,2,4,4,0,0,0,3,3,3,3,3,3,1,1,4,4,4,4,4,4,4,0,1,1,1,1,1,1,1,1,4,3,3,1,2,
+	2,2,2,2,2,2,2,1,3,3,4,1,1,3,3,3,3,3,1,4,2,2,2,2,2,2,2,4,3,4,4,0,0,0,4,0,0,4,3,3,
+	3,3,3,3,3,3,1,1,2,2,2,0,2,2,4,2,2,1,1,1,4,4,3,3,3,3,3,3,3,3,3,0,0,2,2,4,2,2,4,0,
+	0,2,2,2,2,2,1,1,1,3,3,3,3,3,3,1,2,2,2,2,2,2,2,4,0,0,0,0,0,4,3,3,3,3,3,3,3,4,1,4,
+	4,2,2,2,2,2,2,4,4,4,4,1,1,1,4,3,3,3,1,1,4,4,3,3,0,0,0,0,0,4,2,1,1,4,4,2,4,4,2,2,
+	0,0,0,0,0,0,0,0,0,0,0,2,2,4,0,0,0,0,0,3,0,0,0,0,0,0,0,3,1,1,1,1,1,1,1,1,1,1,1,2,
+	2,2,2,2,2,2,2,2,2,2,2,2,2,4,0,3,3,4,4,0,0,2,2,2,0,0,0,4,0,0,0,0,3,4,1,1,1,1,4,3,
+	3,3,3,3,1,1,1,1,1,1,2,2,2,2,2,4,1,4,4,3,3,3,1,4,4,4,1,2,2,0,0,2,1,4,4,4,1,1,1,4,
+	4,4,4,1,1,3,3,3,0,0,0,0,0,0,0,0,0,2,2,4,2,2,0,0,0,0,0,0,0,0,0,0,4,3,3,3,3,3,1,1,
+	1,1,1,1,1,1,1,1,1,4,2,2,2,2,4,0,0,0,0,3,1,1,1,4,3,0,0,0,0,0,3,3,1,1,1,1,4,4,4,4,
+	4,4,2,4,1,1,1,1,1,4,2,2,2,2,4,4,1,1,1,1,1,1,1,4,3,3,3,0,0,0,3,3,3,0,4,0,0,0,0,0,
+	0,2,2,2,2,2,4,0,0,0,0,4,3,3,3,1,1,3,3,3,1,1,1,1,2,2,2,2,2,0,0,0,0,0,4,4,2,4,1,1,
+	1,4,1,1,1,4,4,3,3,3,3,4,4,4,0,0,2,2,2,4,1,4,4,0,0,0,3,3,4,4,1,4,0,4,4,1,1,1,3,0,
+	0,0,0,0,0,0,0,2,2,2,2,1,1,1,1,1,1,1,3,0,0,0,0,0,0,3,4,4,4,1,1,1,4,4,3,3,3,0,0,0,
+	0,2,2,2,2,2,4,1,1,1,4,1,1,1,1,1,4,1,4,4,4,3,4,0,0,0,0,3,0,0,0,0,0,4,4,2,2,2,0,0,
+	0,0,0,3,3,3,3,1,1,1,1,1,1,1,1,1,4,4,4,2,2,2,2,1,1,1,1,1,1,1,1,4,3,0,0,0,0,0,0,0,
+	4,3,3,4,1,3,3,4,0,0,0,2,2,2,2,4,0,0,3,3,4,4,3,3,3,3,3,1,1,2,1,1,1,1,1,2,2,2,2,2,
+	2,0,0,0,0,0,0,4,4,4,3,3,3,3,3,4,1,1,4,4,2,2,2,2,4,1,1,3,1,1,4,4,2,2,2,0,0,0,0,0,
+	4,4,3,3,1,1,3,3,3,3,3,3,3,3,3,3,3,3,3,1,1,1,1,2,2,2,1,1,1,1,1,1,1,1,1,3,4,1,1,1,
+	1,1,2,2,2,2,0,0,0,0,2,2,4,1,2,0,0,0,2,2,2,2,1,1,1,1,1,1,1,2,2,2,4,4,4,0,0,0,0,4,
+	4,3,3,0,0,0,0,2,2,1,1,1,4,4,3,3,3,0,0,0,4,4,4,4,4,3,4,4,0,0,4,2,4,4,3,1,1,1,1,1,
+	1,1,1,1,2,4,0,0,0,0,0,4,4,4,2,4,0,1,0,0,0,4,0,0,0,0,0,0,0,0,4,4,0,4,3,3,3,3,3,3,
+	1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,1,1,1,1,3,3,3,1,2,2,2,1,4,4,4,2,2,2,2,2,2,2,1,
+	4,3,1,1,1,1,1,3,3,3,3,3,3,0,0,0,3,3,3,3,3,3,3,3,3,4,0,0,0,0,0,2,2,2,2,2,2,2,2,2,
+	2,2,0,0,0,0,0,0,0,0,0,0,0,0,0,2,4,4,4,4,2,2,4,0,0,4,3,3,4,3,3,3,3,1,1,1,1,2,2,0,
+	0,2,1,1,1,1,1,1,1,3,4,4,0,0,0,4,3,4,1,1,1,1,1,1,2,2,2,2,4,0,0,0,0,0,3,3,0,0,0,0,
+	0,0,0,0,3,4,1,3,3,3,3,3,4,1,4,1,1,1,2,2,2,2,2,4,4,1,1,2,2,4,4,0,0,0,0,3,3,3,3,3,
+	4,0,0,0,0,2,2,2,2,2,4,1,3,3,3,4,4,2,4,1,2,2,2,4,4,4,4,1,1,4,2,2,4,4,1,3,3,3,3,3,
+	3,3,0,0,4,2,2,0,0,0,0,2,2,2,2,2,4,1,1,4,1,1,1,4,3,3,3,3,3,3,3,3,3,4,4,4,0,4,2,2,
+	2,2,4,4,0,0,0,2,2,1,1,1,1,1,1,4,2,0,0,0,0,0,0,0,2,2,2,1,1,1,1,1,3,3,4,0,0,0,2,4,
+	1,4,4,3,3,4,1,4,4,4,3,3,3,1,1,4,4,2,0,0,0,0,0,3,3,3,3,1,1,1,1,4,4,4,3,3,4,4,1,1,
+	1,1,1,2,0,0,0,2,1,1,1,4,4,2,2,2,0,4,4,4,0,0,4,0,0,3,3,4,0,2,2,2,2,2,1,2,2,2,2,2,
+	2,2,0,4,3,0,0,0,3,4,3,0,0,0,0,0,0,0,0,0,3,3,0,0,0,0,0,0,3,3,3,3,3,3,3,3,1,1,1,1,
+	1,1,3,3,0,0,0,0,0,0,0,4,4,4,4,4,4,4,3,1,1,1,1,1,1,1,1,1,2,2,2,4,2,4,0,0,0,0,0,0,
+	0,0,0,0,4,2,2,2,2,2,2,1,1,4,4,3,3,3,3,1,1,2,4,2,2,2,2,4,1,1,3,3,3,3,3,3,3,0,0,0,
+	0,0,0,2,2,2,2,4,1,1,4,1,1,2,0,0,4,4,0,0,4,4,0,3,3,3,3,3,4,4,0,0,2,2,2,2,2,2,1,2,
+	2,2,2,1,1,1,1,1,1,1,1,3,0,0,3,3,3,0,4,4,4,2,2,4,4,2,2,2,2,2,2,2,2,2,2,2,2,1,1,1,
+	1,1,1,3,0,0,0,0,0,3,3,3,3,3,4,4,3,0,0,0,0,0,0,0,0,0,0,0,0,2,2,2,2,0,0,0,3,3,3,3,
+	3,3,3,3,0,0,0,0,2,2,2,2,2,1,3,3,3,3,4,4,3,3,3,3,0,0,0,0,0,0,0,0,4,4,4,2,0,0,4,3,
+	3,3,3,3,3,3,3,3,4,4,0,0,2,2,2,4,4,2,4,0,0,0,0,4,2,2,2,2,2,0,3,3,3,3,3,3,3,4,4,0,
+	0,3,1,1,1,1,1,1,1,1,1,1,1,1,4,1,1,2,2,2,2,2,1,1,3,1,1,1,3,3,3,3,3,3,3,4,0,0,0,2,
+	2,2,2,1,3,3,4,4,4,1,1,4,2,2,2,2,2,2,1,3,3,3,3,3,3,3,3,3,0,0,4,0,4,4,3,3,1,1,4,1,
+	1,2,2,4,0,4,4,3,3,2,2,4,4,2,1,1,1,1,2,2,2,4,4,4,1,1,1,1,1,1,1,4,4,4,2,2,2,4,4,0,
+	0,0,0,0,0,0,4,3,3,3,1,1,4,1,4,3,3,4,1,1,1,2,2,2,2,0,0,0,0,0,4,4,4,0,0,1,4,3,3,3,
+	3,3,3,3,3,3,3,0,3,0,0,3,3,3,3,3,4,1,1,1,1,2,2,2,2,4,0,3,0,1,3,4,4,4,4,4,3,0,2,2,
+	2,2,2,4,0,3,3,3,3,3,3,0,0,2,2,2,2,2,2,2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+	1,1,1,1,1,3,3,3,1,2,2,2,2,2,2,2,2,2,4,0,0,2,0,0,0,0,0,0,0,2,2,1,1,1,1,1,1,1,1,4,
+	3,0,0,4,4,4,0,0,0,4,4,0,0,3,3,3,3,1,1,1,1,1,1,1,4,2,2,2,0,0,0,0,0,3,3,1,1,1,2,4,
+	4,4,3,3,3,3,3,0,0,2,2,2,4,4,2,0,0,0,0,0,2,2,2,2,1,2,1,1,1,2,1,4,4,1,1,4,4,2,2,2,
+	2,2,2,2,4,1,1,1,1,1,1,1,2,2,2,2,0,0,0,0,0,0,0,0,0,4,3,3,3,3,3,3,3,3,3,3,4,4,4,4,
+	1,1,4,4,2,2,2,2,4,2,2,2,4,0,3,3,3,0,0,0,0,0,0,0,0,4,2,4,4,4,4,2,2,2,0,0,0,3,3,3,
+	3,3,4,4,0,0,3,4,1,1,1,1,4,4,4,2,1,1,1,4,3,3,4,0,2,0,0,4,2,3,3,3,3,3,1,1,2,2,2,4,
+	4,1,4,2,2,2,2,1,4,4,4,2,0,0,0,0,0,0,0,0,0,3,1,1,1,3,4,3,0,4,0,3,3,3,0,0,2,2,2,2,
+	2,2,2,1,1,1,1,1,1,1,1,3,0,0,4,0,4,4,0,0,0,4,3,3,3,4,4,1,1,1,1,1,2,2,4,1,1,2,0,0,
+	0,2,2,4,4,2,2,1,1,1,1,4,3,3,3,3,3,3,4,4,0,0,0,0,0,0,0,0,2,2,1,1,1,1,1,4,4,2,2,4,
+	4,2,4,1,1,3,3,4,0,3,3,3,3,3,3,3,0,0,4,4,4,2,2,4,2,2,2,2,4,0,0,3,3,3,3,0,0,0,2,2,
+	4,2,2,2,2,1,1,1,1,1,1,3,3,3,3,3,0,2,2,2,0,4,0,0,0,3,3,3,3,3,3,1,1,1,1,4,4,2,4,4,
+	0,0,0,2,2,2,2,4,4,2,2,2,1,1,1,3,3,3,3,3,3,1,2,2,2,2,2,2,2,2,0,0,3,4,4,0,0,0,0,0,
+	0,3,3,3,3,3,1,1,1,1,1,1,1,1,1,2,4,1,1,2,2,0,0,0,0,0,0,0,4,2,1,4,1,1,1,1,1,4,2,0,
+	0,0,4,0,4,4,2,0,3,0,0,0,0,3,3,3,0,3,3,3,1,1,1,1,1,1,1,1,4,2,2,2,1,2,2,2,2,0,3,3,
+	3,4,0,0,0,0,0,0,0,4,2,1,1,1,1,1,1,2,0,0,0,0,0,2,2,4,1,1,1,1,1,4,3,1,1,1,1,3,3,3,
+	3,3,3,4,0,0,0,0,0,0,0,0,0,0,4,2,4,4,2,4,2,1,1,1,3,1,1,1,1,4,3,0,4,3,3,3,3,3,0,0,
+	2,2,2,0,0,4,4,2,2,2,2,2,1,4,1,1,1,1,3,3,3,3,0,0,3,3,3,0,4,2,2,2,2,2,2,4,0,0,3,3,
+	3,3,3,3,3,1,4,2,2,2,2,2,4,4,4,2,2,2,4,1,1,1,1,1,3,3,3,3,4,0,2,2,2,0,3,3,3,3,3,3,
+	3,3,3,0,4,4,2,2,2,2,2,2,2,4,0,4,2,2,2,2,0,0,3,1,3,0,0,3,3,3,3,4,1,4,4,1,1,1,4,2,
+	1,1,1,1,2,2,4,0,0,0,0,0,0,0,2,1,1,2,1,1,1,1,1,2,4,2,0,0,3,4,4,0,0,0,4,4,4,4,4,0,
+	2,2,0,0,3,3,3,3,3,3,4,4,4,1,1,1,1,1,1,1,4,1,2,0,0,0,0,0,0,0,4,2,2,2,2,1,1,1,1,1,
+	3,4,4,3,1,1,4,2,2,2,1,4,3,3,3,3,3,3,4,4,0,0,0,0,2,2,2,2,4,4,4,4,1,1,1,2,2,0,0,0,
+	0,0,0,4,3,3,3,3,3,3,3,3,4,4,1,1,2,2,4,1,4,4,4,2,2,2,2,2,2,0,4,4,4,4,0,0,3,3,3,4,
+	4,3,3,3,3,3,4,1,1,1,1,4,4,2,2,2,2,2,2,0,0,4,4,0,0,0,0,3,3,3,1,1,2,2,1,1,1,1,4,3,
+	3,3,3,3,3,0,2,2,2,0,0,0,0,0,0,2,2,2,2,1,1,1,1,1,3,3,3,0,4,2,0,0,4,4,4,4,3,4,3,3,
+	3,3,3,1,1,1,1,2,2,4,0,4,2,2,2,2,2,2,2,1,1,1,3,3,3,3,4,3,4,4,1,1,1,4,2,2,2,4,0,0,
+	4,2,2,2,0,0,0,4,2,4,0,0,0,3,4,1,1,3,3,3,3,3,4,1,1,4,4,3,3,1,4,4,4,2,2,2,2,2,2,0,
+	4,2,4,1,1,4,3,3,3,3,3,3,3,3,0,0,0,0,0,4,4,4,2,2,2,2,2,2,2,4,4,1,1,1,1,1,3,3,3,0,
+	4,3,0,0,4,4,0,2,2,4,4,0,0,2,0,0,0,0,0,3,3,3,1,1,1,1,3,4,1,1,4,4,2,4,1,1,1,2,2,2,
+	4,4,0,0,0,3,3,4,4,0,0,0,0,4,4,4,2,2,2,4,1,1,1,1,1,1,1,1,3,0,0,0,0,0,0,3,3,3,3,1,
+	1,1,1,1,2,4,4,0,0,2,4,4,0,0,4,4,3,3,3,3,3,1,1,1,1,1,1,1,2,2,2,4,0,0,0,0,0,0,3,1,
+	1,1,1,4,3,4,4,3,3,3,3,4,4,1,4,4,2,2,2,2,2,2,2,2,2,4,0,0,0,4,4,3,4,4,0,0,0,0,0,2,
+	2,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,3,3,3,3,0,0,0,4,4,4,0,3,3,3,3,3,3,3,3,4,0,0,0,0,
+	0,0,0,3,1,1,4,3,1,1,3,0,0,5,5};
+
+// "MonteCarloKeys.txt"
+const unsigned char montecarloKeys[1988] = {
+	2,2,2,0,3,0,0,0,0,2,0,0,2,0,0,0,0,3,0,0,0,0,0,0,3,0,0,3,4,1,0,1,1,0,4,1,4,1,3,1,
+	4,3,1,0,3,3,0,0,3,3,3,1,3,1,0,1,1,4,1,0,2,2,1,3,3,1,4,2,3,2,2,1,1,1,3,2,4,1,0,1,
+	4,3,1,2,2,1,4,4,2,2,0,0,3,3,0,0,0,0,0,0,0,0,0,0,2,1,1,1,2,2,2,2,2,2,2,0,0,0,0,4,
+	0,0,4,0,1,0,1,0,0,0,2,0,4,4,0,1,1,3,1,4,3,1,1,3,3,4,0,0,2,1,3,4,1,1,3,3,2,1,2,1,
+	0,1,3,4,1,2,2,2,1,1,2,1,2,2,2,2,1,0,4,1,1,2,1,1,2,2,2,2,2,3,4,2,2,2,1,1,0,1,1,4,
+	1,1,3,3,3,3,2,1,4,1,3,2,3,3,4,1,1,4,0,1,1,4,1,3,1,3,3,4,4,2,3,3,0,0,3,3,0,0,2,1,
+	2,2,2,0,3,0,0,4,0,3,0,3,4,3,3,1,4,2,1,3,3,3,4,4,0,0,3,0,4,0,3,3,1,1,1,4,3,1,4,1,
+	1,0,3,1,0,1,1,1,0,3,2,1,1,3,1,1,3,1,4,4,0,1,1,2,3,0,2,2,1,1,2,3,2,2,1,3,0,2,1,2,
+	4,0,3,2,1,1,2,1,1,1,4,4,2,2,1,1,1,2,0,2,2,1,2,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,3,1,
+	1,1,3,1,1,2,0,4,3,1,2,3,3,4,2,3,4,3,0,2,1,1,1,2,0,0,1,0,1,2,0,3,2,1,2,2,3,3,1,3,
+	3,3,3,1,4,3,3,3,3,3,1,3,3,4,1,0,1,4,0,1,0,3,0,0,2,3,2,1,4,3,1,1,4,3,1,1,1,3,3,0,
+	4,3,4,2,1,4,4,0,4,2,1,2,4,2,2,1,1,3,1,2,1,1,1,4,4,1,4,0,3,2,4,0,2,1,0,4,2,4,4,0,
+	2,0,2,3,0,1,0,2,1,1,1,3,2,2,0,2,3,2,2,4,1,1,1,1,4,0,0,0,4,2,1,1,4,2,4,1,2,4,1,1,
+	1,2,1,1,1,0,0,3,4,1,2,1,4,4,2,1,2,2,2,0,0,4,2,1,1,1,2,2,2,2,2,2,2,3,3,4,2,2,1,3,
+	1,3,1,1,1,1,1,4,1,0,0,1,1,1,1,1,3,3,2,4,3,3,2,4,1,1,1,3,2,3,2,3,3,2,1,3,1,2,3,4,
+	3,4,1,4,3,1,3,3,1,4,1,2,1,0,0,3,4,4,3,3,1,4,0,3,1,0,1,3,3,3,4,0,4,0,1,0,1,0,0,1,
+	0,3,1,0,0,4,4,4,0,0,0,0,0,3,0,0,4,4,1,2,0,0,0,0,2,0,3,3,3,1,1,1,2,4,0,4,1,2,1,0,
+	2,3,3,1,4,1,1,3,2,4,3,0,1,0,3,1,3,3,3,1,3,3,0,2,0,0,1,0,0,1,0,0,0,2,2,2,0,0,4,0,
+	1,4,4,0,2,0,3,0,3,3,0,1,1,3,4,0,3,0,3,0,1,3,0,2,3,4,0,4,0,0,4,4,2,2,2,1,3,3,3,3,
+	3,3,1,2,2,4,1,1,1,2,0,0,0,2,2,3,2,1,1,1,1,2,1,2,2,2,3,4,4,4,2,2,2,0,4,3,1,0,1,4,
+	2,3,0,0,4,2,0,3,4,0,0,1,2,0,1,1,3,0,2,1,0,0,0,0,4,2,0,3,4,3,0,0,0,2,0,0,2,0,4,4,
+	0,0,0,3,3,3,0,0,4,0,3,3,3,3,3,0,3,0,1,1,0,0,0,3,0,1,3,2,1,1,4,0,0,1,1,1,1,1,4,1,
+	1,1,2,2,1,1,4,0,1,1,4,1,1,3,2,0,4,4,3,2,1,1,1,1,3,3,3,1,4,4,4,0,4,2,1,3,1,0,4,3,
+	1,2,3,4,3,0,1,3,1,2,2,4,1,1,1,1,3,3,3,1,1,1,3,4,3,3,0,4,2,1,0,3,2,1,1,4,2,1,4,2,
+	2,4,2,4,3,2,2,2,0,1,1,0,0,3,4,0,4,1,0,4,2,4,4,4,2,3,3,0,1,0,0,0,2,0,0,4,3,0,1,1,
+	0,0,0,1,1,0,0,0,0,4,4,3,0,4,3,3,3,2,2,0,0,3,1,1,1,1,3,3,0,3,2,4,2,1,1,2,2,2,3,0,
+	2,0,3,2,2,2,2,2,2,1,2,2,4,1,1,4,4,2,4,4,1,1,2,4,1,1,2,2,3,0,0,0,0,3,3,0,4,4,4,3,
+	2,3,2,0,3,2,0,0,1,0,1,0,3,3,2,2,3,3,0,0,0,0,3,4,3,4,4,0,0,3,3,3,4,4,3,0,2,0,3,1,
+	3,3,1,3,1,4,2,1,4,4,0,2,4,2,1,0,0,3,3,1,2,1,3,1,2,2,2,2,2,0,0,0,2,0,4,1,4,4,4,1,
+	3,1,2,3,1,1,3,1,2,1,2,3,2,1,1,0,2,2,3,2,0,2,3,4,3,2,4,3,0,0,0,4,0,1,4,4,3,2,2,2,
+	4,1,3,1,1,0,1,1,1,2,4,4,3,4,1,1,0,4,4,2,1,1,2,4,2,1,2,2,2,2,0,1,2,0,4,0,0,0,0,0,
+	0,2,2,0,2,0,0,2,0,0,0,0,0,0,4,4,1,1,4,3,0,0,3,0,3,1,1,1,3,3,3,1,3,2,1,1,1,2,1,3,
+	3,1,2,0,1,1,2,1,0,1,0,1,3,3,3,1,4,3,1,1,1,4,1,1,2,0,2,3,4,4,4,4,0,1,2,1,2,2,3,2,
+	2,4,4,2,3,2,4,4,3,0,0,3,0,2,2,1,2,0,2,2,0,0,3,1,0,1,1,2,1,1,1,2,0,4,0,3,3,3,3,2,
+	3,3,3,3,4,3,3,3,3,3,2,3,1,1,1,1,1,4,0,0,3,4,0,1,2,1,1,2,1,1,1,4,1,1,1,4,1,4,2,3,
+	2,1,2,3,2,2,4,2,2,2,2,0,0,4,1,4,1,1,2,3,2,3,0,1,0,0,2,2,2,2,4,4,2,0,3,0,3,3,0,0,
+	4,2,2,1,3,4,2,0,2,0,1,2,2,2,4,2,4,1,3,4,3,3,1,3,3,0,0,2,1,0,1,0,3,3,0,0,0,2,0,3,
+	0,1,4,2,1,3,2,2,0,1,4,4,2,4,1,2,2,2,2,0,2,2,2,4,4,4,2,2,2,3,2,3,1,1,1,1,1,1,1,1,
+	1,1,1,1,1,1,3,3,0,0,1,3,0,3,3,3,3,3,3,3,3,0,4,4,1,3,1,1,3,1,1,2,2,0,3,0,4,3,1,2,
+	2,1,2,0,0,0,0,0,2,0,3,2,4,0,3,0,2,2,2,2,1,1,1,1,1,1,1,1,0,1,1,1,1,1,3,0,0,3,3,3,
+	0,3,0,0,0,3,0,3,3,2,0,3,0,0,0,3,3,3,1,4,0,4,4,1,0,1,1,0,1,2,1,0,1,4,4,2,2,1,3,1,
+	1,0,4,1,1,0,4,1,1,4,4,3,1,0,4,1,3,3,2,1,1,2,1,3,1,4,4,2,0,3,3,4,0,0,3,1,3,3,3,1,
+	3,0,0,3,1,3,3,0,0,3,1,1,1,1,2,1,1,3,0,3,1,2,0,3,3,2,3,3,2,1,2,3,0,2,2,2,1,4,0,1,
+	2,1,1,1,4,4,4,3,1,2,2,1,1,2,2,0,3,0,0,3,0,3,3,0,3,0,3,0,3,3,1,1,1,3,3,0,0,2,1,1,
+	4,2,1,2,1,4,1,0,2,0,4,1,3,1,1,1,2,2,0,0,0,2,4,4,0,2,2,2,0,2,4,4,3,3,2,3,2,3,4,2,
+	2,0,1,0,4,0,3,4,3,3,3,0,0,0,1,0,3,2,2,3,3,0,3,3,4,4,0,0,3,3,1,0,3,1,1,0,0,2,4,2,
+	0,0,1,0,0,4,1,1,4,3,2,4,2,1,2,0,2,2,2,2,2,1,3,1,1,2,1,0,2,3,3,0,0,3,1,0,4,1,3,0,
+	3,1,3,0,2,4,4,4,3,1,3,0,3,2,1,1,0,1,3,4,0,0,3,0,2,1,4,1,2,4,2,4,0,4,0,4,0,4,4,4,
+	3,3,0,2,3,1,0,4,1,2,4,3,4,0,3,4,0,2,0,1,4,0,0,1,1,3,3,0,1,0,0,3,0,0,2,4,2,0,4,0,
+	1,4,1,0,2,1,2,4,3,4,1,2,3,0,2,0,2,0,2,2,4,2,3,2,2,2,4,5};
+
+const EmbeddedRecording embeddedRecordings[] = {
+	{"keys", "Keys.txt", keysKeys, 132},
+	{"workload", "WorkloadKeys.txt", workloadKeys, 5975},
+	{"montecarlo", "MonteCarloKeys.txt", montecarloKeys, 1988}
+};
+
+const int NUM_EMBEDDED_RECORDINGS(sizeof(embeddedRecordings) / sizeof(embeddedRecordings[0]));
+
+inline const EmbeddedRecording* findEmbeddedKeys(const char* name)
+{
+	for (int i = 0; i < NUM_EMBEDDED_RECORDINGS; ++i)
+	{
+		if (strcmp(embeddedRecordings[i].name, name) == 0)
+		{
+			return &embeddedRecordings[i];
+		}
+	}
+	return 0;
+}
+
+#endif
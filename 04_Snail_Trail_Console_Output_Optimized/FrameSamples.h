@@ -0,0 +1,223 @@
+/* Timing every frame of the recorded games (see "EmbeddedKeys.h") together with the events that happened in it, and
+keeping these samples in a file, so that the frames of one build can be compared with those of another.
+
+Use the following procedures/functions for the following results:
+
+TerminalSink sink to open a pseudo terminal that a thread of its own reads everything from, sink.terminal() for the
+	descriptor to write to (-1 on Windows, which has no pseudo terminals)
+writeFrame(terminal, bytes, length) to write all of a frame (nothing if terminal is -1)
+timeRecording(recording, index, terminal, samples) to play all games of a recording like version 11 and add a
+	FrameSample for every frame to samples, with index as its recording
+writeFrameEvents(name, recordingNames, samples) to write samples to a file, one line per frame with the name of its
+	recording, the frame, its time in nanoseconds and its events
+readFrameEvents(name, recordingNames, numberOfNames, samples) to read such a file back, keeping the frames of the
+	recordings in recordingNames, returns false if the file cannot be opened or is not such a file
+
+A frame is timed from the key to the end of its output: the iteration of the game loop, painting it with a
+DiffRenderer (see "TerminalRender.h") and the bells of version 12 (one for a warning, four for a death knell, seven
+for a win), written with one call of write.
+*/
+
+#ifndef FRAME_SAMPLES_H
+#define FRAME_SAMPLES_H
+
+#include <cstring>           //for memset, strcmp
+#include <fstream>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <thread>            //for thread
+#include <termios.h>         //for cfmakeraw
+#include <unistd.h>          //for read, write, close
+#ifdef __APPLE__
+#include <util.h>            //for openpty
+#else
+#include <pty.h>             //for openpty (link with -lutil)
+#endif
+#endif
+
+#include "SnailEngine.h"     //for GameState, stepGame, NUM_EVENTS
+#include "TickClock.h"       //for tickClockNow
+#include "TerminalRender.h"  //for DiffRenderer
+#include "EmbeddedKeys.h"    //for EmbeddedRecording
+
+// bells version 12 rings for every event
+const int eventBells[NUM_EVENTS] = {1, 4, 1, 0, 0, 1, 5, 7, 4, 0, 1, 0};
+
+// a timed frame
+struct FrameSample
+{
+	int recording;				// in the names of the recordings played
+	int frame;					// counted from the start of the recording
+	long long nanoseconds;
+	unsigned int events;
+};
+
+class TerminalSink
+{
+private:
+	int master;
+	int slave;
+#ifndef _WIN32
+	std::thread screen;
+#endif
+
+	// not to be copied, the terminal belongs to a single sink
+	TerminalSink(const TerminalSink&);
+	TerminalSink& operator=(const TerminalSink&);
+
+public:
+	TerminalSink() : master(-1), slave(-1)
+	{
+#ifndef _WIN32
+		if (openpty(&master, &slave, 0, 0, 0) != 0)
+		{
+			master = -1;
+			slave = -1;
+			return;
+		}
+		termios raw;
+		tcgetattr(slave, &raw);
+		cfmakeraw(&raw);		// no changes to the bytes written
+		tcsetattr(slave, TCSANOW, &raw);
+
+		// the other side: read everything until the terminal is closed
+		const int reader = master;
+		screen = std::thread([reader]()
+		{
+			char bytes[65536];
+			while (read(reader, bytes, sizeof(bytes)) > 0)
+			{
+			}
+		});
+#endif
+	}
+
+	~TerminalSink()
+	{
+#ifndef _WIN32
+		if (slave >= 0)
+		{
+			close(slave);
+			screen.join();
+			close(master);
+		}
+#endif
+	}
+
+	int terminal() const
+	{
+		return slave;
+	}
+};
+
+inline void writeFrame(int terminal, const char* bytes, int length)
+{
+#ifndef _WIN32
+	int written(0);
+	while (terminal >= 0 && written < length)
+	{
+		const ssize_t result = write(terminal, bytes + written, length - written);
+		if (result <= 0)
+		{
+			return;
+		}
+		written += static_cast<int>(result);
+	}
+#else
+	(void)terminal;
+	(void)bytes;
+	(void)length;
+#endif
+}
+
+inline void timeRecording(const EmbeddedRecording& recording, int index, int terminal, std::vector<FrameSample>& samples)
+{
+	static char buffer[MAX_FRAME_BYTES + 16];		// room for the bells as well
+	GameState game;
+	seedGame(game, 256);
+	DiffRenderer renderer;
+
+	int frame(0);
+	int keyCount(0);
+	int key(4);
+	while (key != 5)		// keep playing games
+	{
+		initialiseGame(game);
+		writeFrame(terminal, buffer, renderer.render(game, buffer));
+
+		key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+		while (!isGameOver(game) && key != 5)
+		{
+			const long long start = tickClockNow();
+			const unsigned int events = stepGame(game, key);
+			int length = renderer.render(game, buffer);
+			for (int event = 0; event < NUM_EVENTS; ++event)
+			{
+				if ((events >> event) & 1)
+				{
+					memset(buffer + length, '\a', eventBells[event]);
+					length += eventBells[event];
+				}
+			}
+			writeFrame(terminal, buffer, length);
+			const long long stop = tickClockNow();
+
+			const FrameSample sample = {index, frame++, stop - start, events};
+			samples.push_back(sample);
+			key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+		}
+		// another go, also after 'q' (as in version 12)
+		key = keyCount < recording.numberOfKeys ? recording.keys[keyCount++] : 5;
+	}
+}
+
+/***************************************************************************************
+The file
+****************************************************************************************/
+
+const char* const FRAME_EVENTS_HEADER("recording frame nanoseconds events");
+
+inline void writeFrameEvents(const char* name, const char* const recordingNames[], const std::vector<FrameSample>& samples)
+{
+	std::ofstream outFrames(name);
+	outFrames << FRAME_EVENTS_HEADER << '\n';
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		outFrames << recordingNames[samples[i].recording] << ' ' << samples[i].frame << ' ' << samples[i].nanoseconds
+			<< ' ' << samples[i].events << '\n';
+	}
+	outFrames.close();
+}
+
+inline bool readFrameEvents(const char* name, const char* const recordingNames[], int numberOfNames,
+	std::vector<FrameSample>& samples)
+{
+	std::ifstream inFrames(name);
+	std::string line;
+	if (!std::getline(inFrames, line) || line.compare(0, strlen(FRAME_EVENTS_HEADER), FRAME_EVENTS_HEADER) != 0)
+	{
+		return false;
+	}
+
+	std::string recording;
+	FrameSample sample;
+	while (inFrames >> recording >> sample.frame >> sample.nanoseconds >> sample.events)
+	{
+		sample.recording = -1;
+		for (int n = 0; n < numberOfNames; ++n)
+		{
+			if (recording == recordingNames[n])
+			{
+				sample.recording = n;
+			}
+		}
+		if (sample.recording >= 0)
+		{
+			samples.push_back(sample);
+		}
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,288 @@
+/* Loading recorded keys from files in the format of "Keys.txt" (the key codes read by getKeyPress, separated by
+commas) in one go, instead of a character at a time.
+
+Use the following procedures/functions for the following results:
+
+MappedFile file(name) to map a file into memory for reading (until file goes out of scope)
+file.isOpen(), file.data() and file.size() to check whether that worked and to get at the contents
+parseKeys(text, length, keys) to turn the key codes in text into keys from 0 to 5 (see translateKey in
+	"SnailEngine.h"), one byte per key, returns the number of keys (keys needs room for maxKeyCount(length) of them)
+parseKeysScalar(text, length, keys) to do the same a byte at a time, as a reference
+loadKeyFile(name, keys) to map a file and parse all of it into a vector, returns false if it cannot be opened
+
+Version 02 reads "Keys.txt" with get from an ifstream, one character at a time, and turns every key code into a number
+through an ostringstream and an istringstream, versions 11 and 12 had the keys copied into the code. Here the whole file
+is mapped into memory (mmap on POSIX systems, a file mapping on Windows) and parsed straight from there. parseKeys
+looks at 16 bytes at a time with SSE2: which of them are not digits (the separators) is worked out for all of them at
+once, and the digits between two separators are put together into a key code, for up to 3 digits without branches
+and with a table instead of translateKey (the branches cannot be predicted for keys in random order). Anything other
+than a digit separates key codes, so line breaks or spaces do no harm, and empty fields are left out. A key code with
+more digits than fit in an int is taken as an 'other' key, as translateKey does for every code it does not know.
+*/
+
+#ifndef KEY_FILE_H
+#define KEY_FILE_H
+
+#include <cstddef>           //for size_t
+#include <vector>            //for vector
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KEY_FILE_SSE2
+#include <emmintrin.h>       //for SSE2 intrinsics
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>          //for _BitScanForward
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>           //for open
+#include <sys/mman.h>        //for mmap
+#include <sys/stat.h>        //for fstat
+#include <unistd.h>          //for close
+#endif
+
+#include "SnailEngine.h"     //for translateKey
+
+class MappedFile
+{
+private:
+	const char* contents;
+	size_t length;
+	bool open;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+
+	// not to be copied, the mapping belongs to a single object
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+public:
+	explicit MappedFile(const char* name) : contents(0), length(0), open(false)
+	{
+#ifdef _WIN32
+		mapping = 0;
+		file = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+		LARGE_INTEGER size;
+		if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size))
+		{
+			return;
+		}
+		length = static_cast<size_t>(size.QuadPart);
+		open = true;
+		if (length > 0)		// an empty file cannot be mapped
+		{
+			mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+			contents = mapping != 0 ? static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : 0;
+			open = contents != 0;
+		}
+#else
+		const int file = ::open(name, O_RDONLY);
+		struct stat status;
+		if (file < 0 || fstat(file, &status) != 0)
+		{
+			if (file >= 0)
+			{
+				close(file);
+			}
+			return;
+		}
+		length = static_cast<size_t>(status.st_size);
+		open = true;
+		if (length > 0)		// an empty file cannot be mapped
+		{
+			void* memory = mmap(0, length, PROT_READ, MAP_PRIVATE, file, 0);
+			open = memory != MAP_FAILED;
+			if (open)
+			{
+				madvise(memory, length, MADV_SEQUENTIAL);
+				contents = static_cast<const char*>(memory);
+			}
+		}
+		close(file);		// the mapping stays
+#endif
+	}
+
+	~MappedFile()
+	{
+#ifdef _WIN32
+		if (contents != 0)
+		{
+			UnmapViewOfFile(contents);
+		}
+		if (mapping != 0)
+		{
+			CloseHandle(mapping);
+		}
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file);
+		}
+#else
+		if (contents != 0)
+		{
+			munmap(const_cast<char*>(contents), length);
+		}
+#endif
+	}
+
+	bool isOpen() const
+	{
+		return open;
+	}
+
+	const char* data() const
+	{
+		return contents;
+	}
+
+	size_t size() const
+	{
+		return open ? length : 0;
+	}
+};
+
+// the most keys text of a length can hold (every other byte a separator)
+inline size_t maxKeyCount(size_t length)
+{
+	return length / 2 + 1;
+}
+
+// the key for the digits of a key code
+inline unsigned char keyFromDigits(const char* digits, size_t count)
+{
+	if (count > 9)
+	{
+		return 4;
+	}
+	int command(0);
+	for (size_t i = 0; i < count; ++i)
+	{
+		command = command * 10 + (digits[i] - '0');
+	}
+	return static_cast<unsigned char>(translateKey(command));
+}
+
+// the keys of all key codes below 1000, so that parseKeys can look them up instead of branching on them
+struct KeyTable
+{
+	unsigned char keys[1000];
+
+	KeyTable()
+	{
+		for (int command = 0; command < 1000; ++command)
+		{
+			keys[command] = static_cast<unsigned char>(translateKey(command));
+		}
+	}
+};
+
+inline const unsigned char* keyTable()
+{
+	static const KeyTable table;
+	return table.keys;
+}
+
+inline bool isKeyDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+inline size_t parseKeysScalar(const char* text, size_t length, unsigned char* keys)
+{
+	size_t count(0);
+	size_t start(0);		// first digit of the key code being read
+	for (size_t i = 0; i < length; ++i)
+	{
+		if (!isKeyDigit(text[i]))
+		{
+			if (i > start)
+			{
+				keys[count++] = keyFromDigits(text + start, i - start);
+			}
+			start = i + 1;
+		}
+	}
+	if (length > start)		// no separator after the last key code
+	{
+		keys[count++] = keyFromDigits(text + start, length - start);
+	}
+	return count;
+}
+
+inline size_t parseKeys(const char* text, size_t length, unsigned char* keys)
+{
+	size_t count(0);
+	size_t start(0);
+	size_t i(0);
+#ifdef KEY_FILE_SSE2
+	const unsigned char* table = keyTable();
+	const __m128i zero = _mm_set1_epi8('0');
+	const __m128i nine = _mm_set1_epi8(9);
+	for (; i + 16 <= length; i += 16)
+	{
+		// a byte is a digit if it is at most 9 above '0' (as an unsigned byte)
+		const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)), zero);
+		const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, nine), digits);
+		unsigned int separators = ~static_cast<unsigned int>(_mm_movemask_epi8(isDigit)) & 0xFFFF;
+
+		while (separators != 0)
+		{
+#ifdef _MSC_VER
+			unsigned long bit;
+			_BitScanForward(&bit, separators);
+#else
+			const unsigned int bit = __builtin_ctz(separators);
+#endif
+			const size_t end = i + bit;
+			const size_t digits = end - start;
+			if (digits - 1 < 3 && end >= 3)
+			{
+				// 1 to 3 digits, taken from the 3 bytes before the separator without branching on their number
+				const unsigned int hundreds = static_cast<unsigned char>(text[end - 3] - '0') * (digits > 2);
+				const unsigned int tens = static_cast<unsigned char>(text[end - 2] - '0') * (digits > 1);
+				const unsigned int ones = static_cast<unsigned char>(text[end - 1] - '0');
+				keys[count++] = table[hundreds * 100 + tens * 10 + ones];
+			}
+			else if (digits != 0)
+			{
+				keys[count++] = keyFromDigits(text + start, digits);
+			}
+			start = end + 1;
+			separators &= separators - 1;		// clear the lowest bit
+		}
+	}
+#endif
+	// the bytes left (all of them without SSE2)
+	for (; i < length; ++i)
+	{
+		if (!isKeyDigit(text[i]))
+		{
+			if (i > start)
+			{
+				keys[count++] = keyFromDigits(text + start, i - start);
+			}
+			start = i + 1;
+		}
+	}
+	if (length > start)
+	{
+		keys[count++] = keyFromDigits(text + start, length - start);
+	}
+	return count;
+}
+
+inline bool loadKeyFile(const char* name, std::vector<unsigned char>& keys)
+{
+	MappedFile file(name);
+	if (!file.isOpen())
+	{
+		return false;
+	}
+	keys.resize(maxKeyCount(file.size()));
+	keys.resize(parseKeys(file.data(), file.size(), &keys[0]));
+	return true;
+}
+
+#endif
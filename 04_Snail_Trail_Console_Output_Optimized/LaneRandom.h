@@ -0,0 +1,417 @@
+/* Random numbers for NUM_LANES games played side by side (see "SnailEngine.h"): every game gets a stream of its own,
+and the streams of all games are stepped together, with AVX2 instructions where the compiler allows them, or else with
+SSE2 (which every x64 compiler, and Visual Studio 2012 for x86 by default, allows), four lanes at a time.
+
+Use the following procedures/functions for the following results:
+
+LaneRandom random to hold NUM_LANES random number generators (xoshiro128**)
+seedLanes(random, seed, batch) to seed them, lane 'lane' gets a stream that only depends on seed, batch and lane
+nextLanes(random, numbers) to draw one number in [0..2^32) for every lane
+LaneRange range = makeLaneRange(n) to prepare drawing numbers in [0..n) (n > 0)
+boundedLanes(random, range, numbers) to draw one number in [0..n) for every lane
+nextLane(random, lane) and boundedLane(random, lane, range) to draw a number for a single lane, giving the same numbers
+	as the functions for all lanes
+generateLaneLayouts(random, layouts) to draw the positions of a new game for every lane, in the garden of the rules of
+	the layouts
+drawLaneStrikes(random, eagles) to draw whether the eagle gets each frog of every lane in the next iteration of the
+	game loop, into a LaneEagle per lane
+
+Numbers in a range are drawn with Lemire's method: the upper half of number * n is in [0..n), and only a number whose
+lower half is below (2^32 - n) % n is drawn again (the threshold is worked out by makeLaneRange, so drawing needs no
+division). This happens for less than n in 2^32 numbers, so a lane that has to draw again does so on its own, and the
+streams of the other lanes are not disturbed: every lane draws exactly the same numbers whatever the other lanes do.
+*/
+
+#ifndef LANE_RANDOM_H
+#define LANE_RANDOM_H
+
+#include <cstring>           //for memset
+#ifdef __AVX2__
+#include <immintrin.h>       //for AVX2 intrinsics
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LANE_RANDOM_SSE2
+#include <emmintrin.h>       //for SSE2 intrinsics
+#endif
+
+#include "SnailEngine.h"     //for BasicGameLayout, SNAIL_ALIGN, etc.
+
+// number of games played side by side (32 bit numbers in an AVX2 register)
+const int NUM_LANES(8);
+
+struct SNAIL_ALIGN(32) LaneRandom
+{
+	unsigned int s[4][NUM_LANES];	// state of xoshiro128**, one column per lane
+};
+
+struct LaneRange
+{
+	unsigned int range;
+	unsigned int threshold;		// (2^32 - range) % range, the lower halves that have to be drawn again
+};
+
+inline unsigned long long splitMix64(unsigned long long& x)
+{
+	unsigned long long z = (x += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+inline void seedLanes(LaneRandom& random, unsigned long long seed, unsigned long long batch)
+{
+	for (int lane = 0; lane < NUM_LANES; ++lane)
+	{
+		// mix seed, batch and lane, then fill the state from the mix
+		unsigned long long x = seed;
+		x = splitMix64(x) ^ batch;
+		x = splitMix64(x) ^ static_cast<unsigned long long>(lane);
+		const unsigned long long a = splitMix64(x);
+		const unsigned long long b = splitMix64(x);
+		random.s[0][lane] = static_cast<unsigned int>(a);
+		random.s[1][lane] = static_cast<unsigned int>(a >> 32);
+		random.s[2][lane] = static_cast<unsigned int>(b);
+		random.s[3][lane] = static_cast<unsigned int>(b >> 32) | 1u;		// xoshiro must not start at zero
+	}
+}
+
+inline LaneRange makeLaneRange(unsigned int n)
+{
+	LaneRange range;
+	range.range = n;
+	range.threshold = (0u - n) % n;
+	return range;
+}
+
+inline unsigned int rotateLeft(unsigned int x, int k)
+{
+	return (x << k) | (x >> (32 - k));
+}
+
+inline unsigned int nextLane(LaneRandom& random, int lane)
+{
+	unsigned int* s0 = &random.s[0][lane];
+	unsigned int* s1 = &random.s[1][lane];
+	unsigned int* s2 = &random.s[2][lane];
+	unsigned int* s3 = &random.s[3][lane];
+
+	const unsigned int result = rotateLeft(*s1 * 5, 7) * 9;
+	const unsigned int t = *s1 << 9;
+	*s2 ^= *s0;
+	*s3 ^= *s1;
+	*s1 ^= *s2;
+	*s0 ^= *s3;
+	*s2 ^= t;
+	*s3 = rotateLeft(*s3, 11);
+	return result;
+}
+
+inline unsigned int boundedLane(LaneRandom& random, int lane, const LaneRange& range)
+{
+	unsigned long long m = static_cast<unsigned long long>(nextLane(random, lane)) * range.range;
+	while (static_cast<unsigned int>(m) < range.threshold)
+	{
+		m = static_cast<unsigned long long>(nextLane(random, lane)) * range.range;
+	}
+	return static_cast<unsigned int>(m >> 32);
+}
+
+// all lanes without AVX2 (the loop is written so that the compiler can vectorise it for the instructions it may use)
+inline void nextLanesPortable(LaneRandom& random, unsigned int numbers[NUM_LANES])
+{
+	for (int lane = 0; lane < NUM_LANES; ++lane)
+	{
+		numbers[lane] = nextLane(random, lane);
+	}
+}
+
+inline void boundedLanesPortable(LaneRandom& random, const LaneRange& range, unsigned int numbers[NUM_LANES])
+{
+	for (int lane = 0; lane < NUM_LANES; ++lane)
+	{
+		numbers[lane] = boundedLane(random, lane, range);
+	}
+}
+
+#ifdef __AVX2__
+
+template <int K>
+inline __m256i rotateLeft(__m256i x)
+{
+	return _mm256_or_si256(_mm256_slli_epi32(x, K), _mm256_srli_epi32(x, 32 - K));
+}
+
+// one step of all lanes, x * 5 and x * 9 as shift and add
+inline __m256i nextLanes(LaneRandom& random)
+{
+	__m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(random.s[0]));
+	__m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(random.s[1]));
+	__m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(random.s[2]));
+	__m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(random.s[3]));
+
+	const __m256i times5 = _mm256_add_epi32(_mm256_slli_epi32(s1, 2), s1);
+	const __m256i rotated = rotateLeft<7>(times5);
+	const __m256i result = _mm256_add_epi32(_mm256_slli_epi32(rotated, 3), rotated);
+
+	const __m256i t = _mm256_slli_epi32(s1, 9);
+	s2 = _mm256_xor_si256(s2, s0);
+	s3 = _mm256_xor_si256(s3, s1);
+	s1 = _mm256_xor_si256(s1, s2);
+	s0 = _mm256_xor_si256(s0, s3);
+	s2 = _mm256_xor_si256(s2, t);
+	s3 = rotateLeft<11>(s3);
+
+	_mm256_store_si256(reinterpret_cast<__m256i*>(random.s[0]), s0);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(random.s[1]), s1);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(random.s[2]), s2);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(random.s[3]), s3);
+	return result;
+}
+
+inline void nextLanes(LaneRandom& random, unsigned int numbers[NUM_LANES])
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(numbers), nextLanes(random));
+}
+
+inline void boundedLanes(LaneRandom& random, const LaneRange& range, unsigned int numbers[NUM_LANES])
+{
+	const __m256i x = nextLanes(random);
+	const __m256i n = _mm256_set1_epi32(static_cast<int>(range.range));
+
+	// 32 x 32 bit products of the even and the odd lanes
+	const __m256i even = _mm256_mul_epu32(x, n);
+	const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), n);
+	const __m256i high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(numbers), high);
+
+	if (range.threshold != 0)
+	{
+		// lanes whose lower half is below the threshold (unsigned, so both sides are flipped to signed)
+		const __m256i low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+		const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+		const __m256i below = _mm256_cmpgt_epi32(_mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(range.threshold)), sign),
+			_mm256_xor_si256(low, sign));
+		int again = _mm256_movemask_ps(_mm256_castsi256_ps(below));
+		for (int lane = 0; again != 0; ++lane, again >>= 1)
+		{
+			if (again & 1)
+			{
+				numbers[lane] = boundedLane(random, lane, range);
+			}
+		}
+	}
+}
+
+#elif defined(LANE_RANDOM_SSE2)
+
+template <int K>
+inline __m128i rotateLeft(__m128i x)
+{
+	return _mm_or_si128(_mm_slli_epi32(x, K), _mm_srli_epi32(x, 32 - K));
+}
+
+// one step of the four lanes from 'first' on, as the AVX2 version does for all eight
+inline __m128i nextLanes(LaneRandom& random, int first)
+{
+	__m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(&random.s[0][first]));
+	__m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(&random.s[1][first]));
+	__m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(&random.s[2][first]));
+	__m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(&random.s[3][first]));
+
+	const __m128i times5 = _mm_add_epi32(_mm_slli_epi32(s1, 2), s1);
+	const __m128i rotated = rotateLeft<7>(times5);
+	const __m128i result = _mm_add_epi32(_mm_slli_epi32(rotated, 3), rotated);
+
+	const __m128i t = _mm_slli_epi32(s1, 9);
+	s2 = _mm_xor_si128(s2, s0);
+	s3 = _mm_xor_si128(s3, s1);
+	s1 = _mm_xor_si128(s1, s2);
+	s0 = _mm_xor_si128(s0, s3);
+	s2 = _mm_xor_si128(s2, t);
+	s3 = rotateLeft<11>(s3);
+
+	_mm_store_si128(reinterpret_cast<__m128i*>(&random.s[0][first]), s0);
+	_mm_store_si128(reinterpret_cast<__m128i*>(&random.s[1][first]), s1);
+	_mm_store_si128(reinterpret_cast<__m128i*>(&random.s[2][first]), s2);
+	_mm_store_si128(reinterpret_cast<__m128i*>(&random.s[3][first]), s3);
+	return result;
+}
+
+inline void nextLanes(LaneRandom& random, unsigned int numbers[NUM_LANES])
+{
+	for (int first = 0; first < NUM_LANES; first += 4)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(numbers + first), nextLanes(random, first));
+	}
+}
+
+inline void boundedLanes(LaneRandom& random, const LaneRange& range, unsigned int numbers[NUM_LANES])
+{
+	const __m128i n = _mm_set1_epi32(static_cast<int>(range.range));
+	const __m128i upper = _mm_set_epi32(-1, 0, -1, 0);		// the upper halves of two 64 bit products
+	for (int first = 0; first < NUM_LANES; first += 4)
+	{
+		const __m128i x = nextLanes(random, first);
+
+		// 32 x 32 bit products of the even and the odd lanes, without the blend of SSE4.1
+		const __m128i even = _mm_mul_epu32(x, n);
+		const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), n);
+		const __m128i high = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_and_si128(odd, upper));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(numbers + first), high);
+
+		if (range.threshold != 0)
+		{
+			const __m128i low = _mm_or_si128(_mm_andnot_si128(upper, even), _mm_slli_epi64(odd, 32));
+			const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+			const __m128i below = _mm_cmpgt_epi32(_mm_xor_si128(_mm_set1_epi32(static_cast<int>(range.threshold)), sign),
+				_mm_xor_si128(low, sign));
+			int again = _mm_movemask_ps(_mm_castsi128_ps(below));
+			for (int lane = first; again != 0; ++lane, again >>= 1)
+			{
+				if (again & 1)
+				{
+					numbers[lane] = boundedLane(random, lane, range);
+				}
+			}
+		}
+	}
+}
+
+#else
+
+inline void nextLanes(LaneRandom& random, unsigned int numbers[NUM_LANES])
+{
+	nextLanesPortable(random, numbers);
+}
+
+inline void boundedLanes(LaneRandom& random, const LaneRange& range, unsigned int numbers[NUM_LANES])
+{
+	boundedLanesPortable(random, range, numbers);
+}
+
+#endif
+
+/***************************************************************************************
+Games in lanes
+****************************************************************************************/
+
+// draws a position in the garden of the rules for every lane, those that are taken in a lane's garden (not BLANK) are
+// drawn again for that lane only
+template <class Rules>
+inline void drawLanePositions(LaneRandom& random, const char taken[NUM_LANES][Rules::SIZEY][Rules::SIZEX],
+	int positions[NUM_LANES][2])
+{
+	static const LaneRange rangeY = makeLaneRange(Rules::SIZEY - 2);
+	static const LaneRange rangeX = makeLaneRange(Rules::SIZEX - 2);
+
+	unsigned int ys[NUM_LANES];
+	unsigned int xs[NUM_LANES];
+	boundedLanes(random, rangeY, ys);
+	boundedLanes(random, rangeX, xs);
+
+	for (int lane = 0; lane < NUM_LANES; ++lane)
+	{
+		int y = static_cast<int>(ys[lane]) + 1;
+		int x = static_cast<int>(xs[lane]) + 1;
+		while (taken[lane][y][x] != BLANK)
+		{
+			y = static_cast<int>(boundedLane(random, lane, rangeY)) + 1;
+			x = static_cast<int>(boundedLane(random, lane, rangeX)) + 1;
+		}
+		positions[lane][0] = y;
+		positions[lane][1] = x;
+	}
+}
+
+// the positions of the snail, pellets, lettuces and frogs for a new game in every lane
+template <class Rules>
+void generateLaneLayouts(LaneRandom& random, BasicGameLayout<Rules> layouts[NUM_LANES])
+{
+	// what has been placed so far in every lane
+	char taken[NUM_LANES][Rules::SIZEY][Rules::SIZEX];
+	memset(taken, BLANK, sizeof(taken));
+	int positions[NUM_LANES][2];
+
+	drawLanePositions<Rules>(random, taken, positions);
+	for (int lane = 0; lane < NUM_LANES; ++lane)
+	{
+		layouts[lane].snail[0] = positions[lane][0];
+		layouts[lane].snail[1] = positions[lane][1];
+		taken[lane][positions[lane][0]][positions[lane][1]] = SNAIL;
+	}
+
+	for (int slugP = 0; slugP < Rules::NUM_PELLETS; ++slugP)
+	{
+		drawLanePositions<Rules>(random, taken, positions);		// avoid snail and other pellets
+		for (int lane = 0; lane < NUM_LANES; ++lane)
+		{
+			layouts[lane].pellets[slugP][0] = positions[lane][0];
+			layouts[lane].pellets[slugP][1] = positions[lane][1];
+			taken[lane][positions[lane][0]][positions[lane][1]] = PELLET;
+		}
+	}
+
+	for (int lettuce = 0; lettuce < Rules::LETTUCE_QUOTA; ++lettuce)
+	{
+		drawLanePositions<Rules>(random, taken, positions);		// avoid snail, pellets and other lettucii
+		for (int lane = 0; lane < NUM_LANES; ++lane)
+		{
+			layouts[lane].lettuces[lettuce][0] = positions[lane][0];
+			layouts[lane].lettuces[lettuce][1] = positions[lane][1];
+			taken[lane][positions[lane][0]][positions[lane][1]] = LETTUCE;
+		}
+	}
+
+	// frogs only avoid the snail and each other (they may sit on pellets and lettuces)
+	char frogsTaken[NUM_LANES][Rules::SIZEY][Rules::SIZEX];
+	memset(frogsTaken, BLANK, sizeof(frogsTaken));
+	for (int lane = 0; lane < NUM_LANES; ++lane)
+	{
+		frogsTaken[lane][layouts[lane].snail[0]][layouts[lane].snail[1]] = SNAIL;
+	}
+	for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+	{
+		drawLanePositions<Rules>(random, frogsTaken, positions);
+		for (int lane = 0; lane < NUM_LANES; ++lane)
+		{
+			layouts[lane].frogs[frog * 2] = positions[lane][0];
+			layouts[lane].frogs[frog * 2 + 1] = positions[lane][1];
+			frogsTaken[lane][positions[lane][0]][positions[lane][1]] = FROG;
+		}
+	}
+}
+
+// an eagle that strikes as drawn by drawLaneStrikes for its lane
+template <class Rules>
+struct LaneEagle
+{
+	bool hits[Rules::NUM_FROGS];
+
+	void onSpawn(BasicGameState<Rules>&, int)
+	{
+	}
+
+	bool strikes(BasicGameState<Rules>&, int frog)
+	{
+		return hits[frog];
+	}
+};
+
+// whether the eagle gets each frog in the next iteration, a 1 in EagleStrike chance, drawn for every frog whether it
+// moves or not, so that every lane draws the same amount of numbers
+template <class Rules>
+void drawLaneStrikes(LaneRandom& random, LaneEagle<Rules> eagles[NUM_LANES])
+{
+	static const LaneRange range = makeLaneRange(Rules::EagleStrike);
+
+	unsigned int numbers[NUM_LANES];
+	for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+	{
+		boundedLanes(random, range, numbers);
+		for (int lane = 0; lane < NUM_LANES; ++lane)
+		{
+			eagles[lane].hits[frog] = numbers[lane] == 0;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,152 @@
+/* A histogram of latencies (or any other times in nanoseconds) that takes every sample in constant time and memory,
+however many there are.
+
+Use the following procedures/functions for the following results:
+
+LatencyHistogram histogram to hold the samples, histogram.clear() to start again
+histogram.add(nanoseconds) to add a sample
+histogram.merge(other) to add all samples of another histogram (e.g. one of another thread)
+histogram.count, histogram.mean(), histogram.max and histogram.percentile(p) for the number of samples, their mean,
+	the longest and the time p percent of the samples are below
+showHistogram(name, histogram) to print the percentiles, and a bar for every bucket with samples in it
+
+Every power of two is split into LATENCY_SUB_BUCKETS buckets of the same width, so a sample is counted in a bucket at
+most 1/8 wider than the sample itself (times below 8 ns have a bucket each). Percentiles are given as the upper end of
+their bucket, so they are never too low by more than that. The mean and the longest time are kept exactly.
+*/
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdio>            //for printf
+#include <cstring>           //for memset
+
+// buckets per power of two, and buckets for times up to 2^63 ns
+const int LATENCY_SUB_BUCKETS(8);
+const int NUM_LATENCY_BUCKETS(61 * LATENCY_SUB_BUCKETS);
+
+// the position of the highest bit set (value > 0)
+inline int highestBit(unsigned long long value)
+{
+	int bit(0);
+	for (int shift = 32; shift > 0; shift >>= 1)
+	{
+		if (value >> shift)
+		{
+			value >>= shift;
+			bit += shift;
+		}
+	}
+	return bit;
+}
+
+inline int latencyBucket(long long nanoseconds)
+{
+	if (nanoseconds < LATENCY_SUB_BUCKETS)
+	{
+		return nanoseconds < 0 ? 0 : static_cast<int>(nanoseconds);
+	}
+	const int bit = highestBit(static_cast<unsigned long long>(nanoseconds));		// at least 3
+	const int sub = static_cast<int>(nanoseconds >> (bit - 3)) & (LATENCY_SUB_BUCKETS - 1);
+	return (bit - 2) * LATENCY_SUB_BUCKETS + sub;
+}
+
+// the lowest time counted in a bucket
+inline long long bucketStart(int bucket)
+{
+	if (bucket < LATENCY_SUB_BUCKETS)
+	{
+		return bucket;
+	}
+	const int bit = bucket / LATENCY_SUB_BUCKETS + 2;
+	return static_cast<long long>(LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS) << (bit - 3);
+}
+
+struct LatencyHistogram
+{
+	long long counts[NUM_LATENCY_BUCKETS];
+	long long count;
+	long long sum;
+	long long max;
+
+	LatencyHistogram()
+	{
+		clear();
+	}
+
+	void clear()
+	{
+		memset(counts, 0, sizeof(counts));
+		count = 0;
+		sum = 0;
+		max = 0;
+	}
+
+	void add(long long nanoseconds)
+	{
+		++counts[latencyBucket(nanoseconds)];
+		++count;
+		sum += nanoseconds;
+		max = nanoseconds > max ? nanoseconds : max;
+	}
+
+	void merge(const LatencyHistogram& other)
+	{
+		for (int bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket)
+		{
+			counts[bucket] += other.counts[bucket];
+		}
+		count += other.count;
+		sum += other.sum;
+		max = other.max > max ? other.max : max;
+	}
+
+	double mean() const
+	{
+		return count > 0 ? static_cast<double>(sum) / count : 0.0;
+	}
+
+	long long percentile(double p) const
+	{
+		const double wanted = count * p / 100.0;
+		long long seen(0);
+		for (int bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket)
+		{
+			seen += counts[bucket];
+			if (seen > 0 && seen >= wanted)
+			{
+				const long long end = bucketStart(bucket + 1);
+				return end < max ? end : max;
+			}
+		}
+		return max;
+	}
+};
+
+// prints the percentiles in microseconds, and a bar of up to 50 '#' for every bucket with samples
+inline void showHistogram(const char* name, const LatencyHistogram& histogram)
+{
+	printf("%s: %lld samples, mean %.1f us, 50%% %.1f us, 90%% %.1f us, 99%% %.1f us, 99.9%% %.1f us, max %.1f us\n", name,
+		histogram.count, histogram.mean() / 1000.0, histogram.percentile(50.0) / 1000.0, histogram.percentile(90.0) / 1000.0,
+		histogram.percentile(99.0) / 1000.0, histogram.percentile(99.9) / 1000.0, histogram.max / 1000.0);
+
+	long long highest(0);
+	for (int bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket)
+	{
+		highest = histogram.counts[bucket] > highest ? histogram.counts[bucket] : highest;
+	}
+	for (int bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket)
+	{
+		if (histogram.counts[bucket] > 0)
+		{
+			char bar[51];
+			const int length = static_cast<int>((histogram.counts[bucket] * 50 + highest - 1) / highest);
+			memset(bar, '#', length);
+			bar[length] = '\0';
+			printf("  %10.1f - %10.1f us %8lld %s\n", bucketStart(bucket) / 1000.0, bucketStart(bucket + 1) / 1000.0,
+				histogram.counts[bucket], bar);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,187 @@
+/* A pool of games (see "SnailEngine.h") set up in advance by a thread of its own, so that starting another game only
+takes copying one that is ready.
+
+Use the following procedures/functions for the following results:
+
+LayoutPool pool(firstSeed, capacity) to start a thread that sets up the games seeded with firstSeed, firstSeed + 1, etc.
+	and keeps up to 'capacity' of them ready
+pool.restart(state) to copy the next game into state, returns its seed (if it is not ready yet, the game is set up on
+	the spot, exactly as the thread would have done)
+pool.hits() and pool.misses() for the number of games that were ready and that had to be set up on the spot
+
+Game number n is always seedGame(state, firstSeed + n) followed by initialiseGame(state), whether it came from the pool
+or not, so a run does not depend on how fast the thread is. The games are kept in a ring buffer in cache line aligned
+memory, which the thread fills and restart empties without taking a lock: each of them only moves its own end of the
+ring forward, after it is done with the game in between. The thread sets up every game straight into the ring, starting
+from the game restart is going to ask for next, so games that were set up on the spot are skipped (and one the thread
+was already working on is thrown away by restart). While the ring is full the thread waits, restart wakes it up once
+the ring is half empty. The thread notes that it is waiting under the lock and then looks at the ring once more, and
+restart moves its end of the ring before it looks at that note, taking the lock to wake the thread (both in sequential
+order), so either the thread sees the games taken or restart sees the thread waiting and a wake-up cannot be lost.
+restart only takes the lock when the thread is waiting.
+*/
+
+#ifndef LAYOUT_POOL_H
+#define LAYOUT_POOL_H
+
+#include <atomic>            //for atomic
+#include <cassert>           //for assert
+#include <cstdlib>
+#include <cstring>           //for memcpy
+#include <mutex>             //for mutex
+#include <condition_variable>
+#include <thread>            //for thread
+#ifdef _WIN32
+#include <malloc.h>          //for _aligned_malloc
+#endif
+
+#include "SnailEngine.h"     //for BasicGameState, seedGame, initialiseGame
+
+template <class Rules>
+class BasicLayoutPool
+{
+private:
+	BasicGameState<Rules>* games;	// ring buffer of games set up in advance
+	unsigned int* numbers;			// the number of the game in each slot of the ring
+	unsigned int capacity;
+	unsigned int firstSeed;
+
+	std::atomic<unsigned int> head;		// games taken from the ring so far (moved on by restart)
+	std::atomic<unsigned int> tail;		// games put into the ring so far (moved on by the thread)
+	std::atomic<unsigned int> nextGame;	// number of the game restart is going to ask for next
+
+	unsigned long long hitCount;
+	unsigned long long missCount;
+
+	std::mutex waitMutex;
+	std::condition_variable notFull;
+	std::atomic<bool> waiting;		// the thread waits for the ring to be half empty
+	std::atomic<bool> stopping;
+	std::thread producer;
+
+	// not to be copied, the thread belongs to a single pool
+	BasicLayoutPool(const BasicLayoutPool&);
+	BasicLayoutPool& operator=(const BasicLayoutPool&);
+
+	void produce()
+	{
+		unsigned int number(0);
+		while (!stopping.load())
+		{
+			const unsigned int slot = tail.load(std::memory_order_relaxed);
+			if (slot - head.load(std::memory_order_acquire) == capacity)
+			{
+				std::unique_lock<std::mutex> lock(waitMutex);
+				waiting.store(true);
+				while (!stopping.load() && slot - head.load() > capacity / 2)
+				{
+					notFull.wait(lock);
+				}
+				waiting.store(false);
+				continue;
+			}
+
+			// no need to set up games that restart has gone past
+			const unsigned int wanted = nextGame.load(std::memory_order_relaxed);
+			if (number < wanted)
+			{
+				number = wanted;
+			}
+
+			seedGame(games[slot % capacity], firstSeed + number);
+			initialiseGame(games[slot % capacity]);
+			numbers[slot % capacity] = number++;
+			tail.store(slot + 1, std::memory_order_release);
+		}
+	}
+
+public:
+	BasicLayoutPool(unsigned int firstSeed, unsigned int capacity) : games(0), numbers(new unsigned int[capacity]),
+		capacity(capacity), firstSeed(firstSeed), head(0), tail(0), nextGame(0), hitCount(0), missCount(0), waiting(false),
+		stopping(false)
+	{
+#ifdef _WIN32
+		games = static_cast<BasicGameState<Rules>*>(_aligned_malloc(capacity * sizeof(BasicGameState<Rules>), CACHE_LINE));
+#else
+		void* memory(0);
+		if (posix_memalign(&memory, CACHE_LINE, capacity * sizeof(BasicGameState<Rules>)) == 0)
+		{
+			games = static_cast<BasicGameState<Rules>*>(memory);
+		}
+#endif
+		assert(games != 0 && capacity > 0);
+		producer = std::thread(&BasicLayoutPool::produce, this);
+	}
+
+	~BasicLayoutPool()
+	{
+		stopping.store(true);
+		{
+			std::lock_guard<std::mutex> lock(waitMutex);
+			notFull.notify_one();
+		}
+		producer.join();
+#ifdef _WIN32
+		_aligned_free(games);
+#else
+		free(games);
+#endif
+		delete[] numbers;
+	}
+
+	unsigned int restart(BasicGameState<Rules>& state)
+	{
+		const unsigned int wanted = nextGame.load(std::memory_order_relaxed);
+		nextGame.store(wanted + 1, std::memory_order_relaxed);
+
+		unsigned int slot = head.load(std::memory_order_relaxed);
+		const unsigned int end = tail.load(std::memory_order_acquire);
+		bool ready(false);
+		while (slot != end && numbers[slot % capacity] <= wanted)
+		{
+			// games before the one wanted were set up on the spot while the thread was working on them
+			ready = numbers[slot % capacity] == wanted;
+			if (ready)
+			{
+				memcpy(&state, &games[slot % capacity], sizeof(state));
+			}
+			++slot;
+			if (ready)
+			{
+				break;
+			}
+		}
+		head.store(slot);
+		if (end - slot <= capacity / 2 && waiting.load())
+		{
+			std::lock_guard<std::mutex> lock(waitMutex);
+			notFull.notify_one();
+		}
+
+		if (ready)
+		{
+			++hitCount;
+		}
+		else
+		{
+			++missCount;
+			seedGame(state, firstSeed + wanted);
+			initialiseGame(state);
+		}
+		return firstSeed + wanted;
+	}
+
+	unsigned long long hits() const
+	{
+		return hitCount;
+	}
+
+	unsigned long long misses() const
+	{
+		return missCount;
+	}
+};
+
+typedef BasicLayoutPool<StandardRules> LayoutPool;
+
+#endif
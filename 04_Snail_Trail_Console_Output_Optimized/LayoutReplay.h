@@ -0,0 +1,303 @@
+/* Recordings of games (see "SnailEngine.h") that hold everything needed to play them again: the layout of the garden,
+the keys pressed and whether the eagle got a frog each time it tried. A game played from such a replay does not draw
+any random numbers, so replays stay valid when the initialisation or the random numbers of the game code change.
+
+Use the following procedures/functions for the following results:
+
+EagleLog log to hold the tries of the eagle, one bit each (1 if it got the frog)
+RecordingEagle eagle(log) for an eagle that strikes like RandomEagle and writes every try to the log
+ReplayEagle eagle(log) for an eagle that strikes exactly as written in the log
+writeReplay(out, games) to write a list of ReplayGames to a stream
+readReplay(in, games) to read a list of ReplayGames from a stream, returns false if it is not a replay (also if a
+	position of a layout is not inside the garden walls, or a try of the eagle is not a hex digit)
+playReplay(state, game) to play a ReplayGame from its layout, returns false if the eagle tried more or less often than
+	written in the log (i.e. the game did not go as recorded)
+
+A replay is a text file with three lines per game:
+layout snailY,snailX pellet1Y,pellet1X,... lettuce1Y,lettuce1X,... frog1Y,frog1X,frog2Y,frog2X
+keys 75,77,...            (the key codes of "Keys.txt", ending with 113 if the game was quit)
+eagle tries hexDigits     (the number of tries and the tries as hex digits, the first try in the lowest bit)
+*/
+
+#ifndef LAYOUT_REPLAY_H
+#define LAYOUT_REPLAY_H
+
+#include <iostream>          //for istream and ostream
+#include <string>            //for string
+#include <vector>            //for vector
+
+#include "SnailEngine.h"     //for GameState, GameLayout, stepGame, etc.
+
+class EagleLog
+{
+private:
+	std::vector<unsigned char> bits;	// four tries per element, as they are written as a hex digit
+	unsigned int tries;
+
+public:
+	EagleLog() : tries(0)
+	{
+	}
+
+	void push(bool strike)
+	{
+		if (tries % 4 == 0)
+		{
+			bits.push_back(0);
+		}
+		bits.back() |= static_cast<unsigned char>(strike) << (tries % 4);
+		++tries;
+	}
+
+	bool operator[](unsigned int i) const
+	{
+		return (bits[i / 4] >> (i % 4)) & 1;
+	}
+
+	unsigned int size() const
+	{
+		return tries;
+	}
+
+	void clear()
+	{
+		bits.clear();
+		tries = 0;
+	}
+
+	friend std::ostream& operator<<(std::ostream&, const EagleLog&);
+	friend std::istream& operator>>(std::istream&, EagleLog&);
+};
+
+inline std::ostream& operator<<(std::ostream& out, const EagleLog& log)
+{
+	const char digits[] = "0123456789abcdef";
+	out << log.tries << " ";
+	for (size_t i = 0; i < log.bits.size(); ++i)
+	{
+		out << digits[log.bits[i]];
+	}
+	return out;
+}
+
+inline std::istream& operator>>(std::istream& in, EagleLog& log)
+{
+	log.clear();
+	std::string digits;
+	in >> log.tries;
+	if (log.tries > 0)
+	{
+		in >> digits;
+	}
+	for (size_t i = 0; i < digits.size(); ++i)
+	{
+		const char digit = digits[i];
+		if (!(digit >= '0' && digit <= '9') && !(digit >= 'a' && digit <= 'f'))
+		{
+			in.setstate(std::ios::failbit);
+			return in;
+		}
+		log.bits.push_back(static_cast<unsigned char>(digit <= '9' ? digit - '0' : digit - 'a' + 10));
+	}
+	if (log.bits.size() != (log.tries + 3) / 4)
+	{
+		in.setstate(std::ios::failbit);
+	}
+	return in;
+}
+
+// strikes like RandomEagle and keeps a log of it
+struct RecordingEagle
+{
+	EagleLog& log;
+
+	explicit RecordingEagle(EagleLog& log) : log(log)
+	{
+	}
+
+	template <class State>
+	void onSpawn(State&, int)
+	{
+	}
+
+	template <class State>
+	bool strikes(State& state, int frog)
+	{
+		RandomEagle eagle;
+		const bool strike = eagle.strikes(state, frog);
+		log.push(strike);
+		return strike;
+	}
+};
+
+// strikes as written in a log, never strikes once the log has run out
+struct ReplayEagle
+{
+	const EagleLog& log;
+	unsigned int next;
+
+	explicit ReplayEagle(const EagleLog& log) : log(log), next(0)
+	{
+	}
+
+	template <class State>
+	void onSpawn(State&, int)
+	{
+	}
+
+	template <class State>
+	bool strikes(State&, int)
+	{
+		const bool strike = next < log.size() && log[next];
+		++next;
+		return strike;
+	}
+};
+
+// one game of a replay
+struct ReplayGame
+{
+	GameLayout layout;
+	std::vector<int> keys;		// key codes as read by getKeyPress
+	EagleLog eagle;
+};
+
+/***************************************************************************************
+Reading and writing
+****************************************************************************************/
+
+// writes a list of numbers separated by commas
+inline void writeNumbers(std::ostream& out, const int* numbers, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		out << (i > 0 ? "," : "") << numbers[i];
+	}
+}
+
+// reads a list of numbers separated by commas
+inline bool readNumbers(std::istream& in, int* numbers, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		if (i > 0 && in.get() != ',')
+		{
+			return false;
+		}
+		in >> numbers[i];
+	}
+	return !in.fail();
+}
+
+// whether positions given as pairs of y and x are all inside the garden walls, so that they can be put into the garden
+inline bool positionsInGarden(const int* positions, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		if (positions[i * 2] < 1 || positions[i * 2] > SIZEY - 2 || positions[i * 2 + 1] < 1 ||
+			positions[i * 2 + 1] > SIZEX - 2)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+inline void writeReplay(std::ostream& out, const std::vector<ReplayGame>& games)
+{
+	for (size_t g = 0; g < games.size(); ++g)
+	{
+		const GameLayout& layout = games[g].layout;
+		out << "layout ";
+		writeNumbers(out, layout.snail, 2);
+		out << " ";
+		writeNumbers(out, &layout.pellets[0][0], NUM_PELLETS * 2);
+		out << " ";
+		writeNumbers(out, &layout.lettuces[0][0], LETTUCE_QUOTA * 2);
+		out << " ";
+		writeNumbers(out, layout.frogs, 4);
+		out << "\n";
+
+		out << "keys ";
+		for (size_t i = 0; i < games[g].keys.size(); ++i)
+		{
+			out << games[g].keys[i] << ",";
+		}
+		out << "\n";
+
+		out << "eagle " << games[g].eagle << "\n";
+	}
+}
+
+inline bool readReplay(std::istream& in, std::vector<ReplayGame>& games)
+{
+	games.clear();
+	std::string word;
+	while (in >> word)
+	{
+		ReplayGame game;
+		GameLayout& layout = game.layout;
+		if (word != "layout" || !readNumbers(in >> std::ws, layout.snail, 2) || !readNumbers(in >> std::ws, &layout.pellets[0][0], NUM_PELLETS * 2) ||
+			!readNumbers(in >> std::ws, &layout.lettuces[0][0], LETTUCE_QUOTA * 2) || !readNumbers(in >> std::ws, layout.frogs, 4))
+		{
+			return false;
+		}
+		if (!positionsInGarden(layout.snail, 1) || !positionsInGarden(&layout.pellets[0][0], NUM_PELLETS) ||
+			!positionsInGarden(&layout.lettuces[0][0], LETTUCE_QUOTA) || !positionsInGarden(layout.frogs, NUM_FROGS))
+		{
+			return false;		// setUpGame would write outside the garden
+		}
+
+		std::string keys;
+		if (!(in >> word) || word != "keys" || !std::getline(in, keys))
+		{
+			return false;
+		}
+		int key(0);
+		bool inKey(false);
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			if (keys[i] >= '0' && keys[i] <= '9')
+			{
+				key = key * 10 + (keys[i] - '0');
+				inKey = true;
+			}
+			else if (keys[i] == ',' && inKey)
+			{
+				game.keys.push_back(key);
+				key = 0;
+				inKey = false;
+			}
+		}
+
+		if (!(in >> word) || word != "eagle" || !(in >> game.eagle))
+		{
+			return false;
+		}
+		games.push_back(game);
+	}
+	return true;
+}
+
+/***************************************************************************************
+Playing
+****************************************************************************************/
+
+inline bool playReplay(GameState& state, const ReplayGame& game)
+{
+	setUpGame(state, game.layout);
+	ReplayEagle eagle(game.eagle);
+
+	for (size_t i = 0; i < game.keys.size() && !isGameOver(state); ++i)
+	{
+		const int key = translateKey(game.keys[i]);
+		if (key == 5)
+		{
+			break;		// quit
+		}
+		stepGame(state, key, eagle);
+	}
+	return eagle.next == game.eagle.size();
+}
+
+#endif
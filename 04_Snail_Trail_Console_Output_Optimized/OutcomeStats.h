@@ -0,0 +1,279 @@
+/* Statistics of how the games (see "SnailEngine.h") of a batch run went, collected by many threads at once without
+locks and without the threads slowing each other down.
+
+Use the following procedures/functions for the following results:
+
+gameOutcome(state) to find out how a game ended: won, killed by pellets, by a frog that landed on the snail or by
+	running into a frog, or not at all, if it was stopped because it took too long (outcomeNames[outcome] is its name);
+	OUTCOME_UNKNOWN if the snail is dead without a message of what killed it, which should never be
+OutcomeAggregator stats(shards) to collect the statistics of up to 'shards' threads, throws bad_alloc if there is no
+	memory for the shards
+	stats.shard(i).addGame(state, frames, eagleKills) for thread i to add a game that has ended after 'frames' frames,
+		in which the eagle got 'eagleKills' frogs (frogsEaten(state) of "SnailEngine.h")
+	stats.collect() to add up the shards into an OutcomeStats, at the end or while the threads are still adding games
+	stats.collect(first, count) to add up only the shards first to first + count - 1 (e.g. those of one of many runs)
+OutcomeStats for the statistics of a number of games: the games, frames, lettuces and frogs eaten by the eagle, the
+	games of every outcome and histograms of the frames survived and the lettuces eaten per game
+	stats.merge(other) to add the statistics of other games, e.g. of another run
+	stats.winRate() and stats.survivalPercentile(p) for the share of games won and the frames survived by p% of the games
+
+The messages of counters[0] at the end of a game tell how it ended: 1 for too many pellets, 6 for running into a frog
+and 8 for a frog landing on the snail; a game is won once LETTUCE_QUOTA lettuces are eaten, unless a frog lands on the
+snail in the same frame (version 12 shows "REST IN PEAS." then, playGames of "RulePresets.h" counts it as both).
+The frogs stop once the snail is dead, so no other message can follow these; gameOutcome asserts that there is none,
+and counts the game as OUTCOME_UNKNOWN in a release build, so that the counts show it instead of a wrong outcome.
+Every thread adds its games to a shard of its own, which no other thread writes to, so a count can be added to with a
+plain load and store instead of a locked instruction. The counts are atomics read and written with relaxed order all
+the same, so that collect can read them while they are written (a collection taken while games are added may hold the
+outcome of a game but not yet its frames, it is exact once the threads are done). Every shard starts on a cache line
+of its own and is padded to whole cache lines, so that the threads do not write to the same line. A game is added
+once it has ended, not every frame, so the statistics cost next to nothing compared with playing the game.
+The histograms count games in buckets: the frames survived in buckets of SURVIVAL_BUCKET_FRAMES frames (the last
+bucket holds all longer games), the lettuces eaten one bucket per number (the last holds all higher numbers).
+*/
+
+#ifndef OUTCOME_STATS_H
+#define OUTCOME_STATS_H
+
+#include <atomic>            //for atomic
+#include <cassert>           //for assert
+#include <cstdlib>           //for free, posix_memalign
+#include <cstring>           //for memset
+#include <new>               //for placement new, bad_alloc
+#ifdef _WIN32
+#include <malloc.h>          //for _aligned_malloc
+#endif
+
+#include "SnailEngine.h"     //for BasicGameState, CACHE_LINE, SNAIL_ALIGN
+
+// how a game ended
+enum Outcome
+{
+	OUTCOME_WON,
+	OUTCOME_PELLETS,			// slithered over too many pellets (message 1)
+	OUTCOME_FROG_LANDED,		// a frog landed on the snail (message 8)
+	OUTCOME_RAN_INTO_FROG,		// the snail ran into a frog (message 6)
+	OUTCOME_TIMEOUT,			// still going when the game was stopped
+	OUTCOME_UNKNOWN,			// dead without a message of what killed it (a bug of the engine)
+	NUM_OUTCOMES
+};
+
+const char* const outcomeNames[NUM_OUTCOMES] = {"won", "pellets", "frog landed", "ran into frog", "timeout",
+													"unknown"};
+
+// buckets of the histograms
+const int SURVIVAL_BUCKET_FRAMES(16);
+const int NUM_SURVIVAL_BUCKETS(64);
+const int NUM_LETTUCE_BUCKETS(16);
+
+template <class Rules>
+inline Outcome gameOutcome(const BasicGameState<Rules>& state)
+{
+	if (state.isSnailAlive)
+	{
+		return state.counters[3] == Rules::LETTUCE_QUOTA ? OUTCOME_WON : OUTCOME_TIMEOUT;
+	}
+	switch (state.counters[0])
+	{
+		case 1:
+			return OUTCOME_PELLETS;
+		case 6:
+			return OUTCOME_RAN_INTO_FROG;
+		case 8:
+			return OUTCOME_FROG_LANDED;
+		default:
+			assert(!"the snail is dead without a message of what killed it");
+			return OUTCOME_UNKNOWN;
+	}
+}
+
+struct OutcomeStats
+{
+	long long games;
+	long long frames;
+	long long lettuces;
+	long long eagleKills;
+	long long outcomes[NUM_OUTCOMES];
+	long long survival[NUM_SURVIVAL_BUCKETS];
+	long long lettuceCounts[NUM_LETTUCE_BUCKETS];
+
+	OutcomeStats()
+	{
+		memset(this, 0, sizeof(*this));
+	}
+
+	void merge(const OutcomeStats& other)
+	{
+		games += other.games;
+		frames += other.frames;
+		lettuces += other.lettuces;
+		eagleKills += other.eagleKills;
+		for (int i = 0; i < NUM_OUTCOMES; ++i)
+		{
+			outcomes[i] += other.outcomes[i];
+		}
+		for (int i = 0; i < NUM_SURVIVAL_BUCKETS; ++i)
+		{
+			survival[i] += other.survival[i];
+		}
+		for (int i = 0; i < NUM_LETTUCE_BUCKETS; ++i)
+		{
+			lettuceCounts[i] += other.lettuceCounts[i];
+		}
+	}
+
+	double winRate() const
+	{
+		return games > 0 ? static_cast<double>(outcomes[OUTCOME_WON]) / games : 0.0;
+	}
+
+	// the end of the bucket in which p% of the games have ended
+	int survivalPercentile(double p) const
+	{
+		const double wanted = games * p / 100.0;
+		long long seen(0);
+		for (int bucket = 0; bucket < NUM_SURVIVAL_BUCKETS; ++bucket)
+		{
+			seen += survival[bucket];
+			if (seen > 0 && seen >= wanted)
+			{
+				return (bucket + 1) * SURVIVAL_BUCKET_FRAMES;
+			}
+		}
+		return NUM_SURVIVAL_BUCKETS * SURVIVAL_BUCKET_FRAMES;
+	}
+};
+
+// the statistics of one thread
+struct SNAIL_ALIGN(64) OutcomeShard
+{
+	std::atomic<long long> games;
+	std::atomic<long long> frames;
+	std::atomic<long long> lettuces;
+	std::atomic<long long> eagleKills;
+	std::atomic<long long> outcomes[NUM_OUTCOMES];
+	std::atomic<long long> survival[NUM_SURVIVAL_BUCKETS];
+	std::atomic<long long> lettuceCounts[NUM_LETTUCE_BUCKETS];
+
+	OutcomeShard() : games(0), frames(0), lettuces(0), eagleKills(0)
+	{
+		for (int i = 0; i < NUM_OUTCOMES; ++i)
+		{
+			outcomes[i].store(0, std::memory_order_relaxed);
+		}
+		for (int i = 0; i < NUM_SURVIVAL_BUCKETS; ++i)
+		{
+			survival[i].store(0, std::memory_order_relaxed);
+		}
+		for (int i = 0; i < NUM_LETTUCE_BUCKETS; ++i)
+		{
+			lettuceCounts[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	// only the thread of the shard adds to it, so there is no need for fetch_add
+	static void increase(std::atomic<long long>& count, long long amount)
+	{
+		count.store(count.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	template <class Rules>
+	void addGame(const BasicGameState<Rules>& state, int numberOfFrames, int numberOfKills)
+	{
+		const int lettucesEaten = state.counters[3];
+		increase(frames, numberOfFrames);
+		increase(lettuces, lettucesEaten);
+		increase(eagleKills, numberOfKills);
+		increase(outcomes[gameOutcome(state)], 1);
+		const int bucket = numberOfFrames / SURVIVAL_BUCKET_FRAMES;
+		increase(survival[bucket < NUM_SURVIVAL_BUCKETS ? bucket : NUM_SURVIVAL_BUCKETS - 1], 1);
+		increase(lettuceCounts[lettucesEaten < NUM_LETTUCE_BUCKETS ? lettucesEaten : NUM_LETTUCE_BUCKETS - 1], 1);
+		increase(games, 1);
+	}
+
+	void addTo(OutcomeStats& stats) const
+	{
+		stats.games += games.load(std::memory_order_relaxed);
+		stats.frames += frames.load(std::memory_order_relaxed);
+		stats.lettuces += lettuces.load(std::memory_order_relaxed);
+		stats.eagleKills += eagleKills.load(std::memory_order_relaxed);
+		for (int i = 0; i < NUM_OUTCOMES; ++i)
+		{
+			stats.outcomes[i] += outcomes[i].load(std::memory_order_relaxed);
+		}
+		for (int i = 0; i < NUM_SURVIVAL_BUCKETS; ++i)
+		{
+			stats.survival[i] += survival[i].load(std::memory_order_relaxed);
+		}
+		for (int i = 0; i < NUM_LETTUCE_BUCKETS; ++i)
+		{
+			stats.lettuceCounts[i] += lettuceCounts[i].load(std::memory_order_relaxed);
+		}
+	}
+};
+
+class OutcomeAggregator
+{
+private:
+	OutcomeShard* shards;
+	int numberOfShards;
+
+	// not to be copied, the shards belong to a single aggregator
+	OutcomeAggregator(const OutcomeAggregator&);
+	OutcomeAggregator& operator=(const OutcomeAggregator&);
+
+public:
+	explicit OutcomeAggregator(int numberOfShards) : shards(0), numberOfShards(numberOfShards)
+	{
+#ifdef _WIN32
+		void* memory = _aligned_malloc(numberOfShards * sizeof(OutcomeShard), CACHE_LINE);
+#else
+		void* memory(0);
+		if (posix_memalign(&memory, CACHE_LINE, numberOfShards * sizeof(OutcomeShard)) != 0)
+		{
+			memory = 0;
+		}
+#endif
+		assert(numberOfShards > 0);
+		if (memory == 0)
+		{
+			throw std::bad_alloc();
+		}
+		shards = static_cast<OutcomeShard*>(memory);
+		for (int i = 0; i < numberOfShards; ++i)
+		{
+			new (&shards[i]) OutcomeShard();
+		}
+	}
+
+	~OutcomeAggregator()
+	{
+#ifdef _WIN32
+		_aligned_free(shards);
+#else
+		free(shards);
+#endif
+	}
+
+	OutcomeShard& shard(int i)
+	{
+		return shards[i];
+	}
+
+	OutcomeStats collect() const
+	{
+		return collect(0, numberOfShards);
+	}
+
+	OutcomeStats collect(int first, int count) const
+	{
+		OutcomeStats stats;
+		for (int i = first; i < first + count; ++i)
+		{
+			shards[i].addTo(stats);
+		}
+		return stats;
+	}
+};
+
+#endif
@@ -0,0 +1,469 @@
+/* Sweeps over a grid of rules for the game code of "SnailEngine.h": many games are played for every combination of a
+few values of EagleStrike, FROGLEAP, NUM_PELLETS, PELLET_THRESHOLD, SLIMELIFE and the garden size, on all threads, and
+the statistics of every combination (a cell of the grid) are collected with "OutcomeStats.h". A grid is either
+compiled, with the game code compiled for every cell, or read at run time and played with RuntimeRules.
+
+Use the following procedures/functions for the following results:
+
+SweepAxis<v0, v1, ...> for the values (up to four, all but 0) a rule takes in a sweep
+a grid, a structure with the SweepAxis types EagleStrikes, FrogLeaps, Pellets, Thresholds, SlimeLives, GardenRows and
+	GardenColumns (the garden sizes are the rows and columns with the same index)
+SweepTable<Grid>::NUM_CELLS and SweepTable<Grid>::fill(cells) for the number of cells of a grid and to write them into
+	an array of SweepCells: the values of the rules and the game code compiled for them
+SweepGrid for the values of a grid read at run time, one vector per axis
+readSweepGrid(in, grid) to read a grid from a stream, returns false if it cannot be read (see below for the format)
+makeRuntimeCells(grid, cells) to write the cells of a grid read at run time into a vector of SweepCells, played with
+	RuntimeRules, returns the first cell whose rules do not fit into RuntimeRules (see runtimeRulesFit), or -1
+runtimeCell(cell) for a cell with the rules of another cell, played with RuntimeRules (e.g. to compare the two)
+SweepPolicy policy = {keys, numberOfKeys} for the keys to play the games with in a loop (keys from 0 to 4), or
+	{0, 0} for the bot of "RulePresets.h"
+runSweep(cells, numberOfCells, gamesPerCell, maxFrames, policy, numberOfThreads, results) to play gamesPerCell games
+	of at most maxFrames frames for every cell, returns the SweepResult of every cell in results
+
+The rules are a template parameter of the game, so every cell of the grid is a set of rules of its own (SweepRules),
+with the game code compiled for it when the grid is compiled; changing the values of an axis takes a build, but a
+sweep over all cells does not. The cells are numbered with EagleStrikes changing fastest, the rules of a cell are
+worked out from its number by the compiler, and SweepTable fills the table of cells by splitting the range of cell
+numbers in halves, so that the templates are not nested deeper than the logarithm of the number of cells.
+The games of a sweep are handed out in blocks of SWEEP_BLOCK_GAMES games of one cell, the threads taking the next
+block from an atomic counter, one block of every cell in turn, so that all cells get on at the same pace. The games
+of block b are seeded with SWEEP_SEED + b in every cell, so the cells are compared on the same random numbers as far
+as their rules let them. Every thread adds its games to a shard of its own for each cell, and the time a thread spent
+on the blocks of a cell is added up for the cell, which gives the frames per second of one thread playing the cell.
+Every cell of a compiled grid is compiled code of its own, which takes the compiler some time per cell, so a compiled
+grid has to stay small (a few hundred cells). A larger grid is swept with RuntimeRules: one set of rules whose values
+are plain variables, set for one cell at a time, played by code compiled only once. Its slime trail, pellets and garden
+are made for up to RUNTIME_MAX_SLIMELIFE, RUNTIME_MAX_PELLETS and SIZEY by SIZEX, and the compiler cannot turn the
+modulus of the eagle into a mask, so its games may be slower (version 37 shows by how much). As there is only one
+RuntimeRules, the threads play the games of one cell of a run time grid at a time, and are joined before the next cell
+sets its values. With the same seeds, a cell played with RuntimeRules plays exactly the same games as the compiled cell
+with the same values.
+A grid read from a stream has a line for every axis, the name of the axis followed by its values: "eagle", "leap",
+"pellets", "threshold", "slime" and "garden" (with values such as 20x30, rows by columns); an axis left out takes the
+value of StandardRules, and lines starting with '#' are skipped.
+*/
+
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <atomic>            //for atomic
+#include <cassert>           //for assert
+#include <chrono>            //for steady_clock
+#include <cstdio>            //for sscanf
+#include <istream>           //for istream
+#include <sstream>           //for istringstream
+#include <string>            //for string, getline
+#include <thread>            //for thread
+#include <vector>            //for vector
+
+#include "SnailEngine.h"     //for BasicGameState, StandardRules, stepGame, etc.
+#include "RulePresets.h"     //for chooseBotKey, BotRandom
+#include "OutcomeStats.h"    //for OutcomeAggregator, OutcomeStats
+
+typedef std::chrono::steady_clock SweepClock;
+
+// games in a block handed out to a thread, and the seed of the first block
+const int SWEEP_BLOCK_GAMES(64);
+const unsigned int SWEEP_SEED(256);
+
+// the longest slime trail and the most pellets of RuntimeRules
+const int RUNTIME_MAX_SLIMELIFE(64);
+const int RUNTIME_MAX_PELLETS(64);
+
+template <int V0, int V1 = 0, int V2 = 0, int V3 = 0>
+struct SweepAxis
+{
+	static const int COUNT = 1 + (V1 != 0) + (V2 != 0) + (V3 != 0);
+
+	template <int I>
+	struct At
+	{
+		static const int value = I == 0 ? V0 : I == 1 ? V1 : I == 2 ? V2 : V3;
+	};
+};
+
+// the index of cell 'Cell' on every axis of a grid
+template <class Grid, int Cell>
+struct SweepIndex
+{
+	static const int EAGLE = Cell % Grid::EagleStrikes::COUNT;
+	static const int LEAP = Cell / Grid::EagleStrikes::COUNT % Grid::FrogLeaps::COUNT;
+	static const int PELLETS = Cell / (Grid::EagleStrikes::COUNT * Grid::FrogLeaps::COUNT) % Grid::Pellets::COUNT;
+	static const int THRESHOLD = Cell / (Grid::EagleStrikes::COUNT * Grid::FrogLeaps::COUNT * Grid::Pellets::COUNT) %
+		Grid::Thresholds::COUNT;
+	static const int SLIME = Cell / (Grid::EagleStrikes::COUNT * Grid::FrogLeaps::COUNT * Grid::Pellets::COUNT *
+		Grid::Thresholds::COUNT) % Grid::SlimeLives::COUNT;
+	static const int GARDEN = Cell / (Grid::EagleStrikes::COUNT * Grid::FrogLeaps::COUNT * Grid::Pellets::COUNT *
+		Grid::Thresholds::COUNT * Grid::SlimeLives::COUNT);
+};
+
+// the rules of cell 'Cell' of a grid
+template <class Grid, int Cell>
+struct SweepRules : StandardRules
+{
+	typedef SweepIndex<Grid, Cell> Index;
+	static const int EagleStrike = Grid::EagleStrikes::template At<Index::EAGLE>::value;
+	static const int FROGLEAP = Grid::FrogLeaps::template At<Index::LEAP>::value;
+	static const int NUM_PELLETS = Grid::Pellets::template At<Index::PELLETS>::value;
+	static const int PELLET_THRESHOLD = Grid::Thresholds::template At<Index::THRESHOLD>::value;
+	static const int SLIMELIFE = Grid::SlimeLives::template At<Index::SLIME>::value;
+	static const int SIZEY = Grid::GardenRows::template At<Index::GARDEN>::value;
+	static const int SIZEX = Grid::GardenColumns::template At<Index::GARDEN>::value;
+};
+
+// the rules of a cell of a grid read at run time, set by setRuntimeRules (a template only so that the values can be
+// defined in a header)
+template <int Unused>
+struct BasicRuntimeRules
+{
+	static int SLIMELIFE;
+	static int NUM_PELLETS;
+	static int PELLET_THRESHOLD;
+	static const int LETTUCE_QUOTA = StandardRules::LETTUCE_QUOTA;
+	static const int NUM_FROGS = StandardRules::NUM_FROGS;
+	static int FROGLEAP;
+	static int EagleStrike;
+	static const bool PLACE_FROM_FREE_FIELDS = false;
+	static int SIZEY;
+	static int SIZEX;
+};
+
+template <int Unused> int BasicRuntimeRules<Unused>::SLIMELIFE = StandardRules::SLIMELIFE;
+template <int Unused> int BasicRuntimeRules<Unused>::NUM_PELLETS = StandardRules::NUM_PELLETS;
+template <int Unused> int BasicRuntimeRules<Unused>::PELLET_THRESHOLD = StandardRules::PELLET_THRESHOLD;
+template <int Unused> int BasicRuntimeRules<Unused>::FROGLEAP = StandardRules::FROGLEAP;
+template <int Unused> int BasicRuntimeRules<Unused>::EagleStrike = StandardRules::EagleStrike;
+template <int Unused> int BasicRuntimeRules<Unused>::SIZEY = StandardRules::SIZEY;
+template <int Unused> int BasicRuntimeRules<Unused>::SIZEX = StandardRules::SIZEX;
+
+typedef BasicRuntimeRules<0> RuntimeRules;
+
+// the arrays of a game with RuntimeRules are made for the largest values, the arithmetic takes the values as they are
+template <int Unused>
+struct RuleTraits<BasicRuntimeRules<Unused> >
+{
+	typedef BasicRuntimeRules<Unused> Rules;
+	static const int MAX_SLIMELIFE = RUNTIME_MAX_SLIMELIFE;
+	static const int MAX_PELLETS = RUNTIME_MAX_PELLETS;
+	static const int MAX_SIZEY = SIZEY;
+	static const int MAX_SIZEX = SIZEX;
+
+	static bool eagleStrikes(int random)
+	{
+		return random % Rules::EagleStrike + 1 == Rules::EagleStrike;
+	}
+
+	static int nextSlime(int index)
+	{
+		return index + 1 >= Rules::SLIMELIFE ? 0 : index + 1;
+	}
+};
+
+// the keys the games are played with
+struct SweepPolicy
+{
+	const unsigned char* keys;		// keys from 0 to 4, played in a loop (0 for the bot)
+	int numberOfKeys;
+};
+
+// a cell of a grid: the values of its rules and the game code compiled for them
+struct SweepCell
+{
+	int eagleStrike;
+	int frogLeap;
+	int numPellets;
+	int pelletThreshold;
+	int slimeLife;
+	int rows;
+	int columns;
+	void (*playGames)(unsigned int seed, int games, int maxFrames, const SweepPolicy& policy, OutcomeShard& shard);
+	void (*setRules)(const SweepCell& cell);		// sets RuntimeRules to the values of the cell (0 if compiled)
+};
+
+// whether the values of a cell fit into RuntimeRules: all above 0, a garden of 3 by 3 up to SIZEY by SIZEX with room
+// for the snail, pellets, lettuces and frogs, and no more slime and pellets than the arrays of a game are made for
+inline bool runtimeRulesFit(const SweepCell& cell)
+{
+	const int fields = (cell.rows - 2) * (cell.columns - 2);
+	return cell.eagleStrike > 0 && cell.frogLeap > 0 && cell.pelletThreshold > 0 && cell.slimeLife > 0 &&
+		cell.slimeLife <= RUNTIME_MAX_SLIMELIFE && cell.numPellets >= 0 && cell.numPellets <= RUNTIME_MAX_PELLETS &&
+		cell.rows >= 3 && cell.rows <= SIZEY && cell.columns >= 3 && cell.columns <= SIZEX &&
+		1 + cell.numPellets + RuntimeRules::LETTUCE_QUOTA <= fields && 1 + RuntimeRules::NUM_FROGS <= fields;
+}
+
+// only while no games are played with RuntimeRules, and only with values that fit
+inline void setRuntimeRules(const SweepCell& cell)
+{
+	assert(runtimeRulesFit(cell));
+	RuntimeRules::EagleStrike = cell.eagleStrike;
+	RuntimeRules::FROGLEAP = cell.frogLeap;
+	RuntimeRules::NUM_PELLETS = cell.numPellets;
+	RuntimeRules::PELLET_THRESHOLD = cell.pelletThreshold;
+	RuntimeRules::SLIMELIFE = cell.slimeLife;
+	RuntimeRules::SIZEY = cell.rows;
+	RuntimeRules::SIZEX = cell.columns;
+}
+
+// plays a number of games seeded with seed, with the keys of a policy (starting at a key picked by the seed) or the
+// bot, and adds them to shard
+template <class Rules>
+void playSweepGames(unsigned int seed, int games, int maxFrames, const SweepPolicy& policy, OutcomeShard& shard)
+{
+	BasicGameState<Rules> state;
+	seedGame(state, seed);
+	BotRandom random;
+	random.state = seed | 1;
+	int next = policy.numberOfKeys > 0 ? static_cast<int>(seed * 2654435761u % policy.numberOfKeys) : 0;
+
+	for (int game = 0; game < games; ++game)
+	{
+		initialiseGame(state);
+		int frames(0);
+		while (!isGameOver(state) && frames < maxFrames)
+		{
+			int key;
+			if (policy.keys != 0)
+			{
+				key = policy.keys[next];
+				next = next + 1 == policy.numberOfKeys ? 0 : next + 1;
+			}
+			else
+			{
+				key = chooseBotKey(state, random);
+			}
+			stepGame(state, key);
+			++frames;
+		}
+		shard.addGame(state, frames, frogsEaten(state));
+	}
+}
+
+template <class Grid, int First, int Count>
+struct SweepCells
+{
+	static void fill(SweepCell* cells)
+	{
+		SweepCells<Grid, First, Count / 2>::fill(cells);
+		SweepCells<Grid, First + Count / 2, Count - Count / 2>::fill(cells);
+	}
+};
+
+template <class Grid, int First>
+struct SweepCells<Grid, First, 1>
+{
+	static void fill(SweepCell* cells)
+	{
+		typedef SweepRules<Grid, First> Rules;
+		const SweepCell cell = {Rules::EagleStrike, Rules::FROGLEAP, Rules::NUM_PELLETS, Rules::PELLET_THRESHOLD,
+			Rules::SLIMELIFE, Rules::SIZEY, Rules::SIZEX, &playSweepGames<Rules>, 0};
+		cells[First] = cell;
+	}
+};
+
+template <class Grid>
+struct SweepTable
+{
+	static const int NUM_CELLS = Grid::EagleStrikes::COUNT * Grid::FrogLeaps::COUNT * Grid::Pellets::COUNT *
+		Grid::Thresholds::COUNT * Grid::SlimeLives::COUNT * Grid::GardenRows::COUNT;
+
+	static void fill(SweepCell* cells)
+	{
+		static_assert(Grid::GardenRows::COUNT == Grid::GardenColumns::COUNT, "every garden needs rows and columns");
+		SweepCells<Grid, 0, NUM_CELLS>::fill(cells);
+	}
+};
+
+/***************************************************************************************
+Grids read at run time
+****************************************************************************************/
+
+struct SweepGrid
+{
+	std::vector<int> eagleStrikes;
+	std::vector<int> frogLeaps;
+	std::vector<int> pellets;
+	std::vector<int> thresholds;
+	std::vector<int> slimeLives;
+	std::vector<int> gardenRows;
+	std::vector<int> gardenColumns;
+};
+
+inline bool readSweepGrid(std::istream& in, SweepGrid& grid)
+{
+	grid = SweepGrid();
+	std::string line;
+	while (std::getline(in, line))
+	{
+		std::istringstream words(line);
+		std::string axis;
+		if (!(words >> axis) || axis[0] == '#')
+		{
+			continue;
+		}
+		std::vector<int>* values = axis == "eagle" ? &grid.eagleStrikes : axis == "leap" ? &grid.frogLeaps :
+			axis == "pellets" ? &grid.pellets : axis == "threshold" ? &grid.thresholds :
+			axis == "slime" ? &grid.slimeLives : axis == "garden" ? &grid.gardenRows : 0;
+		if (values == 0 || !values->empty())
+		{
+			return false;		// an axis that does not exist, or one given twice
+		}
+		std::string value;
+		while (words >> value)
+		{
+			int number(0);
+			int columns(0);
+			char end(0);
+			if (values == &grid.gardenRows ? sscanf(value.c_str(), "%dx%d%c", &number, &columns, &end) != 2 :
+				sscanf(value.c_str(), "%d%c", &number, &end) != 1)
+			{
+				return false;
+			}
+			values->push_back(number);
+			if (values == &grid.gardenRows)
+			{
+				grid.gardenColumns.push_back(columns);
+			}
+		}
+		if (values->empty())
+		{
+			return false;
+		}
+	}
+
+	// the axes left out take the values of StandardRules
+	std::vector<int>* const axes[] = {&grid.eagleStrikes, &grid.frogLeaps, &grid.pellets, &grid.thresholds,
+		&grid.slimeLives, &grid.gardenRows, &grid.gardenColumns};
+	const int standard[] = {StandardRules::EagleStrike, StandardRules::FROGLEAP, StandardRules::NUM_PELLETS,
+		StandardRules::PELLET_THRESHOLD, StandardRules::SLIMELIFE, StandardRules::SIZEY, StandardRules::SIZEX};
+	for (int axis = 0; axis < 7; ++axis)
+	{
+		if (axes[axis]->empty())
+		{
+			axes[axis]->push_back(standard[axis]);
+		}
+	}
+	return in.eof();
+}
+
+inline SweepCell runtimeCell(const SweepCell& values)
+{
+	SweepCell cell = values;
+	cell.playGames = &playSweepGames<RuntimeRules>;
+	cell.setRules = &setRuntimeRules;
+	return cell;
+}
+
+// the cells are numbered as those of a compiled grid, with EagleStrikes changing fastest
+inline int makeRuntimeCells(const SweepGrid& grid, std::vector<SweepCell>& cells)
+{
+	const std::vector<int>* const axes[] = {&grid.eagleStrikes, &grid.frogLeaps, &grid.pellets, &grid.thresholds,
+		&grid.slimeLives, &grid.gardenRows};
+	int numberOfCells(1);
+	for (int axis = 0; axis < 6; ++axis)
+	{
+		numberOfCells *= static_cast<int>(axes[axis]->size());
+	}
+
+	cells.clear();
+	int unfit(-1);
+	for (int cell = 0; cell < numberOfCells; ++cell)
+	{
+		int index[6];
+		for (int axis = 0, rest = cell; axis < 6; ++axis)
+		{
+			index[axis] = rest % static_cast<int>(axes[axis]->size());
+			rest /= static_cast<int>(axes[axis]->size());
+		}
+		const SweepCell values = {grid.eagleStrikes[index[0]], grid.frogLeaps[index[1]], grid.pellets[index[2]],
+			grid.thresholds[index[3]], grid.slimeLives[index[4]], grid.gardenRows[index[5]],
+			grid.gardenColumns[index[5]], 0, 0};
+		if (unfit < 0 && !runtimeRulesFit(values))
+		{
+			unfit = cell;
+		}
+		cells.push_back(runtimeCell(values));
+	}
+	return unfit;
+}
+
+/***************************************************************************************
+Sweeps
+****************************************************************************************/
+
+// the statistics of a cell, and the seconds the threads spent on it
+struct SweepResult
+{
+	OutcomeStats stats;
+	double seconds;
+};
+
+// plays the blocks of cells first to first + count - 1 on a number of threads
+inline void playSweepBlocks(const SweepCell* cells, int first, int count, int gamesPerCell, int maxFrames,
+	const SweepPolicy& policy, int numberOfThreads, OutcomeAggregator& aggregator, std::atomic<long long>* nanoseconds)
+{
+	const int blocksPerCell = (gamesPerCell + SWEEP_BLOCK_GAMES - 1) / SWEEP_BLOCK_GAMES;
+	const long long numberOfBlocks = static_cast<long long>(blocksPerCell) * count;
+	std::atomic<long long> nextBlock(0);
+
+	std::vector<std::thread> workers;
+	for (int t = 0; t < numberOfThreads; ++t)
+	{
+		workers.push_back(std::thread([&, t]()
+		{
+			for (long long block = nextBlock++; block < numberOfBlocks; block = nextBlock++)
+			{
+				const int cell = first + static_cast<int>(block % count);
+				const int start = static_cast<int>(block / count) * SWEEP_BLOCK_GAMES;
+				const int games = gamesPerCell - start < SWEEP_BLOCK_GAMES ? gamesPerCell - start : SWEEP_BLOCK_GAMES;
+				const SweepClock::time_point begin = SweepClock::now();
+				cells[cell].playGames(SWEEP_SEED + static_cast<unsigned int>(block / count), games, maxFrames, policy,
+					aggregator.shard(cell * numberOfThreads + t));
+				nanoseconds[cell] += std::chrono::duration_cast<std::chrono::nanoseconds>(SweepClock::now() - begin).count();
+			}
+		}));
+	}
+	for (int t = 0; t < numberOfThreads; ++t)
+	{
+		workers[t].join();
+	}
+}
+
+inline void runSweep(const SweepCell* cells, int numberOfCells, int gamesPerCell, int maxFrames,
+	const SweepPolicy& policy, int numberOfThreads, std::vector<SweepResult>& results)
+{
+	OutcomeAggregator aggregator(numberOfCells * numberOfThreads);		// the shards of a cell are next to each other
+	std::atomic<long long>* nanoseconds = new std::atomic<long long>[numberOfCells];
+	for (int cell = 0; cell < numberOfCells; ++cell)
+	{
+		nanoseconds[cell].store(0);
+	}
+
+	// the compiled cells next to each other are played together, a cell with RuntimeRules on its own
+	for (int first = 0; first < numberOfCells;)
+	{
+		int count(1);
+		if (cells[first].setRules != 0)
+		{
+			cells[first].setRules(cells[first]);
+		}
+		else
+		{
+			while (first + count < numberOfCells && cells[first + count].setRules == 0)
+			{
+				++count;
+			}
+		}
+		playSweepBlocks(cells, first, count, gamesPerCell, maxFrames, policy, numberOfThreads, aggregator, nanoseconds);
+		first += count;
+	}
+
+	results.resize(numberOfCells);
+	for (int cell = 0; cell < numberOfCells; ++cell)
+	{
+		results[cell].stats = aggregator.collect(cell * numberOfThreads, numberOfThreads);
+		results[cell].seconds = nanoseconds[cell] / 1e9;
+	}
+	delete[] nanoseconds;
+}
+
+#endif
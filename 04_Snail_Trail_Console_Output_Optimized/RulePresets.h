@@ -0,0 +1,259 @@
+/* Sets of rules for the game code of "SnailEngine.h", and a list of them that can be looked up by name at run time
+(e.g. to run a batch of games for rules given on the command line or in a file).
+
+Use the following procedures/functions for the following results:
+
+StandardRules, OriginalRules, EasyRules, HardRules, MarathonRules, SwarmRules, CrowdedRules to play with these
+	rules, e.g. BasicGameState<HardRules> state
+playGames<Rules>(seed, games, maxFrames) to let a simple bot play a number of games with a set of rules, returns the
+	GameStats of all games
+rulePresets, NUM_RULE_PRESETS for the list of all sets of rules, with their values and their playGames
+findRules(name) to look up a set of rules by name, returns 0 if there is none with that name
+
+Every set of rules is a structure with the members of StandardRules, a new one only has to name the rules it changes.
+The game code is compiled for every set of rules in the list, so looking one up by name picks code that has its rules
+as constants.
+*/
+
+#ifndef RULE_PRESETS_H
+#define RULE_PRESETS_H
+
+#include <cstdlib>           //for abs
+#include <cstring>           //for strcmp
+
+#include "SnailEngine.h"     //for BasicGameState, StandardRules, stepGame, etc.
+
+// the eagle of versions 00 to 10
+struct OriginalRules : StandardRules
+{
+	static const int EagleStrike = 30;
+};
+
+// one frog, slime that dissolves sooner and more pellets to be eaten
+struct EasyRules : StandardRules
+{
+	static const int SLIMELIFE = 16;
+	static const int PELLET_THRESHOLD = 8;
+	static const int NUM_FROGS = 1;
+};
+
+// more pellets, fewer of them to be eaten and twice the frogs, which the eagle rarely gets
+struct HardRules : StandardRules
+{
+	static const int NUM_PELLETS = 25;
+	static const int PELLET_THRESHOLD = 3;
+	static const int NUM_FROGS = 4;
+	static const int EagleStrike = 64;
+};
+
+// three times the lettuces, with a longer slime trail
+struct MarathonRules : StandardRules
+{
+	static const int SLIMELIFE = 32;
+	static const int LETTUCE_QUOTA = 12;
+};
+
+// more frogs than are moved without a loop, leaping shorter, with a hungry eagle
+struct SwarmRules : StandardRules
+{
+	static const int NUM_FROGS = 12;
+	static const int FROGLEAP = 2;
+	static const int EagleStrike = 16;
+};
+
+// half the garden covered in pellets, placed from the free fields
+struct CrowdedRules : StandardRules
+{
+	static const int NUM_PELLETS = 250;
+	static const int PELLET_THRESHOLD = 50;
+	static const int LETTUCE_QUOTA = 8;
+	static const bool PLACE_FROM_FREE_FIELDS = true;
+};
+
+// how the games played with a set of rules went
+struct GameStats
+{
+	int games;
+	long long frames;
+	int wins;
+	int pelletDeaths;		// ate too many pellets
+	int frogDeaths;			// ran into a frog or a frog landed on it
+	int timeouts;			// still going after maxFrames
+	long long lettuces;		// lettuces eaten
+	long long eagleStrikes;	// frogs eaten by the eagle
+};
+
+/***************************************************************************************
+Bot
+****************************************************************************************/
+
+// random number generator of the bot, so that the bot does not change the random numbers of the game
+struct BotRandom
+{
+	unsigned int state;
+
+	unsigned int next()
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+// the bot steps onto the pellet that kills the snail once in this many times it could, so that some games are lost
+// to pellets
+const int BOT_FINAL_PELLET_ODDS(8);
+
+// a random move that does not run into a wall, slime or a frog, most of the time towards the closest lettuce (as the
+// rollouts of version 14), and seldom onto the final pellet
+template <class Rules>
+inline int chooseBotKey(const BasicGameState<Rules>& state, BotRandom& random)
+{
+	const char (&garden)[SIZEY][SIZEX+2] = state.garden;
+	const int* snail = state.snail;
+
+	int keys[4];
+	int numberOfKeys(0);
+	for (int key = 0; key < 4; ++key)
+	{
+		const char target = garden[snail[0] + moveDirections[key][0]][snail[1] + moveDirections[key][1]];
+		if (target != WALL && target != SLIME && target != FROG && (target != PELLET ||
+			state.counters[2] < Rules::PELLET_THRESHOLD - 1 || random.next() % BOT_FINAL_PELLET_ODDS == 0))
+		{
+			keys[numberOfKeys++] = key;
+		}
+	}
+	if (numberOfKeys == 0)
+	{
+		return 4;
+	}
+
+	const unsigned int r = random.next();
+	if ((r & 3) != 0)
+	{
+		// head for the closest lettuce
+		int closest(Rules::SIZEX + Rules::SIZEY);
+		int lettuceY(0);
+		int lettuceX(0);
+		for (int y = 1; y < Rules::SIZEY - 1; ++y)
+		{
+			for (int x = 1; x < Rules::SIZEX - 1; ++x)
+			{
+				if (garden[y][x] == LETTUCE)
+				{
+					const int distance = abs(y - snail[0]) + abs(x - snail[1]);
+					if (distance < closest)
+					{
+						closest = distance;
+						lettuceY = y;
+						lettuceX = x;
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < numberOfKeys; ++i)
+		{
+			const int key = keys[(i + (r >> 2)) % numberOfKeys];
+			const int distance = abs(lettuceY - snail[0] - moveDirections[key][0]) + abs(lettuceX - snail[1] - moveDirections[key][1]);
+			if (distance < closest)
+			{
+				return key;
+			}
+		}
+	}
+	return keys[(r >> 2) % numberOfKeys];
+}
+
+template <class Rules>
+GameStats playGames(unsigned int seed, int games, int maxFrames)
+{
+	GameStats stats;
+	memset(&stats, 0, sizeof(stats));
+
+	BasicGameState<Rules> state;
+	seedGame(state, seed);
+	BotRandom random;
+	random.state = seed | 1;
+
+	for (int game = 0; game < games; ++game)
+	{
+		initialiseGame(state);
+		int frames(0);
+		while (!isGameOver(state) && frames < maxFrames)
+		{
+			const unsigned int events = stepGame(state, chooseBotKey(state, random));
+			if (events & (EVENT_HIT_FROG | EVENT_FROG_HITS_SNAIL))
+			{
+				++stats.frogDeaths;
+			}
+			else if (events & EVENT_HIT_FINAL_PELLET)
+			{
+				++stats.pelletDeaths;
+			}
+			++frames;
+		}
+
+		++stats.games;
+		stats.frames += frames;
+		stats.lettuces += state.counters[3];
+		stats.eagleStrikes += frogsEaten(state);
+		stats.wins += state.counters[3] == Rules::LETTUCE_QUOTA;
+		stats.timeouts += !isGameOver(state);
+	}
+	return stats;
+}
+
+/***************************************************************************************
+Presets by name
+****************************************************************************************/
+
+// a set of rules as values, with the game code compiled for it
+struct RulePreset
+{
+	const char* name;
+	int slimeLife;
+	int numPellets;
+	int pelletThreshold;
+	int lettuceQuota;
+	int numFrogs;
+	int frogLeap;
+	int eagleStrike;
+	GameStats (*playGames)(unsigned int seed, int games, int maxFrames);
+};
+
+template <class Rules>
+inline RulePreset makeRulePreset(const char* name)
+{
+	RulePreset preset = {name, Rules::SLIMELIFE, Rules::NUM_PELLETS, Rules::PELLET_THRESHOLD, Rules::LETTUCE_QUOTA,
+		Rules::NUM_FROGS, Rules::FROGLEAP, Rules::EagleStrike, &playGames<Rules>};
+	return preset;
+}
+
+const RulePreset rulePresets[] = {
+	makeRulePreset<StandardRules>("standard"),
+	makeRulePreset<OriginalRules>("original"),
+	makeRulePreset<EasyRules>("easy"),
+	makeRulePreset<HardRules>("hard"),
+	makeRulePreset<MarathonRules>("marathon"),
+	makeRulePreset<SwarmRules>("swarm"),
+	makeRulePreset<CrowdedRules>("crowded")
+};
+
+const int NUM_RULE_PRESETS(sizeof(rulePresets) / sizeof(rulePresets[0]));
+
+inline const RulePreset* findRules(const char* name)
+{
+	for (int i = 0; i < NUM_RULE_PRESETS; ++i)
+	{
+		if (strcmp(rulePresets[i].name, name) == 0)
+		{
+			return &rulePresets[i];
+		}
+	}
+	return 0;
+}
+
+#endif
@@ -0,0 +1,435 @@
+/* Recordings of what the garden and the game info (see "SnailEngine.h") looked like in every frame of a session, that
+can be opened at any frame without playing the session again from the start.
+
+Use the following procedures/functions for the following results:
+
+SeekableReplay replay(interval) for an empty recording with a keyframe every 'interval' frames
+replay.addFrame(state) to add the garden and the game info of a game as the next frame, e.g. after initialiseGame
+replay.addFrame(state, queue) to do the same after stepQueued (see "TerminalRender.h"), comparing only the fields
+	noted in queue with the frame before
+replay.seek(frame, view) to get the garden and the game info of a frame (from 0) into a ReplayFrame, returns false if
+	there is no such frame
+replay.numberOfFrames(), replay.keyframeInterval() and replay.size() for the frames, the interval and the bytes held
+replay.write(out) and replay.read(in) to write a recording to a binary stream and to read it back, read returns false
+	if the stream does not hold a whole recording that decodes
+
+A replay of keys (as in "Keys.txt" or "LayoutReplay.h") is the smallest recording of a session, but to see frame N the
+game has to be played from the start up to N. Here every 'interval'-th frame is a keyframe, which holds all fields of
+the garden and the game info, and every other frame only holds what changed since the frame before: the number of
+changed fields, then for every changed field (in the order of the fields in the garden) the distance to the changed
+field before and the code of its new contents in one varint (the distance shifted left by CELL_BITS, the code in the
+low bits), then a byte with a bit for every counter that changed, followed by the new counters as varints. Varints
+hold 7 bits per byte, lowest first, with the top bit set in all bytes but the last, so a field a few fields on from
+the one before and its code take a single byte. Seeking to a frame decodes the keyframe before it and at most
+interval - 1 frames of changes after it, whatever the length of the session.
+The fields compared for a frame after stepQueued are those version 04 pushes into its changeQueue (the fields left and
+entered by the snail, the slime and the frogs), so recording costs about as much as painting like version 04.
+Numbers in the binary stream are written with the lowest byte first, so a recording can be read on any machine.
+A stream is not trusted when it is read back: the number of frames has to fit into the length of the recording before
+anything is made room for, the bytes are read in blocks of READ_BLOCK as they come, and every frame is decoded once,
+with every varint, field and change checked against the end of the bytes, before the recording is taken.
+*/
+
+#ifndef SEEKABLE_REPLAY_H
+#define SEEKABLE_REPLAY_H
+
+#include <cstring>           //for memcpy, memcmp, memset, memmove
+#include <iostream>          //for istream and ostream
+#include <vector>            //for vector
+
+#include "SnailEngine.h"     //for BasicGameState, SIZEY, SIZEX, etc.
+#include "TerminalRender.h"  //for ChangeQueue
+
+// what a frame of a recording shows
+struct ReplayFrame
+{
+	char garden[SIZEY][SIZEX];
+	int counters[4];			// message, slime counter, pellets and lettuces eaten (as in the game)
+};
+
+// the frames between two keyframes if none is given
+const int DEFAULT_KEYFRAME_INTERVAL(32);
+
+// the bits of a field code, the contents of a field for every code, and the code for anything else (followed by the
+// character itself)
+const int CELL_BITS(4);
+const char cellChars[] = {BLANK, SLIME, SNAIL, FROG, PELLET, LETTUCE, WALL, DEADSNAIL, DEAD_FROG_BONES};
+const int NUM_CELL_CODES(sizeof(cellChars) / sizeof(cellChars[0]));
+const unsigned int ESCAPE_CODE((1 << CELL_BITS) - 1);
+
+// the first bytes of a recording in a stream
+const char SEEKABLE_MAGIC[8] = {'S', 'N', 'A', 'I', 'L', 'S', 'E', 'K'};
+
+// the bytes of a recording read from a stream at a time
+const unsigned int READ_BLOCK(1 << 16);
+
+// the fewest bytes a keyframe and a frame of changes take (the fields and four counters, a count and the flags)
+const unsigned int MIN_KEYFRAME_BYTES(SIZEY * SIZEX + 4);
+const unsigned int MIN_CHANGES_BYTES(2);
+
+inline unsigned int cellCode(char field)
+{
+	for (int code = 0; code < NUM_CELL_CODES; ++code)
+	{
+		if (cellChars[code] == field)
+		{
+			return code;
+		}
+	}
+	return ESCAPE_CODE;
+}
+
+inline void appendVarint(std::vector<unsigned char>& bytes, unsigned int value)
+{
+	while (value >= 0x80)
+	{
+		bytes.push_back(static_cast<unsigned char>(value | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back(static_cast<unsigned char>(value));
+}
+
+// reads a varint before end, returns false if it goes on past end or does not fit into an unsigned int
+inline bool readVarint(const unsigned char*& bytes, const unsigned char* end, unsigned int& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 32; shift += 7)
+	{
+		if (bytes == end || (shift == 28 && (*bytes & 0x70) != 0))
+		{
+			return false;
+		}
+		const unsigned char byte = *bytes++;
+		value |= static_cast<unsigned int>(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+class SeekableReplay
+{
+private:
+	int interval;
+	int frames;
+	std::vector<unsigned char> bytes;		// the keyframes, each followed by the changes of the frames up to the next
+	std::vector<unsigned int> keyframes;	// where every keyframe starts in bytes
+	ReplayFrame last;						// the frame added last
+
+	template <class Rules>
+	void copyFrame(const BasicGameState<Rules>& state, ReplayFrame& frame)
+	{
+		for (int y = 0; y < SIZEY; ++y)
+		{
+			memcpy(frame.garden[y], state.garden[y], SIZEX);
+		}
+		memcpy(frame.counters, state.counters, sizeof(frame.counters));
+	}
+
+	void appendKeyframe(const ReplayFrame& frame)
+	{
+		keyframes.push_back(static_cast<unsigned int>(bytes.size()));
+		bytes.insert(bytes.end(), &frame.garden[0][0], &frame.garden[0][0] + SIZEY * SIZEX);
+		for (int i = 0; i < 4; ++i)
+		{
+			appendVarint(bytes, static_cast<unsigned int>(frame.counters[i]));
+		}
+		last = frame;
+	}
+
+	// appends the fields (positions y * SIZEX + x, in ascending order) that differ from the frame before, and the
+	// counters
+	void appendChanges(const ReplayFrame& frame, const int* positions, int count)
+	{
+		int changed(0);
+		for (int i = 0; i < count; ++i)
+		{
+			changed += (&frame.garden[0][0])[positions[i]] != (&last.garden[0][0])[positions[i]];
+		}
+		appendVarint(bytes, changed);
+		int previous(-1);
+		for (int i = 0; i < count; ++i)
+		{
+			const char field = (&frame.garden[0][0])[positions[i]];
+			if (field != (&last.garden[0][0])[positions[i]])
+			{
+				const unsigned int code = cellCode(field);
+				appendVarint(bytes, static_cast<unsigned int>(positions[i] - previous - 1) << CELL_BITS | code);
+				if (code == ESCAPE_CODE)
+				{
+					bytes.push_back(static_cast<unsigned char>(field));
+				}
+				(&last.garden[0][0])[positions[i]] = field;
+				previous = positions[i];
+			}
+		}
+
+		const size_t flags = bytes.size();
+		bytes.push_back(0);
+		for (int i = 0; i < 4; ++i)
+		{
+			if (frame.counters[i] != last.counters[i])
+			{
+				bytes[flags] |= static_cast<unsigned char>(1 << i);
+				appendVarint(bytes, static_cast<unsigned int>(frame.counters[i]));
+				last.counters[i] = frame.counters[i];
+			}
+		}
+	}
+
+	// the decoders return where the next frame starts, or 0 if the frame does not end before end
+	static const unsigned char* decodeKeyframe(const unsigned char* at, const unsigned char* end, ReplayFrame& frame)
+	{
+		if (end - at < SIZEY * SIZEX)
+		{
+			return 0;
+		}
+		memcpy(&frame.garden[0][0], at, SIZEY * SIZEX);
+		at += SIZEY * SIZEX;
+		for (int i = 0; i < 4; ++i)
+		{
+			unsigned int counter;
+			if (!readVarint(at, end, counter))
+			{
+				return 0;
+			}
+			frame.counters[i] = static_cast<int>(counter);
+		}
+		return at;
+	}
+
+	static const unsigned char* decodeChanges(const unsigned char* at, const unsigned char* end, ReplayFrame& frame)
+	{
+		unsigned int changed;
+		if (!readVarint(at, end, changed) || changed > static_cast<unsigned int>(SIZEY * SIZEX))
+		{
+			return 0;
+		}
+		int position(-1);
+		for (unsigned int i = 0; i < changed; ++i)
+		{
+			unsigned int value;
+			if (!readVarint(at, end, value) || (value >> CELL_BITS) >= static_cast<unsigned int>(SIZEY * SIZEX - 1 - position))
+			{
+				return 0;		// runs past the last field
+			}
+			position += static_cast<int>(value >> CELL_BITS) + 1;
+			const unsigned int code = value & ESCAPE_CODE;
+			if (code == ESCAPE_CODE ? at == end : code >= static_cast<unsigned int>(NUM_CELL_CODES))
+			{
+				return 0;
+			}
+			(&frame.garden[0][0])[position] = code == ESCAPE_CODE ? static_cast<char>(*at++) : cellChars[code];
+		}
+		if (at == end || (*at & 0xf0) != 0)
+		{
+			return 0;
+		}
+		const unsigned char flags = *at++;
+		for (int i = 0; i < 4; ++i)
+		{
+			unsigned int counter;
+			if (flags & (1 << i))
+			{
+				if (!readVarint(at, end, counter))
+				{
+					return 0;
+				}
+				frame.counters[i] = static_cast<int>(counter);
+			}
+		}
+		return at;
+	}
+
+	static void writeWord(std::ostream& out, unsigned int word)
+	{
+		const unsigned char bytes[4] = {static_cast<unsigned char>(word), static_cast<unsigned char>(word >> 8),
+			static_cast<unsigned char>(word >> 16), static_cast<unsigned char>(word >> 24)};
+		out.write(reinterpret_cast<const char*>(bytes), 4);
+	}
+
+	static unsigned int readWord(std::istream& in)
+	{
+		unsigned char bytes[4] = {0};
+		in.read(reinterpret_cast<char*>(bytes), 4);
+		return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<unsigned int>(bytes[3]) << 24;
+	}
+
+public:
+	explicit SeekableReplay(int interval = DEFAULT_KEYFRAME_INTERVAL) : interval(interval > 0 ? interval : 1), frames(0)
+	{
+		memset(&last, 0, sizeof(last));
+	}
+
+	int keyframeInterval() const
+	{
+		return interval;
+	}
+
+	int numberOfFrames() const
+	{
+		return frames;
+	}
+
+	size_t size() const
+	{
+		return bytes.size() + keyframes.size() * sizeof(unsigned int);
+	}
+
+	template <class Rules>
+	void addFrame(const BasicGameState<Rules>& state)
+	{
+		ReplayFrame frame;
+		copyFrame(state, frame);
+		if (frames++ % interval == 0)
+		{
+			appendKeyframe(frame);
+			return;
+		}
+		int positions[SIZEY * SIZEX];
+		for (int i = 0; i < SIZEY * SIZEX; ++i)
+		{
+			positions[i] = i;
+		}
+		appendChanges(frame, positions, SIZEY * SIZEX);
+	}
+
+	template <class Rules>
+	void addFrame(const BasicGameState<Rules>& state, const ChangeQueue<Rules>& queue)
+	{
+		ReplayFrame frame;
+		copyFrame(state, frame);
+		if (frames++ % interval == 0)
+		{
+			appendKeyframe(frame);
+			return;
+		}
+
+		// the noted fields in ascending order, each once (the queue holds a field twice if the snail did not move)
+		int positions[3 + 2 * Rules::NUM_FROGS];
+		int count(0);
+		for (int i = 0; i < queue.count; ++i)
+		{
+			const int position = queue.fields[i][0] * SIZEX + queue.fields[i][1];
+			int at(count);
+			while (at > 0 && positions[at - 1] > position)
+			{
+				--at;
+			}
+			if (at > 0 && positions[at - 1] == position)
+			{
+				continue;
+			}
+			memmove(positions + at + 1, positions + at, (count - at) * sizeof(int));
+			positions[at] = position;
+			++count;
+		}
+		appendChanges(frame, positions, count);
+	}
+
+	bool seek(int frame, ReplayFrame& view) const
+	{
+		if (frame < 0 || frame >= frames)
+		{
+			return false;
+		}
+		const unsigned char* end = &bytes[0] + bytes.size();
+		const unsigned char* at = decodeKeyframe(&bytes[0] + keyframes[frame / interval], end, view);
+		for (int i = frame % interval; i > 0 && at != 0; --i)
+		{
+			at = decodeChanges(at, end, view);
+		}
+		return at != 0;
+	}
+
+	void write(std::ostream& out) const
+	{
+		out.write(SEEKABLE_MAGIC, sizeof(SEEKABLE_MAGIC));
+		writeWord(out, interval);
+		writeWord(out, frames);
+		writeWord(out, static_cast<unsigned int>(bytes.size()));
+		for (size_t i = 0; i < keyframes.size(); ++i)
+		{
+			writeWord(out, keyframes[i]);
+		}
+		if (!bytes.empty())
+		{
+			out.write(reinterpret_cast<const char*>(&bytes[0]), bytes.size());
+		}
+	}
+
+	bool read(std::istream& in)
+	{
+		char magic[sizeof(SEEKABLE_MAGIC)] = {0};
+		in.read(magic, sizeof(magic));
+		const int newInterval = static_cast<int>(readWord(in));
+		const int newFrames = static_cast<int>(readWord(in));
+		const unsigned int length = readWord(in);
+		if (!in || memcmp(magic, SEEKABLE_MAGIC, sizeof(magic)) != 0 || newInterval <= 0 || newFrames < 0)
+		{
+			return false;
+		}
+
+		// so many frames have to fit into the length before any room is made for them
+		const unsigned long long numberOfKeyframes = (static_cast<unsigned long long>(newFrames) + newInterval - 1) /
+			newInterval;
+		if (numberOfKeyframes * MIN_KEYFRAME_BYTES + (newFrames - numberOfKeyframes) * MIN_CHANGES_BYTES > length)
+		{
+			return false;
+		}
+		std::vector<unsigned int> newKeyframes(static_cast<size_t>(numberOfKeyframes));
+		for (size_t i = 0; i < newKeyframes.size(); ++i)
+		{
+			newKeyframes[i] = readWord(in);
+		}
+		std::vector<unsigned char> newBytes;
+		while (in && newBytes.size() < length)
+		{
+			const size_t start = newBytes.size();
+			newBytes.resize(start + (length - start < READ_BLOCK ? length - start : READ_BLOCK));
+			in.read(reinterpret_cast<char*>(&newBytes[start]), newBytes.size() - start);
+		}
+		if (!in)
+		{
+			return false;
+		}
+
+		// every frame has to decode, and every keyframe has to start where the frames before it end
+		ReplayFrame frame;
+		memset(&frame, 0, sizeof(frame));
+		const unsigned char* begin = newBytes.empty() ? 0 : &newBytes[0];
+		const unsigned char* end = begin + newBytes.size();
+		const unsigned char* at = begin;
+		for (int i = 0; i < newFrames; ++i)
+		{
+			if (i % newInterval == 0)
+			{
+				at = newKeyframes[i / newInterval] == static_cast<unsigned int>(at - begin) ?
+					decodeKeyframe(at, end, frame) : 0;
+			}
+			else
+			{
+				at = decodeChanges(at, end, frame);
+			}
+			if (at == 0)
+			{
+				return false;
+			}
+		}
+		if (at != end)
+		{
+			return false;		// bytes left over
+		}
+
+		interval = newInterval;
+		frames = newFrames;
+		keyframes.swap(newKeyframes);
+		bytes.swap(newBytes);
+		last = frame;		// so that more frames can be added
+		return true;
+	}
+};
+
+#endif
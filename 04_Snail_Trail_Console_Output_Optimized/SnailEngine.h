@@ -0,0 +1,898 @@
+/* The game code of 12_Snail_Trail_Final_Version without any input, output or timing, for versions that have to
+run the game many times from code (bots, search, batch runs).
+
+Use the following procedures/functions for the following results:
+
+seedGame(state, seed) to seed the random number generator of a game
+initialiseGame(state) to set up the garden, snail, pellets, lettuces and frogs for a new game
+generateLayout(state, layout) to draw only the positions for a new game (as initialiseGame does) into a GameLayout
+setUpGame(state, layout) to set up a new game from a GameLayout, without drawing any random numbers
+initialiseGame(state, eagle) and setUpGame(state, layout, eagle) to do the same for a game played with another eagle
+	than RandomEagle, which is told about every frog placed
+stepGame(state, key) to run one iteration of the game loop with a key from 0 to 4 (see below), returns the events that
+	happened in it as a combination of GameEvent flags (eventNames[event] is the name of the flag 1 << event,
+	eventIndex(flag) is the event of a flag)
+stepGame(state, key, eagle) to do the same with another eagle than RandomEagle, e.g. one replaying recorded strikes
+isGameOver(state) to check whether the snail is dead or full
+frogsEaten(state) for the number of frogs the eagle has got in the game so far
+translateKey(command) to turn a key code as read by getKeyPress into a key from 0 to 5
+
+The whole game is held in a GameState, copying one is all it takes to branch off a game. The structure only holds
+plain values (no pointers), so it can also be copied with memcpy, e.g. into a SnapshotArena (see "SnapshotArena.h").
+It is aligned to cache lines, so a copy touches as few lines as possible.
+The state includes its own random number generator. It produces the same numbers as rand() of the Microsoft C runtime,
+so a game seeded with 256 lays out the garden and lets the eagle strike exactly as versions 11 and 12 do after
+srand(256), on any platform, and the recorded keys of those versions can be replayed with it.
+The rules of the game (how long slime lasts, how many pellets, lettuces and frogs there are, how far frogs leap, how
+often the eagle strikes and how large the garden is) are a template parameter of the game, so that the game code is compiled for every set of
+rules on its own, with the rules as constants: a modulus by a power of two is a mask and the frogs are moved without a
+loop if there are only a few of them. GameState is a game with the rules of version 12 (StandardRules), other rules
+are in "RulePresets.h". Rules that are only known at run time (RuntimeRules of "ParameterSweep.h") can be played
+too, by giving them a RuleTraits with the largest values they may take. A smaller garden than SIZEY by SIZEX is kept
+in the top left corner of the garden array, surrounded by walls.
+Like version 12, the snail, pellets, lettuces and frogs are placed by drawing positions until a free one comes up,
+which takes ever more tries the fuller the garden gets. Rules with PLACE_FROM_FREE_FIELDS draw from a list of the free
+fields instead (a partial Fisher-Yates shuffle), which takes two random numbers per item however full the garden is.
+Every thread keeps its list of fields from one layout to the next and only puts back the fields a layout has moved (or
+fills in all of them again, if a layout moves most of them).
+Whether the eagle gets a frog is left to an eagle class with the member functions onSpawn(state, frog), called when a
+frog is placed, and strikes(state, frog), called every time the frog has moved. RandomEagle draws a random number
+for every move like version 12, GeometricEagle draws once per frog when it is placed, other eagles can take the
+strikes from elsewhere (see "LayoutReplay.h").
+*/
+
+#ifndef SNAIL_ENGINE_H
+#define SNAIL_ENGINE_H
+
+#include <cmath>             //for log
+#include <cstring>           //for memset
+#include <type_traits>       //for is_trivially_copyable
+
+// aligns a structure to the given number of bytes
+#ifdef _MSC_VER
+#define SNAIL_ALIGN(bytes) __declspec(align(bytes))
+#else
+#define SNAIL_ALIGN(bytes) __attribute__((aligned(bytes)))
+#endif
+
+// a static variable of which every thread has its own (only for plain data, which needs no constructor)
+#ifdef _MSC_VER
+#define SNAIL_THREAD_LOCAL __declspec(thread)
+#else
+#define SNAIL_THREAD_LOCAL __thread
+#endif
+
+const int CACHE_LINE(64);
+
+// global constants
+
+// garden dimensions
+const int SIZEY(20);						// vertical dimension
+const int SIZEX(30);						// horizontal dimension
+
+//constants used for the garden & its inhabitants
+const char BLANK(' ');						// open space
+const char PELLET ('-'); //(BLANK);			// should be blank) but test using a visible character.
+const char LETTUCE ('@');					// a lettuce
+const char SLIME ('.');						// snail produce
+const char WALL('+');                       // garden wall
+const char FROG ('M');
+const char DEAD_FROG_BONES ('X');			// Dead frogs are marked as such in their 'y' coordinate
+const char SNAIL('&');						// snail (player's icon)
+const char DEADSNAIL ('o');					// just the shell left...
+
+const int  SLIMELIFE (25);					// how long slime lasts (in keypresses)
+const int  NUM_PELLETS (15);				// number of slug pellets scattered about
+const int  PELLET_THRESHOLD (5);			// deadly threshold! Slither over this number and you die!
+const int  LETTUCE_QUOTA (4);				// how many lettuces you need to eat before you win.
+const int  NUM_FROGS (2);
+const int  FROGLEAP (4);					// How many spaces do frogs jump when they move
+const int  EagleStrike (32);				// There's a 1 in 'nn' chance of an eagle strike on a frog
+
+// the keyboard arrow codes
+const int UP    (72);						// up key
+const int DOWN  (80);						// down key
+const int RIGHT (77);						// right key
+const int LEFT  (75);						// left key
+
+// key codes written for the keys 0 to 5 when recording games (100 is what version 01 recorded for other keys)
+const int keyCodes[6] = {LEFT, RIGHT, UP, DOWN, 100, 113};
+
+// all possible move "vectors" for the snail
+const int moveDirections[4][2] = {{0,-1},{0,1},{-1,0},{1,0}};
+
+// the rules of version 12, other rules are structures with the same members
+struct StandardRules
+{
+	static const int SLIMELIFE = ::SLIMELIFE;
+	static const int NUM_PELLETS = ::NUM_PELLETS;
+	static const int PELLET_THRESHOLD = ::PELLET_THRESHOLD;
+	static const int LETTUCE_QUOTA = ::LETTUCE_QUOTA;
+	static const int NUM_FROGS = ::NUM_FROGS;
+	static const int FROGLEAP = ::FROGLEAP;
+	static const int EagleStrike = ::EagleStrike;
+	static const bool PLACE_FROM_FREE_FIELDS = false;		// draw until a free field comes up, as version 12
+	static const int SIZEY = ::SIZEY;						// the garden with its walls, at most SIZEY by SIZEX
+	static const int SIZEX = ::SIZEX;
+};
+
+// the remainder of dividing a value (not negative) by a rule, a mask if the rule is a power of two
+template <int N>
+inline int ruleModulo(int value)
+{
+	return (N & (N - 1)) == 0 ? (value & (N - 1)) : (value % N);
+}
+
+// the next index into a ring buffer of N elements
+template <int N>
+inline int ruleNext(int index)
+{
+	return (N & (N - 1)) == 0 ? ((index + 1) & (N - 1)) : (index + 1 >= N ? 0 : index + 1);
+}
+
+// what the game code takes from a set of rules besides its values: the largest slime trail, number of pellets and
+// garden that the arrays of a game are made for, and the arithmetic that is cheaper with the rules as constants
+// (RuntimeRules of "ParameterSweep.h", whose values are set at run time, has a RuleTraits of its own)
+template <class Rules>
+struct RuleTraits
+{
+	static const int MAX_SLIMELIFE = Rules::SLIMELIFE;
+	static const int MAX_PELLETS = Rules::NUM_PELLETS;
+	static const int MAX_SIZEY = Rules::SIZEY;
+	static const int MAX_SIZEX = Rules::SIZEX;
+
+	// whether the eagle strikes for a random number
+	static bool eagleStrikes(int random)
+	{
+		return ruleModulo<Rules::EagleStrike>(random) + 1 == Rules::EagleStrike;
+	}
+
+	// the next index into the slime trail
+	static int nextSlime(int index)
+	{
+		return ruleNext<Rules::SLIMELIFE>(index);
+	}
+};
+
+// frogs are moved without a loop up to this number of frogs
+const int MAX_UNROLLED_FROGS(8);
+
+// everything that makes up a game in progress (the locals of main in version 12 and the state of rand)
+template <class Rules>
+struct SNAIL_ALIGN(64) BasicGameState
+{
+	// the game 'world'
+	char garden[SIZEY][SIZEX+2];
+
+	// holds frog positions
+	// [0] - y coordinate of frog 1
+	// [1] - x coordinate of frog 1
+	// [2] - y coordinate of frog 2
+	// [3] - x coordinate of frog 2
+	// ...
+	int frogs[Rules::NUM_FROGS * 2];
+
+	// the position of the snail
+	// [0] - y coordinate
+	// [1] - x coordinate
+	int snail[2];
+
+	int counters[4]; // hold message ID, slime counter, count pellets eaten and lettuces eaten
+
+	// holds the position of each slime ball
+	int slimeTrail[RuleTraits<Rules>::MAX_SLIMELIFE][2];
+
+	unsigned int randomSeed;	// state of the random number generator
+
+	// the last key passed to stepGame
+	// 0 - Left
+	// 1 - Right
+	// 2 - Up
+	// 3 - Down
+	// 4 - Other
+	int key;
+
+	bool isSnailAlive;
+
+	// keeps track of whether frogs are currently sitting on lettuces or not
+	bool lettucesBlocked[Rules::NUM_FROGS];
+};
+
+typedef BasicGameState<StandardRules> GameState;
+
+// what can happen in one iteration of the game loop (the PlayerAction and GameAction enums of version 01)
+enum GameEvent
+{
+	EVENT_HIT_WALL          = 1 << 0,	// the snail is blocked by a wall, cannot move
+	EVENT_HIT_FROG          = 1 << 1,	// the snail moves onto a frog
+	EVENT_HIT_PELLET        = 1 << 2,	// the snail moves onto a pellet
+	EVENT_HIT_SLIME         = 1 << 3,	// the snail is blocked by its own slime
+	EVENT_HIT_OTHER         = 1 << 4,	// the snail moves to an empty field or onto frog bones
+	EVENT_HIT_LETTUCE       = 1 << 5,	// the snail moves onto a lettuce
+	EVENT_HIT_FINAL_PELLET  = 1 << 6,	// the snail moves onto the final pellet -> death
+	EVENT_HIT_FINAL_LETTUCE = 1 << 7,	// the snail moves onto the final lettuce -> win game
+	EVENT_FROG_HITS_SNAIL   = 1 << 8,	// the snail gets eaten by a frog
+	EVENT_FROG_HITS_OTHER   = 1 << 9,	// a frog jumped onto anything but the snail
+	EVENT_EAGLE_EATS_FROG   = 1 << 10,	// the eagle eats a frog
+	EVENT_DISSOLVE_SLIME    = 1 << 11	// the oldest bit of the slime trail dissolves
+};
+
+const int NUM_EVENTS(12);
+const char* const eventNames[NUM_EVENTS] = {"Hit wall", "Hit frog", "Hit pellet", "Hit slime", "Hit other", "Hit lettuce",
+	"Hit final pellet", "Hit final lettuce", "Frog hits snail", "Frog hits other", "Eagle eats frog", "Dissolve slime"};
+
+// the number of the event of a single GameEvent flag (its index in eventNames)
+inline int eventIndex(unsigned int flag)
+{
+	int event(0);
+	while (flag > 1)
+	{
+		flag >>= 1;
+		++event;
+	}
+	return event;
+}
+
+// number of fields inside the garden walls
+const int NUM_FIELDS((SIZEY - 2) * (SIZEX - 2));
+
+// the initial positions of everything in a game
+template <class Rules>
+struct BasicGameLayout
+{
+	int snail[2];
+	int pellets[RuleTraits<Rules>::MAX_PELLETS][2];
+	int lettuces[Rules::LETTUCE_QUOTA][2];
+	int frogs[Rules::NUM_FROGS * 2];
+};
+
+typedef BasicGameLayout<StandardRules> GameLayout;
+
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState has to be copyable with memcpy");
+static_assert(sizeof(GameState) % CACHE_LINE == 0, "GameState has to fill whole cache lines");
+
+/***************************************************************************************
+Random numbers
+****************************************************************************************/
+
+template <class Rules>
+inline void seedGame(BasicGameState<Rules>& state, unsigned int seed)
+{
+	state.randomSeed = seed;
+}
+
+// same sequence as rand() of the Microsoft C runtime, in range [0..32767]
+template <class Rules>
+inline int gameRandom(BasicGameState<Rules>& state)
+{
+	state.randomSeed = state.randomSeed * 214013u + 2531011u;
+	return static_cast<int>((state.randomSeed >> 16) & 0x7FFF);
+}
+
+// a random number in [0..n) for n up to NUM_FIELDS, from two random numbers, so that the remainders left by the
+// multiplication (making some numbers more likely than others) are negligible
+template <class Rules>
+inline int gameRandomBelow(BasicGameState<Rules>& state, int n)
+{
+	const int high = gameRandom(state);
+	const int low = gameRandom(state);
+	return static_cast<int>((static_cast<unsigned long long>(high << 15 | low) * static_cast<unsigned int>(n)) >> 30);
+}
+
+/***************************************************************************************
+Initialisation
+****************************************************************************************/
+
+// number of fields inside the garden walls for a set of rules, and the most there can be
+template <class Rules>
+inline int ruleFields()
+{
+	return (Rules::SIZEY - 2) * (Rules::SIZEX - 2);
+}
+
+template <class Rules>
+struct RuleFields
+{
+	static const int MAX = (RuleTraits<Rules>::MAX_SIZEY - 2) * (RuleTraits<Rules>::MAX_SIZEX - 2);
+};
+
+// all fields in order (fields[field] == field, the fields are numbered row by row), kept by every thread from one layout
+// to the next, so that a layout only puts back the fields it has moved instead of filling in all of them again
+template <class Rules>
+struct FreeFieldList
+{
+	short fields[RuleFields<Rules>::MAX];
+	bool isFilled;
+};
+
+template <class Rules>
+inline short* orderedFields()
+{
+	static SNAIL_THREAD_LOCAL FreeFieldList<Rules> list;		// filled with zeros at first
+	if (!list.isFilled)
+	{
+		for (int field = 0; field < RuleFields<Rules>::MAX; ++field)
+		{
+			list.fields[field] = static_cast<short>(field);
+		}
+		list.isFilled = true;
+	}
+	return list.fields;
+}
+
+// moves 'count' fields, drawn from fields[first..ruleFields<Rules>()), to fields[first..first+count) (a partial
+// Fisher-Yates shuffle), and notes where every field came from in swaps[0..count)
+template <class Rules>
+inline void drawFreeFields(BasicGameState<Rules>& state, short* fields, int first, int count, short* swaps)
+{
+	for (int i = first; i < first + count; ++i)
+	{
+		const int j = i + gameRandomBelow(state, ruleFields<Rules>() - i);
+		const short field = fields[j];
+		fields[j] = fields[i];
+		fields[i] = field;
+		swaps[i - first] = static_cast<short>(j);
+	}
+}
+
+// undoes drawFreeFields on fields that were in order: every field it has moved goes back to its own place (in any
+// order, so that no store has to wait for a load)
+inline void putBackFields(short* fields, int first, int count, const short* swaps)
+{
+	for (int i = first; i < first + count; ++i)
+	{
+		fields[i] = static_cast<short>(i);
+		fields[swaps[i - first]] = swaps[i - first];
+	}
+}
+
+template <class Rules>
+inline void fieldPosition(short field, int position[2])
+{
+	position[0] = field / (Rules::SIZEX - 2) + 1;
+	position[1] = field % (Rules::SIZEX - 2) + 1;
+}
+
+// draws the positions for a new game from the free fields: the snail, pellets and lettuces all on different fields, the
+// frogs on different fields than the snail and each other
+template <class Rules>
+inline void generateLayoutFromFreeFields(BasicGameState<Rules>& state, BasicGameLayout<Rules>& layout)
+{
+	static_assert(1 + RuleTraits<Rules>::MAX_PELLETS + Rules::LETTUCE_QUOTA <= RuleFields<Rules>::MAX,
+		"too many pellets and lettuces for the garden");
+	static_assert(1 + Rules::NUM_FROGS <= RuleFields<Rules>::MAX, "too many frogs for the garden");
+
+	short* fields = orderedFields<Rules>();
+	short itemSwaps[1 + RuleTraits<Rules>::MAX_PELLETS + Rules::LETTUCE_QUOTA];
+	short frogSwaps[Rules::NUM_FROGS];
+
+	drawFreeFields(state, fields, 0, 1 + Rules::NUM_PELLETS + Rules::LETTUCE_QUOTA, itemSwaps);
+	fieldPosition<Rules>(fields[0], layout.snail);
+	for (int slugP = 0; slugP < Rules::NUM_PELLETS; ++slugP)
+	{
+		fieldPosition<Rules>(fields[1 + slugP], layout.pellets[slugP]);
+	}
+	for (int lettuce = 0; lettuce < Rules::LETTUCE_QUOTA; ++lettuce)
+	{
+		fieldPosition<Rules>(fields[1 + Rules::NUM_PELLETS + lettuce], layout.lettuces[lettuce]);
+	}
+
+	// fields[1..ruleFields<Rules>()) are all fields but the snail's, whatever order the pellets and lettuces left them in
+	drawFreeFields(state, fields, 1, Rules::NUM_FROGS, frogSwaps);
+	for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+	{
+		fieldPosition<Rules>(fields[1 + frog], &layout.frogs[frog * 2]);
+	}
+
+	// back in order for the next layout: the fields moved are put back, unless they are so many that filling in all
+	// fields in order is quicker (two stores to scattered fields per item against one store per field)
+	if (4 * (1 + Rules::NUM_PELLETS + Rules::LETTUCE_QUOTA + Rules::NUM_FROGS) < ruleFields<Rules>())
+	{
+		putBackFields(fields, 0, 1 + Rules::NUM_PELLETS + Rules::LETTUCE_QUOTA, itemSwaps);
+		putBackFields(fields, 1, Rules::NUM_FROGS, frogSwaps);
+	}
+	else
+	{
+		for (int field = 0; field < ruleFields<Rules>(); ++field)
+		{
+			fields[field] = static_cast<short>(field);
+		}
+	}
+}
+
+// draws the positions of the snail, pellets, lettuces and frogs for a new game, with the same random numbers as version 12
+// (unless the rules place them from the free fields)
+template <class Rules>
+inline void generateLayout(BasicGameState<Rules>& state, BasicGameLayout<Rules>& layout)
+{
+	if (Rules::PLACE_FROM_FREE_FIELDS)
+	{
+		generateLayoutFromFreeFields(state, layout);
+		return;
+	}
+
+	// what has been placed so far
+	char garden[SIZEY][SIZEX];
+	memset(garden, BLANK, sizeof(garden));
+
+	//-------------------------------------------------------------------------------------
+	// place snail
+
+	int random = gameRandom(state);
+	layout.snail[0] = (random - (Rules::SIZEY-2) * (random/(Rules::SIZEY-2))) + 1;		// vertical coordinate in range [1..(Rules::SIZEY - 2)]
+	random = gameRandom(state);
+	layout.snail[1] = (random - (Rules::SIZEX-2) * (random/(Rules::SIZEX-2))) + 1;		// horizontal coordinate in range [1..(Rules::SIZEX - 2)]
+
+	//--------------------------------------------------------------------------------------
+	// scatter pellets
+	int	y = (0);
+	int x = (0);
+
+	for (int slugP=0; slugP < Rules::NUM_PELLETS; ++slugP)								// scatter some slug pellets...
+	{
+		do
+		{
+			random = gameRandom(state);
+			x = (random - (Rules::SIZEX-2) * (random/(Rules::SIZEX-2))) + 1;
+			random = gameRandom(state);
+			y = (random - (Rules::SIZEY-2) * (random/(Rules::SIZEY-2))) + 1;
+		}while(garden [y][x] == PELLET || ((y == layout.snail[0]) && (x == layout.snail[1]))); // avoid snail and other pellets
+
+		garden [y][x] = PELLET;
+		layout.pellets[slugP][0] = y;
+		layout.pellets[slugP][1] = x;
+	}
+
+	//---------------------------------------------------------------------------------
+	// scatter lettuces
+
+	for (int lettuce=0; lettuce < Rules::LETTUCE_QUOTA; ++lettuce)
+	{
+		do
+		{
+			random = gameRandom(state);
+			y = (random - (Rules::SIZEY-2) * (random/(Rules::SIZEY-2))) + 1;
+			random = gameRandom(state);
+			x = (random - (Rules::SIZEX-2) * (random/(Rules::SIZEX-2))) + 1;
+						// avoid snail, pellets and other lettucii
+		}while(garden [y][x] == PELLET || garden [y][x] == LETTUCE || ((y == layout.snail[0]) && (x == layout.snail[1])));
+
+		garden [y][x] = LETTUCE;
+		layout.lettuces[lettuce][0] = y;
+		layout.lettuces[lettuce][1] = x;
+	}
+
+	//-------------------------------------------------------------------------------
+	//scatter frogs
+
+	int* frogs = layout.frogs;
+
+	for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+	{
+		bool taken;
+		do
+		{
+			random = gameRandom(state);
+			frogs[frog * 2] = (random - (Rules::SIZEY-2) * (random/(Rules::SIZEY-2))) + 1;
+			random = gameRandom(state);
+			frogs[frog * 2 + 1] = (random - (Rules::SIZEX-2) * (random/(Rules::SIZEX-2))) + 1;
+
+			taken = (frogs[frog * 2] == layout.snail[0]) && (frogs[frog * 2 + 1] == layout.snail[1]);	// avoid snail
+			for (int other = 0; other < frog; ++other)											// and existing frogs
+			{
+				taken = taken || ((frogs[frog * 2] == frogs[other * 2]) && (frogs[frog * 2 + 1] == frogs[other * 2 + 1]));
+			}
+		}while(taken);
+	}
+}
+
+// sets up the garden, snail, pellets, lettuces and frogs of a layout, leaves the random number generator as it is (unless
+// the eagle draws random numbers for the frogs)
+template <class Rules, class Eagle>
+inline void setUpGame(BasicGameState<Rules>& state, const BasicGameLayout<Rules>& layout, Eagle& eagle)
+{
+	char (&garden)[SIZEY][SIZEX+2] = state.garden;
+	int* snail = state.snail;
+	int* frogs = state.frogs;
+
+	// clear everything but the random number generator, so that two states of the same game are equal byte for byte
+	// (including the unused fields at the end of each row of the garden)
+	const unsigned int randomSeed = state.randomSeed;
+	memset(&state, 0, sizeof(state));
+	state.randomSeed = randomSeed;
+
+	//------------------------------------------------------------------------------
+	// initialise slime trail
+
+	for(int i = 0; i < Rules::SLIMELIFE; ++i)
+	{
+		state.slimeTrail[i][0] = -1;
+		state.slimeTrail[i][1] = -1;
+	}
+
+	//-----------------------------------------------------------------------------------
+	// set garden (a smaller garden is walled in, with walls all around it)
+
+	static_assert(RuleTraits<Rules>::MAX_SIZEY >= 3 && RuleTraits<Rules>::MAX_SIZEY <= SIZEY &&
+		RuleTraits<Rules>::MAX_SIZEX >= 3 && RuleTraits<Rules>::MAX_SIZEX <= SIZEX,
+		"the garden does not fit into the garden array");
+	memset(&garden[0][0], WALL, SIZEX);
+	for (int row(1); row < Rules::SIZEY - 1; ++row)
+	{
+		if (Rules::SIZEX < SIZEX)
+		{
+			memset(&garden[row][0], WALL, SIZEX);
+		}
+		garden[row][0] = WALL;
+		memset(&garden[row][1], BLANK, Rules::SIZEX-2);
+		garden[row][Rules::SIZEX - 1] = WALL;
+	}
+	for (int row(Rules::SIZEY - 1); row < SIZEY; ++row)
+	{
+		memset(&garden[row][0], WALL, SIZEX);
+	}
+
+	//-------------------------------------------------------------------------------------
+	// place snail, pellets and lettuces
+
+	snail[0] = layout.snail[0];
+	snail[1] = layout.snail[1];
+	garden[snail[0]][snail[1]] = SNAIL;
+
+	for (int slugP=0; slugP < Rules::NUM_PELLETS; ++slugP)
+	{
+		garden [layout.pellets[slugP][0]][layout.pellets[slugP][1]] = PELLET;
+	}
+
+	for (int lettuce=0; lettuce < Rules::LETTUCE_QUOTA; ++lettuce)
+	{
+		garden [layout.lettuces[lettuce][0]][layout.lettuces[lettuce][1]] = LETTUCE;
+	}
+
+	//-------------------------------------------------------------------------------
+	// place frogs
+
+	for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+	{
+		frogs[frog * 2] = layout.frogs[frog * 2];
+		frogs[frog * 2 + 1] = layout.frogs[frog * 2 + 1];
+
+		state.lettucesBlocked[frog] = garden[frogs[frog * 2]][frogs[frog * 2 + 1]] == LETTUCE; // frog is currently blocking a lettuce
+		garden [frogs[frog * 2]][frogs[frog * 2 + 1]] = FROG;		// put frog on garden (this may overwrite a slug pellet)
+		eagle.onSpawn(state, frog);
+	}
+
+	//------------------------------------------------------------------------------
+	// further initialising
+
+	state.counters[0] = 0;
+	state.counters[1] = 0;
+	state.counters[2] = 0;
+	state.counters[3] = 0;
+
+	state.key = 4;
+	state.isSnailAlive = true;
+}
+
+template <class Rules, class Eagle>
+inline void initialiseGame(BasicGameState<Rules>& state, Eagle& eagle)
+{
+	BasicGameLayout<Rules> layout;
+	generateLayout(state, layout);
+	setUpGame(state, layout, eagle);
+}
+
+/***************************************************************************************
+Eagle
+****************************************************************************************/
+
+// the eagle of version 12: one random number per frog and iteration, with a 1 in EagleStrike chance of a strike
+struct RandomEagle
+{
+	template <class Rules>
+	void onSpawn(BasicGameState<Rules>&, int)
+	{
+	}
+
+	template <class Rules>
+	bool strikes(BasicGameState<Rules>& state, int)
+	{
+		return RuleTraits<Rules>::eagleStrikes(gameRandom(state));
+	}
+};
+
+// strikes as often as RandomEagle, but draws the number of moves until the eagle gets a frog when the frog is placed
+// (from the geometric distribution of the first strike of RandomEagle), so that every move only counts down; it is no
+// faster than RandomEagle, slower if the frogs make only a few moves (see version 21), and its games differ from
+// those of version 12
+template <class Rules>
+struct GeometricEagle
+{
+	int movesLeft[Rules::NUM_FROGS];	// the eagle gets the frog when this reaches 0
+
+	void onSpawn(BasicGameState<Rules>& state, int frog)
+	{
+		// a uniform number in (0..1] from two random numbers, 30 bits are enough for the chance of a frog living on
+		// longer than that to be negligible
+		const int high = gameRandom(state);
+		const int low = gameRandom(state);
+		const double uniform = ((high << 15 | low) + 1.0) / (1 << 30);
+
+		// the frog gets through k moves with a chance of (1 - 1/EagleStrike)^k, the same as uniform <= that
+		movesLeft[frog] = 1 + static_cast<int>(std::log(uniform) / std::log(1.0 - 1.0 / Rules::EagleStrike));
+	}
+
+	bool strikes(BasicGameState<Rules>&, int frog)
+	{
+		return --movesLeft[frog] == 0;
+	}
+};
+
+template <class Rules>
+inline void setUpGame(BasicGameState<Rules>& state, const BasicGameLayout<Rules>& layout)
+{
+	RandomEagle eagle;
+	setUpGame(state, layout, eagle);
+}
+
+template <class Rules>
+inline void initialiseGame(BasicGameState<Rules>& state)
+{
+	RandomEagle eagle;
+	initialiseGame(state, eagle);
+}
+
+/***************************************************************************************
+Game loop
+****************************************************************************************/
+
+template <class Rules, class Eagle>
+inline unsigned int moveFrog(BasicGameState<Rules>& state, int frog, Eagle& eagle)
+{
+	char (&garden)[SIZEY][SIZEX+2] = state.garden;
+	const int* snail = state.snail;
+	int* frogPosition = &state.frogs[frog * 2];
+
+	// if frog was blocking a lettuce, restore the lettuce (lettuce is 0x40, blank is 0x20)
+	garden [frogPosition[0]][frogPosition[1]] = BLANK << static_cast<int>(state.lettucesBlocked[frog]);
+
+	// work out where to jump to depending on where the snail is...
+	// see which way to jump in the Y direction (up and down)
+	if (snail[0] > frogPosition[0])
+	{
+		frogPosition[0] += Rules::FROGLEAP;  if (frogPosition[0] >= Rules::SIZEY-1) frogPosition[0] = Rules::SIZEY-2;	// don't go over the garden walls!
+	}else if (snail[0] < frogPosition[0])
+	{
+		frogPosition[0] -= Rules::FROGLEAP;  if (frogPosition[0] < 1) frogPosition[0] = 1;
+	}
+
+	// see which way to jump in the X direction (left and right)
+	if (snail[1] > frogPosition[1])
+	{
+		frogPosition[1] += Rules::FROGLEAP;  if (frogPosition[1] >= Rules::SIZEX-1) frogPosition[1] = Rules::SIZEX-2;
+	}else if (snail[1] < frogPosition[1])
+	{
+		frogPosition[1] -= Rules::FROGLEAP;  if (frogPosition[1] < 1) frogPosition[1] = 1;
+	}
+
+	state.lettucesBlocked[frog] = (garden [frogPosition[0]][frogPosition[1]] == LETTUCE);
+
+	if (!eagle.strikes(state, frog))  // not gotten by eagle?
+	{
+		if (frogPosition[0] != snail[0] || frogPosition[1] != snail[1])	// landed on snail? - grub up!
+		{
+			garden [frogPosition[0]][frogPosition[1]] = FROG;				// display frog on garden (thus destroying any pellet that might be there).
+			return EVENT_FROG_HITS_OTHER;
+		}
+		else
+		{
+			state.counters[0] = 8;
+			state.isSnailAlive = false;
+			return EVENT_FROG_HITS_SNAIL;
+		}
+	}
+	else
+	{
+		// show remnants of frog in garden, if the frog was sitting on a lettuce as he was killed, restore the lettuce
+		garden [frogPosition[0]][frogPosition[1]] = state.lettucesBlocked[frog] ? LETTUCE : DEAD_FROG_BONES;
+
+		frogPosition[0] = -1;									// and mark frog as deceased
+		state.counters[0] = 9;
+		return EVENT_EAGLE_EATS_FROG;
+	}
+}
+
+// moves the frogs one after the other, without a loop (for up to MAX_UNROLLED_FROGS frogs)
+template <class Rules, int Frog, bool Done = (Frog >= Rules::NUM_FROGS || Rules::NUM_FROGS > MAX_UNROLLED_FROGS)>
+struct FrogLoop
+{
+	template <class Eagle>
+	static unsigned int move(BasicGameState<Rules>& state, Eagle& eagle)
+	{
+		unsigned int events(0);
+		if ((state.frogs[Frog * 2] >= 0) && state.isSnailAlive)  // if frog not been gotten by an eagle or GameOver
+		{
+			events = moveFrog(state, Frog, eagle);
+		}
+		return events | FrogLoop<Rules, Frog + 1>::move(state, eagle);
+	}
+};
+
+template <class Rules, int Frog>
+struct FrogLoop<Rules, Frog, true>
+{
+	template <class Eagle>
+	static unsigned int move(BasicGameState<Rules>&, Eagle&)
+	{
+		return 0;
+	}
+};
+
+// one iteration of the game loop for a key from 0 to 4
+// 0 - Left
+// 1 - Right
+// 2 - Up
+// 3 - Down
+// 4 - Other
+template <class Rules, class Eagle>
+inline unsigned int stepGame(BasicGameState<Rules>& state, int key, Eagle& eagle)
+{
+	char (&garden)[SIZEY][SIZEX+2] = state.garden;
+	int* snail = state.snail;
+	int* counters = state.counters;
+	unsigned int events(0);
+
+	state.key = key;
+	counters[0] = 12; // reset message
+
+	if(key != 4)	// only move the snail if an arrow key was pressed
+	{
+		/*********************************************************************************
+		Move the snail
+		**********************************************************************************/
+
+		switch( garden[snail[0] + moveDirections[key][0]][snail[1] + moveDirections[key][1]]) //depending on what is at target position
+		{
+			case BLANK:
+			case DEAD_FROG_BONES:		//its safe to move over dead/missing frogs too
+				garden[snail[0]][snail[1]] = SLIME;				//lay a trail of slime
+				state.slimeTrail[counters[1]][0] = snail[0];
+				state.slimeTrail[counters[1]][1] = snail[1];
+				snail[0] += moveDirections[key][0];				//go in direction indicated by keyMove
+				snail[1] += moveDirections[key][1];
+				garden[snail[0]][snail[1]] = SNAIL;				// place snail (move snail in garden)
+				events = EVENT_HIT_OTHER;
+				break;
+			case PELLET:		// increment pellet count and kill snail if > threshold
+				garden[snail[0]][snail[1]] = SLIME;
+				state.slimeTrail[counters[1]][0] = snail[0];
+				state.slimeTrail[counters[1]][1] = snail[1];
+				snail[0] += moveDirections[key][0];
+				snail[1] += moveDirections[key][1];
+				garden[snail[0]][snail[1]] = SNAIL;
+				if (++counters[2] >= Rules::PELLET_THRESHOLD)			// aaaargh! poisoned!
+				{
+					counters[0] = 1;
+					state.isSnailAlive = false;
+					events = EVENT_HIT_FINAL_PELLET;
+				}
+				else
+				{
+					events = EVENT_HIT_PELLET;
+				}
+				break;
+			case LETTUCE:		// increment lettuce count and win if snail is full
+				garden[snail[0]][snail[1]] = SLIME;
+				state.slimeTrail[counters[1]][0] = snail[0];
+				state.slimeTrail[counters[1]][1] = snail[1];
+				snail[0] += moveDirections[key][0];
+				snail[1] += moveDirections[key][1];
+				garden[snail[0]][snail[1]] = SNAIL;
+				counters[0] = (++counters[3] != Rules::LETTUCE_QUOTA) ? 3 : 2;
+				events = (counters[3] != Rules::LETTUCE_QUOTA) ? EVENT_HIT_LETTUCE : EVENT_HIT_FINAL_LETTUCE;
+				break;
+			case SLIME:
+				counters[0] = 4;
+				events = EVENT_HIT_SLIME;
+				break;
+			case WALL:				//oops, garden wall
+				counters[0] = 5;
+				events = EVENT_HIT_WALL;
+				break;				//& stay put
+			case FROG:			//	kill snail if it throws itself at a frog!
+				garden[snail[0]][snail[1]] = SLIME;				// lay a final trail of slime
+				snail[0] += moveDirections[key][0];
+				snail[1] += moveDirections[key][1];
+				garden[snail[0]][snail[1]] = SNAIL;
+				counters[0] = 6;
+				state.isSnailAlive = false;
+				events = EVENT_HIT_FROG;
+				break;
+		}
+	}else
+	{
+		counters[0] = 7;
+	}
+
+	/*********************************************************************************
+	Dissolve the slime
+	**********************************************************************************/
+
+	counters[1] = RuleTraits<Rules>::nextSlime(counters[1]);
+
+	if(state.slimeTrail[counters[1]][0] >= 0)
+	{
+		garden[state.slimeTrail[counters[1]][0]][state.slimeTrail[counters[1]][1]] = BLANK;
+		state.slimeTrail[counters[1]][0] = -1;
+		events |= EVENT_DISSOLVE_SLIME;
+	}
+
+	/*********************************************************************************
+	Move the frogs
+	**********************************************************************************/
+
+	events |= FrogLoop<Rules, 0>::move(state, eagle);
+	if (Rules::NUM_FROGS > MAX_UNROLLED_FROGS)
+	{
+		for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+		{
+			if ((state.frogs[frog * 2] >= 0) && state.isSnailAlive)  // if frog not been gotten by an eagle or GameOver
+			{
+				events |= moveFrog(state, frog, eagle);
+			}
+		}
+	}
+
+	return events;
+}
+
+template <class Rules>
+inline unsigned int stepGame(BasicGameState<Rules>& state, int key)
+{
+	RandomEagle eagle;
+	return stepGame(state, key, eagle);
+}
+
+template <class Rules>
+inline bool isGameOver(const BasicGameState<Rules>& state)
+{
+	return !state.isSnailAlive || state.counters[3] == Rules::LETTUCE_QUOTA;
+}
+
+// a frog that is eaten is marked as deceased and stays so until the next game (more than one may go in a frame)
+template <class Rules>
+inline int frogsEaten(const BasicGameState<Rules>& state)
+{
+	int eaten(0);
+	for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+	{
+		eaten += state.frogs[frog * 2] < 0;
+	}
+	return eaten;
+}
+
+/***************************************************************************************
+Keys
+****************************************************************************************/
+
+// the same translation getKeyPress does in version 12
+inline int translateKey(int command)
+{
+	switch(command)
+	{
+	case DOWN:
+		return 3;
+	case UP:
+		return 2;
+	case LEFT:
+		return 0;
+	case RIGHT:
+		return 1;
+	case 113:  //Quit
+		return 5;
+	default:
+		return 4;
+	}
+}
+
+#endif
@@ -0,0 +1,161 @@
+/* Storage for snapshots of games (see "SnailEngine.h"), used to go back to an earlier point of a game for search,
+rollback and checkpoints.
+
+Use the following procedures/functions for the following results:
+
+SnapshotArena arena(capacity) to allocate room for 'capacity' snapshots in one block of cache line aligned memory
+arena.save(state) to copy a game into the next free slot, returns the number of the slot
+arena.restore(slot, state) to copy a saved game back
+arena.rewind(slot) to drop the snapshot in that slot and all later ones, so that their slots can be used again
+encodeDelta(initial, state, buffer) to store a game as the differences to its initial layout, returns the size
+decodeDelta(initial, buffer, state) to get the game back from such a delta
+
+Saving and restoring are a single memcpy of a GameState each. A delta holds everything but the garden as it is, and
+only those fields of the garden that differ from the initial layout (usually the slime trail, the snail, the frogs and
+the eaten lettuces), so it takes up about a third of a full snapshot at the cost of comparing the gardens.
+*/
+
+#ifndef SNAPSHOT_ARENA_H
+#define SNAPSHOT_ARENA_H
+
+#include <cassert>           //for assert
+#include <cstddef>           //for offsetof
+#include <cstdlib>
+#include <cstring>           //for memcpy
+#ifdef _WIN32
+#include <malloc.h>          //for _aligned_malloc
+#endif
+
+#include "SnailEngine.h"     //for GameState
+
+class SnapshotArena
+{
+private:
+	GameState* snapshots;
+	unsigned int capacity;
+	unsigned int count;
+
+	// not to be copied, the memory belongs to a single arena
+	SnapshotArena(const SnapshotArena&);
+	SnapshotArena& operator=(const SnapshotArena&);
+
+public:
+	explicit SnapshotArena(unsigned int capacity) : snapshots(0), capacity(capacity), count(0)
+	{
+#ifdef _WIN32
+		snapshots = static_cast<GameState*>(_aligned_malloc(capacity * sizeof(GameState), CACHE_LINE));
+#else
+		void* memory(0);
+		if (posix_memalign(&memory, CACHE_LINE, capacity * sizeof(GameState)) == 0)
+		{
+			snapshots = static_cast<GameState*>(memory);
+		}
+#endif
+		assert(snapshots != 0);
+	}
+
+	~SnapshotArena()
+	{
+#ifdef _WIN32
+		_aligned_free(snapshots);
+#else
+		free(snapshots);
+#endif
+	}
+
+	unsigned int save(const GameState& state)
+	{
+		assert(count < capacity);
+		memcpy(&snapshots[count], &state, sizeof(GameState));
+		return count++;
+	}
+
+	void restore(unsigned int slot, GameState& state) const
+	{
+		assert(slot < count);
+		memcpy(&state, &snapshots[slot], sizeof(GameState));
+	}
+
+	void rewind(unsigned int slot)
+	{
+		assert(slot <= count);
+		count = slot;
+	}
+
+	const GameState& operator[](unsigned int slot) const
+	{
+		return snapshots[slot];
+	}
+
+	unsigned int size() const
+	{
+		return count;
+	}
+};
+
+/***************************************************************************************
+Deltas against the initial layout
+****************************************************************************************/
+
+// everything after the garden is stored as it is
+const unsigned int DELTA_STATE_OFFSET(offsetof(GameState, frogs));
+const unsigned int DELTA_STATE_SIZE(sizeof(GameState) - offsetof(GameState, frogs));
+
+// the largest possible delta: the rest of the state, the number of changed fields and an offset and value per field
+const unsigned int MAX_DELTA_SIZE(DELTA_STATE_SIZE + 2 + sizeof(GameState::garden) * 3);
+
+inline unsigned int encodeDelta(const GameState& initial, const GameState& state, unsigned char* delta)
+{
+	memcpy(delta, reinterpret_cast<const char*>(&state) + DELTA_STATE_OFFSET, DELTA_STATE_SIZE);
+
+	unsigned char* changes = delta + DELTA_STATE_SIZE + 2;
+	unsigned int numberOfChanges(0);
+
+	const char* before = &initial.garden[0][0];
+	const char* after = &state.garden[0][0];
+
+	// compare eight fields at once, most of the garden does not change
+	for (unsigned int block = 0; block < sizeof(GameState::garden); block += 8)
+	{
+		unsigned long long a;
+		unsigned long long b;
+		memcpy(&a, before + block, 8);
+		memcpy(&b, after + block, 8);
+		if (a == b)
+		{
+			continue;
+		}
+		for (unsigned int field = block; field < block + 8; ++field)
+		{
+			if (before[field] != after[field])
+			{
+				*changes++ = static_cast<unsigned char>(field);
+				*changes++ = static_cast<unsigned char>(field >> 8);
+				*changes++ = static_cast<unsigned char>(after[field]);
+				++numberOfChanges;
+			}
+		}
+	}
+
+	delta[DELTA_STATE_SIZE] = static_cast<unsigned char>(numberOfChanges);
+	delta[DELTA_STATE_SIZE + 1] = static_cast<unsigned char>(numberOfChanges >> 8);
+
+	return static_cast<unsigned int>(changes - delta);
+}
+
+inline void decodeDelta(const GameState& initial, const unsigned char* delta, GameState& state)
+{
+	memcpy(&state.garden[0][0], &initial.garden[0][0], sizeof(GameState::garden));
+	memcpy(reinterpret_cast<char*>(&state) + DELTA_STATE_OFFSET, delta, DELTA_STATE_SIZE);
+
+	const unsigned int numberOfChanges = delta[DELTA_STATE_SIZE] | (delta[DELTA_STATE_SIZE + 1] << 8);
+	const unsigned char* changes = delta + DELTA_STATE_SIZE + 2;
+	char* garden = &state.garden[0][0];
+
+	for (unsigned int i = 0; i < numberOfChanges; ++i, changes += 3)
+	{
+		garden[changes[0] | (changes[1] << 8)] = static_cast<char>(changes[2]);
+	}
+}
+
+#endif
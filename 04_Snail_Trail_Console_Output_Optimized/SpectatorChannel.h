@@ -0,0 +1,319 @@
+/* Publishing the frames of a game (see "SnailEngine.h") in shared memory, so that other processes on the same machine
+can watch it without the game waiting for them.
+
+Use the following procedures/functions for the following results:
+
+SpectatorPublisher publisher(name) to create the shared memory segment 'name' for a game, publisher.isOpen() to check
+	that it could be created (it cannot if another publisher of the same name is running)
+publisher.publish(state) to make the garden and the game info of a game the frame seen by all viewers
+publisher.close() to tell the viewers that the game is over (done by the destructor as well)
+SpectatorViewer viewer(name) to open the segment of a game, viewer.isOpen() to check that there is one
+viewer.read(frame) to copy the frame published last into a SpectatorFrame, returns its number (0 if nothing has been
+	published yet, -1 if no copy could be taken for SPECTATOR_STALE_MS milliseconds because the publisher stopped in
+	the middle of a frame), viewer.isClosed() to check whether the game is over, viewer.retries() for the number of
+	copies that had to be taken again because a frame was published while they were taken
+
+The frame is guarded by a sequence lock: the publisher makes the sequence number odd, writes the frame and makes it
+even again, and a viewer takes a copy between two reads of the sequence number, and takes it again if the number was
+odd or has changed (for at most SPECTATOR_STALE_MS milliseconds, so that a viewer does not wait for ever for a
+publisher that died while it wrote a frame). Viewers only ever read the segment, so the publisher never waits for
+them and publishing costs the same however many viewers there are; a viewer that is too slow only misses frames. The
+frame is kept as atomic words written and read with relaxed order (a plain copy on x86), so that a copy taken while
+the frame is written is only thrown away, not undefined.
+On POSIX systems the segment is made with shm_open (the name has to start with '/'), on Windows with a named file
+mapping. Only one publisher may have a segment of a name: a second one fails instead of taking it over. A segment
+outlives a POSIX publisher that was killed, so the segment holds the process id of its publisher, and a segment whose
+publisher is no longer running is removed and made again (a file mapping on Windows goes with the processes).
+*/
+
+#ifndef SPECTATOR_CHANNEL_H
+#define SPECTATOR_CHANNEL_H
+
+#include <atomic>            //for atomic, atomic_thread_fence
+#include <chrono>            //for steady_clock
+#include <cstring>           //for memcpy
+#include <new>               //for placement new
+#include <thread>            //for this_thread::yield
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>            //for errno
+#include <fcntl.h>           //for O_CREAT, O_EXCL, O_RDWR
+#include <signal.h>          //for kill
+#include <sys/mman.h>        //for shm_open, mmap
+#include <sys/stat.h>        //for fstat
+#include <unistd.h>          //for ftruncate, close, getpid
+#endif
+
+#include "SnailEngine.h"     //for BasicGameState, SIZEY, SIZEX, CACHE_LINE
+
+// what a viewer sees of a game
+struct SpectatorFrame
+{
+	char garden[SIZEY][SIZEX];
+	int counters[4];			// message, slime counter, pellets and lettuces eaten (as in the game)
+	int frame;					// iterations of the game loop since the publisher was started
+};
+
+const int SPECTATOR_WORDS((sizeof(SpectatorFrame) + 3) / 4);
+
+// how long a viewer keeps taking copies that are written to before it gives up on the publisher, and how many copies
+// it takes between looking at the time
+const int SPECTATOR_STALE_MS(100);
+const int SPECTATOR_CLOCK_RETRIES(64);
+
+struct SpectatorSegment
+{
+	SNAIL_ALIGN(64) std::atomic<unsigned int> sequence;		// odd while a frame is written
+	std::atomic<unsigned int> closed;						// 1 when the game is over
+	std::atomic<long> owner;								// process id of the publisher
+	SNAIL_ALIGN(64) std::atomic<unsigned int> words[SPECTATOR_WORDS];
+
+	explicit SpectatorSegment(long owner) : sequence(0), closed(0), owner(owner)
+	{
+		for (int i = 0; i < SPECTATOR_WORDS; ++i)
+		{
+			words[i].store(0, std::memory_order_relaxed);
+		}
+	}
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "the segment needs atomic words that work across processes");
+
+inline long spectatorProcessId()
+{
+#ifdef _WIN32
+	return static_cast<long>(GetCurrentProcessId());
+#else
+	return static_cast<long>(getpid());
+#endif
+}
+
+#ifndef _WIN32
+// whether the segment of a name was left by a publisher that is no longer running (one that is still being made, or
+// has not got the size of a segment, is not)
+inline bool isStaleSpectatorSegment(const char* name)
+{
+	const int file = shm_open(name, O_RDONLY, 0);
+	if (file < 0)
+	{
+		return false;
+	}
+	struct stat status;
+	void* memory = fstat(file, &status) == 0 && status.st_size == static_cast<off_t>(sizeof(SpectatorSegment)) ?
+		mmap(0, sizeof(SpectatorSegment), PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+	close(file);
+	if (memory == MAP_FAILED)
+	{
+		return false;
+	}
+	const long owner = static_cast<const SpectatorSegment*>(memory)->owner.load(std::memory_order_relaxed);
+	munmap(memory, sizeof(SpectatorSegment));
+	return owner > 0 && kill(static_cast<pid_t>(owner), 0) != 0 && errno == ESRCH;
+}
+#endif
+
+// maps the segment of a name, writable for the publisher (who creates it, and fails if there is one already) and read
+// only for the viewers
+inline SpectatorSegment* mapSpectatorSegment(const char* name, bool create)
+{
+#ifdef _WIN32
+	HANDLE mapping = create ?
+		CreateFileMappingA(INVALID_HANDLE_VALUE, 0, PAGE_READWRITE, 0, sizeof(SpectatorSegment), name) :
+		OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+	if (mapping != 0 && create && GetLastError() == ERROR_ALREADY_EXISTS)
+	{
+		CloseHandle(mapping);		// another publisher has it
+		return 0;
+	}
+	if (mapping == 0)
+	{
+		return 0;
+	}
+	void* memory = MapViewOfFile(mapping, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, sizeof(SpectatorSegment));
+	CloseHandle(mapping);		// the view keeps the mapping alive
+	return static_cast<SpectatorSegment*>(memory);
+#else
+	int file = create ? shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644) : shm_open(name, O_RDONLY, 0);
+	if (file < 0 && create && errno == EEXIST && isStaleSpectatorSegment(name))
+	{
+		shm_unlink(name);
+		file = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+	}
+	if (file < 0)
+	{
+		return 0;
+	}
+	if (create && ftruncate(file, sizeof(SpectatorSegment)) != 0)
+	{
+		close(file);
+		return 0;
+	}
+	void* memory = mmap(0, sizeof(SpectatorSegment), create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+	close(file);		// the mapping keeps the segment alive
+	return memory != MAP_FAILED ? static_cast<SpectatorSegment*>(memory) : 0;
+#endif
+}
+
+inline void unmapSpectatorSegment(SpectatorSegment* segment)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(segment);
+#else
+	munmap(segment, sizeof(SpectatorSegment));
+#endif
+}
+
+/***************************************************************************************
+Publisher
+****************************************************************************************/
+
+class SpectatorPublisher
+{
+private:
+	SpectatorSegment* segment;
+	const char* name;
+	int frames;
+
+	// not to be copied, the segment belongs to a single publisher
+	SpectatorPublisher(const SpectatorPublisher&);
+	SpectatorPublisher& operator=(const SpectatorPublisher&);
+
+public:
+	explicit SpectatorPublisher(const char* name) : segment(0), name(name), frames(0)
+	{
+		void* memory = mapSpectatorSegment(name, true);
+		if (memory != 0)
+		{
+			segment = new (memory) SpectatorSegment(spectatorProcessId());
+		}
+	}
+
+	~SpectatorPublisher()
+	{
+		if (segment != 0)
+		{
+			close();
+			unmapSpectatorSegment(segment);
+#ifndef _WIN32
+			shm_unlink(name);		// only the publisher that made the segment gets here, viewers keep their mapping
+#endif
+		}
+	}
+
+	bool isOpen() const
+	{
+		return segment != 0;
+	}
+
+	template <class Rules>
+	void publish(const BasicGameState<Rules>& state)
+	{
+		SpectatorFrame frame;
+		for (int y = 0; y < SIZEY; ++y)
+		{
+			memcpy(frame.garden[y], state.garden[y], SIZEX);
+		}
+		memcpy(frame.counters, state.counters, sizeof(frame.counters));
+		frame.frame = ++frames;
+		unsigned int words[SPECTATOR_WORDS] = {0};
+		memcpy(words, &frame, sizeof(frame));
+
+		const unsigned int sequence = segment->sequence.load(std::memory_order_relaxed);
+		segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);		// the odd number is seen before any new word
+		for (int i = 0; i < SPECTATOR_WORDS; ++i)
+		{
+			segment->words[i].store(words[i], std::memory_order_relaxed);
+		}
+		segment->sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	void close()
+	{
+		segment->closed.store(1, std::memory_order_release);
+	}
+};
+
+/***************************************************************************************
+Viewer
+****************************************************************************************/
+
+class SpectatorViewer
+{
+private:
+	const SpectatorSegment* segment;
+	long long retried;
+
+	// not to be copied, the mapping belongs to a single viewer
+	SpectatorViewer(const SpectatorViewer&);
+	SpectatorViewer& operator=(const SpectatorViewer&);
+
+public:
+	explicit SpectatorViewer(const char* name) : segment(mapSpectatorSegment(name, false)), retried(0)
+	{
+	}
+
+	~SpectatorViewer()
+	{
+		if (segment != 0)
+		{
+			unmapSpectatorSegment(const_cast<SpectatorSegment*>(segment));
+		}
+	}
+
+	bool isOpen() const
+	{
+		return segment != 0;
+	}
+
+	bool isClosed() const
+	{
+		return segment->closed.load(std::memory_order_acquire) != 0;
+	}
+
+	long long retries() const
+	{
+		return retried;
+	}
+
+	int read(SpectatorFrame& frame)
+	{
+		unsigned int words[SPECTATOR_WORDS];
+		std::chrono::steady_clock::time_point firstRetry;
+		for (int tries = 0; ; ++tries)
+		{
+			const unsigned int before = segment->sequence.load(std::memory_order_acquire);
+			if ((before & 1) == 0)
+			{
+				for (int i = 0; i < SPECTATOR_WORDS; ++i)
+				{
+					words[i] = segment->words[i].load(std::memory_order_relaxed);
+				}
+				std::atomic_thread_fence(std::memory_order_acquire);		// the words are read before the number
+				if (segment->sequence.load(std::memory_order_relaxed) == before)
+				{
+					if (before == 0)
+					{
+						return 0;
+					}
+					memcpy(&frame, words, sizeof(frame));
+					return frame.frame;
+				}
+			}
+			++retried;
+			if (tries == 0)
+			{
+				firstRetry = std::chrono::steady_clock::now();
+			}
+			else if (tries % SPECTATOR_CLOCK_RETRIES == 0 &&
+				std::chrono::steady_clock::now() - firstRetry > std::chrono::milliseconds(SPECTATOR_STALE_MS))
+			{
+				return -1;
+			}
+			std::this_thread::yield();		// let the publisher finish the frame
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,181 @@
+/* Reading the keys of the game from a terminal without waiting for them, on POSIX systems as well as on Windows.
+
+Use the following procedures/functions for the following results:
+
+TerminalInput input to switch the terminal to raw mode (until input goes out of scope)
+TerminalInput input(fd) to do the same for another terminal than the standard input, e.g. a pseudo terminal (not on
+	Windows)
+input.readKeys(keys, maxKeys) to read all keys pressed since the last call into keys, as keys from 0 to 5 (see
+	translateKey in "SnailEngine.h"), returns how many there were (0 if none, without waiting)
+input.isTerminal() to check whether the input is a terminal at all
+
+Version 12 reads the keys with _getch from conio.h, which only exists on Windows: an arrow key comes as 224 followed by
+the code of the key. A POSIX terminal sends an arrow key as an escape sequence instead (ESC [ A for up, or ESC O A in
+application mode, with numbers for modifiers in between, e.g. ESC [ 1 ; 5 A), and only hands out keys once return is
+pressed, unless it is put into raw mode. Here the terminal is put into raw mode with termios, set to return straight
+away from read even if there is nothing to read, and restored when the TerminalInput goes out of scope. readKeys reads
+all bytes waiting in a single call of read and decodes them with a small state machine, which keeps its state between
+calls, so an escape sequence split over two reads still makes one key. Escape followed by anything but [ or O (which
+is also how Alt and a key are sent) is taken as an 'other' key. Ctrl+C no longer stops the program in raw mode, so it
+quits like 'q'. On Windows the keys are read with _kbhit and _getch as in version 12.
+*/
+
+#ifndef TERMINAL_INPUT_H
+#define TERMINAL_INPUT_H
+
+#ifdef _WIN32
+#include <conio.h>           //for _kbhit, _getch
+#include <io.h>              //for _isatty
+#include <cstdio>            //for _fileno
+#else
+#include <termios.h>         //for tcgetattr, tcsetattr
+#include <unistd.h>          //for read, isatty
+#endif
+
+#include "SnailEngine.h"     //for translateKey
+
+class TerminalInput
+{
+private:
+	bool terminal;
+#ifndef _WIN32
+	int input;				// the file descriptor read from
+	termios original;		// the settings to restore
+
+	// where the decoder is in an escape sequence
+	enum DecodeState
+	{
+		DECODE_KEY,			// waiting for a key
+		DECODE_ESCAPE,		// ESC read
+		DECODE_SEQUENCE		// ESC [ or ESC O read, waiting for the final byte
+	};
+	DecodeState state;
+
+	// decodes one byte, returns the key it completes, or -1 if it does not complete one
+	int decode(unsigned char byte)
+	{
+		switch (state)
+		{
+		case DECODE_ESCAPE:
+			if (byte == '[' || byte == 'O')
+			{
+				state = DECODE_SEQUENCE;
+				return -1;
+			}
+			if (byte != 27)
+			{
+				state = DECODE_KEY;		// escape and a key (or Alt and a key)
+			}
+			return 4;
+		case DECODE_SEQUENCE:
+			if ((byte >= '0' && byte <= '9') || byte == ';')
+			{
+				return -1;		// parameters, e.g. modifiers
+			}
+			state = DECODE_KEY;
+			switch (byte)
+			{
+			case 'A':
+				return 2;
+			case 'B':
+				return 3;
+			case 'C':
+				return 1;
+			case 'D':
+				return 0;
+			default:
+				return 4;
+			}
+		default:
+			switch (byte)
+			{
+			case 27:
+				state = DECODE_ESCAPE;
+				return -1;
+			case 'q':
+			case 3:		// Ctrl+C
+				return 5;
+			default:
+				return 4;
+			}
+		}
+	}
+#endif
+
+	// not to be copied, the settings of the terminal are restored once
+	TerminalInput(const TerminalInput&);
+	TerminalInput& operator=(const TerminalInput&);
+
+public:
+#ifdef _WIN32
+	TerminalInput()
+	{
+		terminal = _isatty(_fileno(stdin)) != 0;
+	}
+#else
+	explicit TerminalInput(int input = STDIN_FILENO) : input(input)
+	{
+		state = DECODE_KEY;
+		terminal = isatty(input) != 0 && tcgetattr(input, &original) == 0;
+		if (terminal)
+		{
+			termios raw = original;
+			raw.c_iflag &= ~(IXON | ICRNL | BRKINT | INPCK | ISTRIP);
+			raw.c_lflag &= ~(ICANON | ECHO | ISIG | IEXTEN);
+			raw.c_cc[VMIN] = 0;		// return from read straight away
+			raw.c_cc[VTIME] = 0;
+			tcsetattr(input, TCSAFLUSH, &raw);
+		}
+	}
+#endif
+
+	~TerminalInput()
+	{
+#ifndef _WIN32
+		if (terminal)
+		{
+			tcsetattr(input, TCSAFLUSH, &original);
+		}
+#endif
+	}
+
+	bool isTerminal() const
+	{
+		return terminal;
+	}
+
+	int readKeys(int keys[], int maxKeys)
+	{
+		int count(0);
+#ifdef _WIN32
+		while (count < maxKeys && _kbhit())
+		{
+			int command = _getch();		// to read arrow keys
+			while (command == 224)		// to clear extra info from buffer
+			{
+				command = _getch();
+			}
+			keys[count++] = translateKey(command);
+		}
+#else
+		if (!terminal)
+		{
+			return 0;
+		}
+		// no byte completes more than one key, so reading no more bytes than keys fit never loses one
+		unsigned char bytes[256];
+		const ssize_t length = read(input, bytes, maxKeys < 256 ? maxKeys : 256);
+		for (ssize_t i = 0; i < length; ++i)
+		{
+			const int key = decode(bytes[i]);
+			if (key >= 0)
+			{
+				keys[count++] = key;
+			}
+		}
+#endif
+		return count;
+	}
+};
+
+#endif
@@ -0,0 +1,329 @@
+/* Painting the game (see "SnailEngine.h") on a terminal that understands ANSI escape sequences, three ways, each
+turning a frame into the bytes to write to the terminal in one go.
+
+Use the following procedures/functions for the following results:
+
+renderFull(state, buffer) to paint the whole garden and the game info, as version 12 does every frame
+stepQueued(state, key, queue) to run one iteration of the game loop (as stepGame) and note the fields it changes in a
+	ChangeQueue, as version 04 does with its changeQueue
+ChangeQueueRenderer renderer to paint only the fields changed in a frame, as version 04 does with its changeQueue
+	renderer.step(state, key) to run one iteration of the game loop (as stepGame) and note the fields it changes
+	renderer.render(state, buffer) to paint the fields changed by the last step, and the game info if it changed
+	renderer.renderNewGame(state, buffer) to paint a new game in full
+DiffRenderer renderer to paint only the fields that differ from what it painted before
+	renderer.render(state, buffer) to paint what changed since the last render (everything the first time)
+	renderer.reset() to forget what was painted, e.g. when the screen was cleared
+All of them return the number of bytes written into buffer, which needs room for MAX_FRAME_BYTES.
+
+The garden is painted at the top left of the screen, with the number of pellets and lettuces eaten and the message of
+the frame on the two lines below it. The cursor is moved with ESC [ row ; column H, so the terminal does not have to
+turn line feeds into new lines. Writing a character moves the cursor on by one, so DiffRenderer only moves the cursor
+to a changed field if it does not follow straight after the field written before. ChangeQueueRenderer notes the fields
+the way version 04 pushes them into its changeQueue: the snail, the slime about to dissolve and the frogs before an
+iteration, the frogs after they leapt (with an eagle that passes on RandomEagle's strikes, so the game stays the same)
+and the snail after it.
+*/
+
+#ifndef TERMINAL_RENDER_H
+#define TERMINAL_RENDER_H
+
+#include <cstring>           //for memcpy, memcmp, strlen
+
+#include "SnailEngine.h"     //for BasicGameState, stepGame, RandomEagle, etc.
+
+// the most bytes a frame can take (a cursor move for every field of the garden, and the game info)
+const int MAX_FRAME_BYTES(SIZEY * SIZEX * 10 + 256);
+
+// the most bytes the game info can take
+const int MAX_INFO_BYTES(128);
+
+// rows of the game info, below the garden
+const int INFO_ROW(SIZEY + 1);
+const int MESSAGE_ROW(SIZEY + 2);
+const int MESSAGE_WIDTH(40);
+
+// all possible messages (counters[0])
+const char* const gameMessages[13] = {"READY TO SLITHER!? PRESS A KEY...",
+								"TOO MANY PELLETS SLITHERED OVER!",
+								"LAST LETTUCE EATEN",
+								"LETTUCE EATEN",
+								"TRY A DIFFERENT DIRECTION",
+								"THAT'S A WALL!",
+								"OOPS! ENCOUNTERED A FROG!",
+								"INVALID KEY",
+								"FROG GOT YOU!",
+								"EAGLE GOT A FROG",
+								"WELL DONE, YOU'VE SURVIVED",
+								"REST IN PEAS.",
+								""};
+
+/***************************************************************************************
+Writing into the buffer
+****************************************************************************************/
+
+inline int appendNumber(char* buffer, int number)
+{
+	char digits[12];
+	int count(0);
+	do
+	{
+		digits[count++] = static_cast<char>('0' + number % 10);
+		number /= 10;
+	} while (number > 0);
+	for (int i = 0; i < count; ++i)
+	{
+		buffer[i] = digits[count - 1 - i];
+	}
+	return count;
+}
+
+inline int appendText(char* buffer, const char* text)
+{
+	const int length = static_cast<int>(strlen(text));
+	memcpy(buffer, text, length);
+	return length;
+}
+
+// moves the cursor to a row and column counted from 0
+inline int appendCursor(char* buffer, int row, int column)
+{
+	int length(0);
+	buffer[length++] = '\033';
+	buffer[length++] = '[';
+	length += appendNumber(buffer + length, row + 1);
+	buffer[length++] = ';';
+	length += appendNumber(buffer + length, column + 1);
+	buffer[length++] = 'H';
+	return length;
+}
+
+// the number of pellets and lettuces eaten and the message, padded so that they cover what was painted before
+template <class Rules>
+inline int renderInfo(const BasicGameState<Rules>& state, char* buffer)
+{
+	int length = appendCursor(buffer, INFO_ROW, 0);
+	length += appendText(buffer + length, "PELLETS EATEN: ");
+	length += appendNumber(buffer + length, state.counters[2]);
+	length += appendText(buffer + length, "  LETTUCES EATEN: ");
+	length += appendNumber(buffer + length, state.counters[3]);
+	length += appendText(buffer + length, "   ");
+	length += appendCursor(buffer + length, MESSAGE_ROW, 0);
+	const int messageLength = appendText(buffer + length, gameMessages[state.counters[0]]);
+	memset(buffer + length + messageLength, ' ', MESSAGE_WIDTH - messageLength);
+	return length + MESSAGE_WIDTH;
+}
+
+/***************************************************************************************
+Full repaint
+****************************************************************************************/
+
+template <class Rules>
+inline int renderFull(const BasicGameState<Rules>& state, char* buffer)
+{
+	int length(0);
+	for (int y = 0; y < SIZEY; ++y)
+	{
+		length += appendCursor(buffer + length, y, 0);
+		memcpy(buffer + length, state.garden[y], SIZEX);
+		length += SIZEX;
+	}
+	return length + renderInfo(state, buffer + length);
+}
+
+/***************************************************************************************
+Change queue
+****************************************************************************************/
+
+// the fields changed in an iteration of the game loop
+template <class Rules>
+struct ChangeQueue
+{
+	int fields[3 + 2 * Rules::NUM_FROGS][2];
+	int count;
+
+	void push(int y, int x)
+	{
+		fields[count][0] = y;
+		fields[count][1] = x;
+		++count;
+	}
+};
+
+// passes on the strikes of RandomEagle, noting where every frog landed
+template <class Rules>
+struct ChangeQueueEagle
+{
+	ChangeQueue<Rules>& queue;
+	RandomEagle eagle;
+
+	explicit ChangeQueueEagle(ChangeQueue<Rules>& queue) : queue(queue)
+	{
+	}
+
+	void onSpawn(BasicGameState<Rules>& state, int frog)
+	{
+		eagle.onSpawn(state, frog);
+	}
+
+	bool strikes(BasicGameState<Rules>& state, int frog)
+	{
+		queue.push(state.frogs[frog * 2], state.frogs[frog * 2 + 1]);
+		return eagle.strikes(state, frog);
+	}
+
+private:
+	ChangeQueueEagle& operator=(const ChangeQueueEagle&);
+};
+
+// runs one iteration of the game loop (as stepGame) and notes the fields it changes in queue, as version 04 does
+template <class Rules>
+inline unsigned int stepQueued(BasicGameState<Rules>& state, int key, ChangeQueue<Rules>& queue)
+{
+	// the fields left by the snail, the slime and the frogs
+	queue.count = 0;
+	queue.push(state.snail[0], state.snail[1]);
+	const int* dissolving = state.slimeTrail[RuleTraits<Rules>::nextSlime(state.counters[1])];
+	if (dissolving[0] >= 0)
+	{
+		queue.push(dissolving[0], dissolving[1]);
+	}
+	for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+	{
+		if (state.frogs[frog * 2] >= 0)
+		{
+			queue.push(state.frogs[frog * 2], state.frogs[frog * 2 + 1]);
+		}
+	}
+
+	// the fields the frogs leap to, and the snail
+	ChangeQueueEagle<Rules> eagle(queue);
+	const unsigned int events = stepGame(state, key, eagle);
+	queue.push(state.snail[0], state.snail[1]);
+	return events;
+}
+
+template <class Rules>
+class ChangeQueueRenderer
+{
+private:
+	ChangeQueue<Rules> queue;
+	int shownInfo[3];		// message, pellets and lettuces painted last
+
+	void noteInfo(const BasicGameState<Rules>& state)
+	{
+		shownInfo[0] = state.counters[0];
+		shownInfo[1] = state.counters[2];
+		shownInfo[2] = state.counters[3];
+	}
+
+public:
+	ChangeQueueRenderer()
+	{
+		queue.count = 0;
+		shownInfo[0] = -1;
+	}
+
+	unsigned int step(BasicGameState<Rules>& state, int key)
+	{
+		return stepQueued(state, key, queue);
+	}
+
+	int render(const BasicGameState<Rules>& state, char* buffer)
+	{
+		int length(0);
+		for (int i = 0; i < queue.count; ++i)
+		{
+			length += appendCursor(buffer + length, queue.fields[i][0], queue.fields[i][1]);
+			buffer[length++] = state.garden[queue.fields[i][0]][queue.fields[i][1]];
+		}
+		queue.count = 0;
+
+		if (state.counters[0] != shownInfo[0] || state.counters[2] != shownInfo[1] || state.counters[3] != shownInfo[2])
+		{
+			length += renderInfo(state, buffer + length);
+			noteInfo(state);
+		}
+		return length;
+	}
+
+	int renderNewGame(const BasicGameState<Rules>& state, char* buffer)
+	{
+		queue.count = 0;
+		noteInfo(state);
+		return renderFull(state, buffer);
+	}
+};
+
+/***************************************************************************************
+Diff
+****************************************************************************************/
+
+class DiffRenderer
+{
+private:
+	char shown[SIZEY][SIZEX];				// the garden painted last
+	char shownInfo[MAX_INFO_BYTES];			// the game info painted last
+	int shownInfoLength;
+	bool painted;							// whether anything has been painted since the last reset
+
+public:
+	DiffRenderer() : shownInfoLength(0), painted(false)
+	{
+	}
+
+	void reset()
+	{
+		painted = false;
+	}
+
+	template <class Rules>
+	int render(const BasicGameState<Rules>& state, char* buffer)
+	{
+		if (!painted)
+		{
+			for (int y = 0; y < SIZEY; ++y)
+			{
+				memcpy(shown[y], state.garden[y], SIZEX);
+			}
+			shownInfoLength = renderInfo(state, shownInfo);
+			painted = true;
+			return renderFull(state, buffer);
+		}
+
+		int length(0);
+		for (int y = 0; y < SIZEY; ++y)
+		{
+			if (memcmp(shown[y], state.garden[y], SIZEX) == 0)
+			{
+				continue;		// most rows do not change
+			}
+			int cursor(-1);		// column the cursor is in, if it is in this row
+			for (int x = 0; x < SIZEX; ++x)
+			{
+				if (shown[y][x] != state.garden[y][x])
+				{
+					if (cursor != x)
+					{
+						length += appendCursor(buffer + length, y, x);
+					}
+					buffer[length++] = state.garden[y][x];
+					shown[y][x] = state.garden[y][x];
+					cursor = x + 1;
+				}
+			}
+		}
+
+		char info[MAX_INFO_BYTES];
+		const int infoLength = renderInfo(state, info);
+		if (infoLength != shownInfoLength || memcmp(info, shownInfo, infoLength) != 0)
+		{
+			memcpy(buffer + length, info, infoLength);
+			length += infoLength;
+			memcpy(shownInfo, info, infoLength);
+			shownInfoLength = infoLength;
+		}
+		return length;
+	}
+};
+
+#endif
@@ -0,0 +1,134 @@
+/* A clock that ticks at a fixed rate, for running the game in real time instead of waiting for a key every frame.
+
+Use the following procedures/functions for the following results:
+
+TickClock clock(ticksPerSecond) to start the clock, the first tick is due one period from now
+clock.waitForTick() to sleep until the next tick is due, returns how late it woke up (in nanoseconds)
+clock.overruns() for the number of ticks that were already due when waitForTick was called (the work of the tick
+	before took longer than a period)
+clock.skipped() for the number of ticks left out after an overrun of more than a whole period
+tickClockNow() for the time of the clock in nanoseconds (only differences of it mean anything)
+
+Every tick is due a whole number of periods after the start, so the time spent between two calls of waitForTick does
+not add up over the ticks, as it would with a sleep of one period. After an overrun the next tick starts straight away,
+and if more than a whole period has passed, the ticks missed are skipped rather than run back to back.
+On POSIX systems the clock sleeps with clock_nanosleep on the monotonic clock until the deadline (an absolute time).
+Windows has no such call, a waitable timer is set to the time left until the deadline instead (a high resolution one
+where there is one, otherwise it is only as exact as the timer interrupt).
+*/
+
+#ifndef TICK_CLOCK_H
+#define TICK_CLOCK_H
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <cerrno>            //for EINTR
+#include <time.h>            //for clock_gettime, clock_nanosleep
+#endif
+
+const long long NANOSECONDS_PER_SECOND(1000000000LL);
+
+inline long long tickClockNow()
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return static_cast<long long>(counter.QuadPart / frequency.QuadPart) * NANOSECONDS_PER_SECOND +
+		(counter.QuadPart % frequency.QuadPart) * NANOSECONDS_PER_SECOND / frequency.QuadPart;
+#else
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<long long>(now.tv_sec) * NANOSECONDS_PER_SECOND + now.tv_nsec;
+#endif
+}
+
+class TickClock
+{
+private:
+	long long period;		// nanoseconds between two ticks
+	long long deadline;		// when the next tick is due
+	long long overrunCount;
+	long long skippedCount;
+#ifdef _WIN32
+	HANDLE timer;
+#endif
+
+	// not to be copied, the timer belongs to a single clock
+	TickClock(const TickClock&);
+	TickClock& operator=(const TickClock&);
+
+	void sleepUntil(long long time)
+	{
+#ifdef _WIN32
+		const long long left = time - tickClockNow();
+		if (left > 0)
+		{
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -(left / 100);		// relative, in 100 nanosecond intervals
+			SetWaitableTimer(timer, &dueTime, 0, 0, 0, FALSE);
+			WaitForSingleObject(timer, INFINITE);
+		}
+#else
+		timespec due;
+		due.tv_sec = static_cast<time_t>(time / NANOSECONDS_PER_SECOND);
+		due.tv_nsec = static_cast<long>(time % NANOSECONDS_PER_SECOND);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, 0) == EINTR)
+		{
+		}
+#endif
+	}
+
+public:
+	explicit TickClock(int ticksPerSecond) : period(NANOSECONDS_PER_SECOND / ticksPerSecond), deadline(tickClockNow()),
+		overrunCount(0), skippedCount(0)
+	{
+#ifdef _WIN32
+		timer = CreateWaitableTimerExW(0, 0, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (timer == 0)
+		{
+			timer = CreateWaitableTimerExW(0, 0, 0, TIMER_ALL_ACCESS);
+		}
+#endif
+	}
+
+	~TickClock()
+	{
+#ifdef _WIN32
+		CloseHandle(timer);
+#endif
+	}
+
+	long long waitForTick()
+	{
+		deadline += period;
+		const long long now = tickClockNow();
+		if (now >= deadline)
+		{
+			++overrunCount;
+			const long long missed = (now - deadline) / period;
+			skippedCount += missed;
+			deadline += missed * period;
+			return now - deadline;
+		}
+		sleepUntil(deadline);
+		return tickClockNow() - deadline;
+	}
+
+	long long overruns() const
+	{
+		return overrunCount;
+	}
+
+	long long skipped() const
+	{
+		return skippedCount;
+	}
+};
+
+#endif
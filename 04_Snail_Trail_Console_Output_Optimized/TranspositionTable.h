@@ -0,0 +1,139 @@
+/* A table of the games a search has already reached (see "SnailEngine.h"), shared by all threads of the search
+without any locks.
+
+Use the following procedures/functions for the following results:
+
+TranspositionTable table(bits) to allocate room for 2 to the power of 'bits' games
+table.insert(hash, moves) to enter a game reached after 'moves' moves (less than 65536), returns TABLE_NEW if it was
+	entered, TABLE_REACHED if it has already been reached with as few moves (so it does not have to be searched again)
+	or TABLE_FULL if there is no room left for it
+table.capacity() to get the number of entries the table has room for
+hashGame(state) to get a 64 bit hash of everything in a game that has an effect on how it goes on
+
+Every entry is a single 64 bit word: the upper 48 bits of the hash and the number of moves in the lower 16 bits. An
+empty entry is 0. Threads claim empty entries and lower the number of moves with compare-and-swap, so two threads can
+never both think they were first. The entries are found by linear probing, which gets slow as the table fills up, so
+a search should stop well before that; an insert that has probed every entry gives up with TABLE_FULL.
+*/
+
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>            //for atomic
+#include <cassert>           //for assert
+#include <cstring>           //for memcpy
+
+#include "SnailEngine.h"     //for GameState
+
+enum TableInsert
+{
+	TABLE_NEW,
+	TABLE_REACHED,
+	TABLE_FULL
+};
+
+class TranspositionTable
+{
+private:
+	std::atomic<unsigned long long>* entries;
+	unsigned long long mask;
+
+	// not to be copied, the entries belong to a single table
+	TranspositionTable(const TranspositionTable&);
+	TranspositionTable& operator=(const TranspositionTable&);
+
+public:
+	explicit TranspositionTable(unsigned int bits) : entries(new std::atomic<unsigned long long>[1ull << bits]), mask((1ull << bits) - 1)
+	{
+		for (unsigned long long i = 0; i <= mask; ++i)
+		{
+			entries[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	~TranspositionTable()
+	{
+		delete[] entries;
+	}
+
+	TableInsert insert(unsigned long long hash, unsigned int moves)
+	{
+		assert(moves <= 0xFFFF);
+		unsigned long long tag = hash & ~0xFFFFull;
+		if (tag == 0)
+		{
+			tag = 0x10000;		// 0 marks an empty entry
+		}
+		const unsigned long long entry = tag | (moves & 0xFFFF);
+
+		unsigned long long i = hash & mask;
+		for (unsigned long long probes = 0; probes <= mask;)
+		{
+			unsigned long long current = entries[i].load(std::memory_order_relaxed);
+			if (current == 0 || (current & ~0xFFFFull) == tag)
+			{
+				if (current != 0 && (current & 0xFFFF) <= moves)
+				{
+					return TABLE_REACHED;	// already reached, with as few moves
+				}
+				if (entries[i].compare_exchange_weak(current, entry, std::memory_order_relaxed))
+				{
+					return TABLE_NEW;
+				}
+				continue;			// another thread got there first, look again
+			}
+			i = (i + 1) & mask;
+			++probes;
+		}
+		return TABLE_FULL;
+	}
+
+	unsigned long long capacity() const
+	{
+		return mask + 1;
+	}
+};
+
+// mixes a 64 bit word into a hash
+inline unsigned long long mixHash(unsigned long long hash, unsigned long long word)
+{
+	hash ^= word;
+	hash *= 0xFF51AFD7ED558CCDull;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+// the message and the last key are left out, they do not change how the game goes on
+inline unsigned long long hashGame(const GameState& state)
+{
+	unsigned long long hash(0x9E3779B97F4A7C15ull);
+
+	const char* garden = &state.garden[0][0];
+	for (unsigned int block = 0; block < sizeof(GameState::garden); block += 8)
+	{
+		unsigned long long word;
+		memcpy(&word, garden + block, 8);
+		hash = mixHash(hash, word);
+	}
+
+	for (int i = 0; i < 4; i += 2)
+	{
+		hash = mixHash(hash, static_cast<unsigned int>(state.frogs[i]) | static_cast<unsigned long long>(state.frogs[i + 1]) << 32);
+	}
+	hash = mixHash(hash, static_cast<unsigned int>(state.snail[0]) | static_cast<unsigned long long>(state.snail[1]) << 32);
+	hash = mixHash(hash, static_cast<unsigned int>(state.counters[1]) | static_cast<unsigned long long>(state.counters[2]) << 32);
+	hash = mixHash(hash, static_cast<unsigned int>(state.counters[3]) | static_cast<unsigned long long>(state.randomSeed) << 32);
+	for (int i = 0; i < SLIMELIFE; ++i)
+	{
+		hash = mixHash(hash, static_cast<unsigned int>(state.slimeTrail[i][0]) | static_cast<unsigned long long>(state.slimeTrail[i][1]) << 32);
+	}
+	hash = mixHash(hash, state.isSnailAlive | state.lettucesBlocked[0] << 1 | state.lettucesBlocked[1] << 2);
+
+	// final mix, so that the lower bits (used to find the entry) depend on all of the game
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ull;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+#endif
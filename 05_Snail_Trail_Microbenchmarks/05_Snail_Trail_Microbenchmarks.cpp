@@ -0,0 +1,279 @@
+/*
+05_Snail_Trail_Microbenchmarks
+Based on 12_Snail_Trail_Final_Version of the snail trail game by A. Oram
+The versions in 04_Snail_Trail_Console_Output_Optimized time whole frames, so a change to one part of the game loop
+only shows up as a small change of the frame time, next to everything else the frame does. This project times the
+functions of the game code on their own: drawing the positions for a new game (generateLayout, and
+generateLayoutFromFreeFields whatever the rules say), setting up a game from them (setUpGame), an iteration of the game
+loop (stepGame), letting the frogs leap towards the snail (moveFrog) and painting a frame in full (renderFull) and as
+a diff (DiffRenderer).
+The functions are those of "SnailEngine.h" and "TerminalRender.h" in 04_Snail_Trail_Console_Output_Optimized (the
+include directories of the project point there), so what is timed is the code the versions there run. They are
+timed for the rules of version 12 and for rule presets of "RulePresets.h" with more pellets and frogs, as the garden
+cannot be larger than that of version 12. Every function is timed with runBenchmark (see "MicroBench.h"), which finds
+out by itself how many runs it takes to measure it, and the results are kept from being optimised away.
+The iterations of the game loop are those of NUM_FRAMES frames played by the bot of "RulePresets.h", so that every
+run works on another frame and the branches cannot be learnt from a single one: stepGame replays the frames on a game
+of its own, copying in the state of a game only where a new game starts, and the frames it plays are checked against
+the frames recorded before they are timed. moveFrog lets the frogs of a new game leap towards the snail on one of
+NUM_INPUTS fields drawn beforehand, with an eagle that never strikes, so that no frog is lost.
+*/
+
+//---------------------------------
+//include libraries
+//include standard libraries
+#include <cstdio>
+#include <cstring>           //for memcmp
+#include <vector>
+
+using namespace std;
+
+//include our own libraries
+#include "MicroBench.h"      //for runBenchmark, doNotOptimize, clobberMemory
+#include "SnailEngine.h"     //for BasicGameState, generateLayout, setUpGame, stepGame, moveFrog, etc.
+#include "RulePresets.h"     //for HardRules, SwarmRules, CrowdedRules, chooseBotKey
+#include "TerminalRender.h"  //for renderFull, DiffRenderer, MAX_FRAME_BYTES
+
+// the seed of the games played (as the recorded games of version 12)
+const unsigned int SEED(256);
+
+// number of frames played by the bot and of fields the snail is put on for the frogs (powers of two)
+const int NUM_FRAMES(1024);
+const int NUM_INPUTS(4096);
+
+// number of layouts set up one after the other (a power of two)
+const int NUM_LAYOUTS(64);
+
+// an eagle that never gets a frog
+struct NoEagle
+{
+	template <class Rules>
+	void onSpawn(BasicGameState<Rules>&, int)
+	{
+	}
+
+	template <class Rules>
+	bool strikes(BasicGameState<Rules>&, int)
+	{
+		return false;
+	}
+};
+
+// frames played by the bot: the state before every frame, the key pressed in it and whether a new game starts with it
+template <class Rules>
+struct BotFrames
+{
+	vector<BasicGameState<Rules> > states;
+	vector<int> keys;
+	vector<bool> newGame;
+};
+
+void showResult(const char* function, const char* rules, const BenchResult& result, int items)
+{
+	printf("%-30s %-9s %12.2f %8d %10.3f %12lld\n", function, rules, result.nanoseconds, items,
+		result.nanoseconds / items, result.iterations);
+}
+
+/***************************************************************************************
+Frames
+****************************************************************************************/
+
+template <class Rules>
+void playBotFrames(BotFrames<Rules>& frames)
+{
+	BasicGameState<Rules> game;
+	seedGame(game, SEED);
+	BotRandom random;
+	random.state = SEED | 1;
+
+	frames.states.resize(NUM_FRAMES);
+	frames.keys.resize(NUM_FRAMES);
+	frames.newGame.resize(NUM_FRAMES);
+	for (int frame = 0; frame < NUM_FRAMES; ++frame)
+	{
+		frames.newGame[frame] = frame == 0 || isGameOver(game);
+		if (frames.newGame[frame])
+		{
+			initialiseGame(game);
+		}
+		frames.states[frame] = game;
+		frames.keys[frame] = chooseBotKey(game, random);
+		stepGame(game, frames.keys[frame]);
+	}
+}
+
+// one run of the stepGame benchmark: the next frame, played on game
+template <class Rules>
+inline unsigned int replayFrame(const BotFrames<Rules>& frames, int frame, BasicGameState<Rules>& game)
+{
+	if (frames.newGame[frame])
+	{
+		game = frames.states[frame];
+	}
+	return stepGame(game, frames.keys[frame]);
+}
+
+// whether replaying the frames gives the state recorded before every frame that is not the start of a game
+template <class Rules>
+bool checkReplay(const BotFrames<Rules>& frames)
+{
+	BasicGameState<Rules> game;
+	for (int frame = 0; frame < NUM_FRAMES; ++frame)
+	{
+		if (!frames.newGame[frame] && memcmp(&game, &frames.states[frame], sizeof(game)) != 0)
+		{
+			return false;
+		}
+		replayFrame(frames, frame, game);
+	}
+	return true;
+}
+
+/***************************************************************************************
+Benchmarks
+****************************************************************************************/
+
+// times the game code for a set of rules, returns the number of errors
+template <class Rules>
+int benchmarkRules(const char* name)
+{
+	const int things = 1 + Rules::NUM_PELLETS + Rules::LETTUCE_QUOTA + Rules::NUM_FROGS;
+
+	BotFrames<Rules> frames;
+	playBotFrames(frames);
+	if (!checkReplay(frames))
+	{
+		printf("replaying the frames of the %s rules does not give the frames played\n", name);
+		return 1;
+	}
+
+	/**********************************************************************************************
+	Placing everything for a new game
+	***********************************************************************************************/
+
+	{
+		BasicGameState<Rules> game;
+		seedGame(game, SEED);
+		BasicGameLayout<Rules> layout;
+		showResult("generateLayout", name, runBenchmark([&]()
+		{
+			generateLayout(game, layout);
+			clobberMemory();
+		}), things);
+
+		showResult("generateLayoutFromFreeFields", name, runBenchmark([&]()
+		{
+			generateLayoutFromFreeFields(game, layout);
+			clobberMemory();
+		}), things);
+
+		vector<BasicGameLayout<Rules> > layouts(NUM_LAYOUTS);
+		for (int i = 0; i < NUM_LAYOUTS; ++i)
+		{
+			generateLayout(game, layouts[i]);
+		}
+		int next(0);
+		showResult("setUpGame", name, runBenchmark([&]()
+		{
+			setUpGame(game, layouts[next++ & (NUM_LAYOUTS - 1)]);
+			clobberMemory();
+		}), things);
+	}
+
+	/**********************************************************************************************
+	Playing
+	***********************************************************************************************/
+
+	{
+		BasicGameState<Rules> game;
+		int next(0);
+		showResult("stepGame", name, runBenchmark([&]()
+		{
+			doNotOptimize(replayFrame(frames, next++ & (NUM_FRAMES - 1), game));
+		}), 1);
+	}
+
+	{
+		// the snail on fields inside the walls
+		BotRandom random;
+		random.state = SEED | 1;
+		vector<int> inputs(NUM_INPUTS * 2);
+		for (int i = 0; i < NUM_INPUTS; ++i)
+		{
+			inputs[i * 2] = random.next() % (Rules::SIZEY - 2) + 1;
+			inputs[i * 2 + 1] = random.next() % (Rules::SIZEX - 2) + 1;
+		}
+
+		BasicGameState<Rules> game = frames.states[0];
+		NoEagle eagle;
+		int next(0);
+		showResult("moveFrog", name, runBenchmark([&]()
+		{
+			const int* snail = &inputs[(next++ & (NUM_INPUTS - 1)) * 2];
+			game.snail[0] = snail[0];
+			game.snail[1] = snail[1];
+			unsigned int events(0);
+			for (int frog = 0; frog < Rules::NUM_FROGS; ++frog)
+			{
+				events |= moveFrog(game, frog, eagle);
+			}
+			doNotOptimize(events);
+		}), Rules::NUM_FROGS);
+	}
+
+	/**********************************************************************************************
+	Painting the garden
+	***********************************************************************************************/
+
+	{
+		vector<char> buffer(MAX_FRAME_BYTES);
+		int next(0);
+		showResult("renderFull", name, runBenchmark([&]()
+		{
+			doNotOptimize(renderFull(frames.states[next++ & (NUM_FRAMES - 1)], &buffer[0]));
+			clobberMemory();
+		}), 1);
+
+		DiffRenderer renderer;
+		showResult("DiffRenderer::render", name, runBenchmark([&]()
+		{
+			doNotOptimize(renderer.render(frames.states[next++ & (NUM_FRAMES - 1)], &buffer[0]));
+			clobberMemory();
+		}), 1);
+	}
+	printf("\n");
+	return 0;
+}
+
+// the rules the game code is timed for, by the names of "RulePresets.h"
+struct BenchRules
+{
+	const char* name;
+	int (*benchmark)(const char* name);
+};
+
+const BenchRules benchRules[] = {
+	{"standard", &benchmarkRules<StandardRules>},
+	{"hard", &benchmarkRules<HardRules>},
+	{"swarm", &benchmarkRules<SwarmRules>},
+	{"crowded", &benchmarkRules<CrowdedRules>}
+};
+
+const int NUM_BENCH_RULES(sizeof(benchRules) / sizeof(benchRules[0]));
+
+// Start of the 'SNAIL TRAIL' listing
+//---------------------------------
+int main()
+{
+	int errors(0);
+	printf("%-30s %-9s %12s %8s %10s %12s\n", "function", "rules", "ns/run", "items", "ns/item", "runs");
+	for (int i = 0; i < NUM_BENCH_RULES; ++i)
+	{
+		errors += benchRules[i].benchmark(benchRules[i].name);
+	}
+
+	printf("%d errors\n", errors);
+	return errors == 0 ? 0 : 1;
+} //end main
+
+// End of the 'SNAIL TRAIL' listing
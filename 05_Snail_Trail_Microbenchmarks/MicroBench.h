@@ -0,0 +1,106 @@
+/* A small harness to time a single piece of code (a kernel) on its own, without any library but "hr_time.h".
+
+Use the following procedures/functions for the following results:
+
+doNotOptimize(value) to make the compiler believe value is used, so that the code computing it is not removed
+clobberMemory() to make the compiler believe all memory is read and written here, so that stores are not removed
+BenchResult result = runBenchmark(kernel) to time kernel(), a callable running the code once, and get the time per run
+	in result.nanoseconds (the best of BENCH_REPEATS measurements) and the runs per measurement in result.iterations
+
+A single run of a kernel usually takes less time than the resolution of the timer, so it is run many times in a row
+for each measurement. How many is found out first: starting with one run, the number of runs is doubled until they
+take at least BENCH_MIN_SECONDS, so every kernel is measured for about as long whatever it does. The best of the
+measurements is taken, as everything that disturbs a measurement (interrupts, other processes) only makes it longer.
+*/
+
+#ifndef MICRO_BENCH_H
+#define MICRO_BENCH_H
+
+#ifdef _MSC_VER
+#include <intrin.h>          //for _ReadWriteBarrier
+#endif
+#include "hr_time.h"         //for timers
+
+// least time of a measurement, number of measurements of a kernel
+const double BENCH_MIN_SECONDS(0.02);
+const int BENCH_REPEATS(5);
+
+// most runs per measurement
+const long long BENCH_MAX_ITERATIONS(1LL << 40);
+
+#ifdef _MSC_VER
+
+// the compiler cannot tell what is read from a volatile, so it has to keep every value copied into it
+static volatile char benchSink;
+
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+	benchSink = *reinterpret_cast<const volatile char*>(&value);
+	_ReadWriteBarrier();
+}
+
+inline void clobberMemory()
+{
+	_ReadWriteBarrier();
+}
+
+#else
+
+// an empty assembly statement that takes the value (in a register or in memory) and may read and write any memory
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory()
+{
+	asm volatile("" : : : "memory");
+}
+
+#endif
+
+struct BenchResult
+{
+	double nanoseconds;			// per run of the kernel
+	long long iterations;		// runs per measurement
+};
+
+template <class Kernel>
+inline double timeIterations(Kernel& kernel, long long iterations)
+{
+	CStopWatch s;
+	s.startTimer();
+	for (long long i = 0; i < iterations; ++i)
+	{
+		kernel();
+	}
+	s.stopTimer();
+	return s.getElapsedTime();
+}
+
+template <class Kernel>
+inline BenchResult runBenchmark(Kernel kernel)
+{
+	// find out how many runs take long enough
+	long long iterations(1);
+	while (timeIterations(kernel, iterations) < BENCH_MIN_SECONDS && iterations < BENCH_MAX_ITERATIONS)
+	{
+		iterations *= 2;
+	}
+
+	double best(1e30);
+	for (int repeat = 0; repeat < BENCH_REPEATS; ++repeat)
+	{
+		const double seconds = timeIterations(kernel, iterations);
+		best = seconds < best ? seconds : best;
+	}
+
+	BenchResult result;
+	result.nanoseconds = best * 1e9 / iterations;
+	result.iterations = iterations;
+	return result;
+}
+
+#endif
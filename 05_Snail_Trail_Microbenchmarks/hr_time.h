@@ -0,0 +1,31 @@
+#ifdef _WIN32
+#include <windows.h>
+
+typedef struct {
+    LARGE_INTEGER start;
+    LARGE_INTEGER stop;
+} stopWatch;
+#else
+#include <time.h>
+
+// no performance counter outside of windows, the monotonic clock is used instead
+typedef struct {
+    timespec start;
+    timespec stop;
+} stopWatch;
+#endif
+
+class CStopWatch {
+
+private:
+	stopWatch timer;
+#ifdef _WIN32
+	LARGE_INTEGER frequency;
+	double LIToSecs( LARGE_INTEGER & L);
+#endif
+public:
+	CStopWatch();
+	void startTimer( );
+	void stopTimer( );
+	double getElapsedTime();
+};